@@ -0,0 +1,130 @@
+#ifndef RX_BENCH_BENCH_H
+#define RX_BENCH_BENCH_H
+#include <stdio.h> // printf
+#include <stdlib.h> // atoi
+#include <unistd.h> // sysconf
+
+#include "rx/core/global.h"
+
+#include "rx/core/time/stop_watch.h"
+
+// # Benchmarks
+//
+// Every file in bench/ is a standalone micro-benchmark of some part of the
+// core library, built by `make bench` into .build/bench/. They link against
+// the core objects only, so they build without SDL and don't need a window.
+//
+// A benchmark prints one line per measurement with the time per operation of
+// the fastest of |k_runs| runs, the slower runs are disturbed by something
+// else. Results are only comparable on the same machine and build.
+//
+// Helpers for benchmarks running on several threads are in bench_threads.h,
+// which is separate since the thread header pulls in rx/core/hash.h and that
+// can't be included together with the headers in rx/core/hash/.
+namespace Rx::Bench {
+
+inline constexpr const Size k_runs = 5;
+
+// Initializes the globals the core library needs in the order main does, and
+// finalizes them again.
+struct Environment {
+  Environment(int _argc, char** _argv);
+  ~Environment();
+
+  // Number of threads given on the command line, or the number of processors.
+  Size threads() const;
+
+private:
+  Size m_threads;
+};
+
+// Keeps the compiler from optimizing away the computation of |_value|.
+template<typename T>
+inline void keep(const T& _value) {
+  asm volatile("" : : "r,m"(_value) : "memory");
+}
+
+// Calls |_function| |k_runs| times and returns the seconds of the fastest run.
+template<typename F>
+Float64 fastest(F&& _function);
+
+// Prints the fastest run of |_function| as nanoseconds for each of
+// |_operations|. Returns those nanoseconds.
+template<typename F>
+Float64 measure(const char* _name, Size _operations, F&& _function);
+
+// Like |measure| for operations on |_bytes| each, also prints the throughput.
+template<typename F>
+Float64 measure_bytes(const char* _name, Size _operations, Size _bytes, F&& _function);
+
+inline Environment::Environment(int _argc, char** _argv)
+  : m_threads{static_cast<Size>(sysconf(_SC_NPROCESSORS_ONLN))}
+{
+  if (_argc > 1 && atoi(_argv[1]) > 0) {
+    m_threads = static_cast<Size>(atoi(_argv[1]));
+  }
+
+  Globals::link();
+
+  auto* system_group = Globals::find("system");
+  system_group->find("heap_allocator")->init();
+  system_group->find("allocator")->init();
+  Globals::find("allocators")->init();
+  system_group->find("atoms")->init();
+  system_group->find("logger")->init();
+  system_group->find("thread_pool")->init(m_threads, 4096_z);
+
+  printf("%zu threads, best of %zu runs\n", m_threads, k_runs);
+}
+
+inline Environment::~Environment() {
+  auto* system_group = Globals::find("system");
+  system_group->find("thread_pool")->fini();
+  system_group->find("logger")->fini();
+  system_group->find("atoms")->fini();
+  Globals::find("allocators")->fini();
+  system_group->find("allocator")->fini();
+  system_group->find("heap_allocator")->fini();
+}
+
+inline Size Environment::threads() const {
+  return m_threads;
+}
+
+template<typename F>
+Float64 fastest(F&& _function) {
+  Float64 best = 0.0;
+  for (Size i = 0; i < k_runs; i++) {
+    Time::StopWatch timer;
+    timer.start();
+    _function();
+    timer.stop();
+
+    const Float64 seconds = timer.elapsed().total_seconds();
+    if (i == 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+  return best;
+}
+
+template<typename F>
+Float64 measure(const char* _name, Size _operations, F&& _function) {
+  const Float64 seconds = fastest(_function);
+  const Float64 nanoseconds = seconds * 1e9 / static_cast<Float64>(_operations);
+  printf("%-48s %12.2f ns/op %12.3f ms\n", _name, nanoseconds, seconds * 1e3);
+  return nanoseconds;
+}
+
+template<typename F>
+Float64 measure_bytes(const char* _name, Size _operations, Size _bytes, F&& _function) {
+  const Float64 seconds = fastest(_function);
+  const Float64 nanoseconds = seconds * 1e9 / static_cast<Float64>(_operations);
+  printf("%-48s %12.2f ns/op %12.2f GB/s\n", _name, nanoseconds,
+    static_cast<Float64>(_bytes) / nanoseconds);
+  return nanoseconds;
+}
+
+} // namespace rx::bench
+
+#endif // RX_BENCH_BENCH_H
@@ -0,0 +1,71 @@
+#ifndef RX_BENCH_BENCH_THREADS_H
+#define RX_BENCH_BENCH_THREADS_H
+#include "bench.h"
+
+#include "rx/core/vector.h"
+
+#include "rx/core/concurrency/atomic.h"
+#include "rx/core/concurrency/thread.h"
+#include "rx/core/concurrency/yield.h"
+
+namespace Rx::Bench {
+
+// Calls |_function| with the thread index on |_threads| threads at once and
+// returns the seconds from all of them starting to all of them finishing.
+template<typename F>
+Float64 run_threads(Size _threads, F&& _function);
+
+// Like |measure| where each run is |_function| on |_threads| threads at once.
+template<typename F>
+Float64 measure_threads(const char* _name, Size _threads, Size _operations, F&& _function);
+
+template<typename F>
+Float64 run_threads(Size _threads, F&& _function) {
+  Concurrency::Atomic<Size> ready{0};
+  Concurrency::Atomic<bool> go{false};
+
+  Vector<Concurrency::Thread> threads;
+  for (Size i = 0; i < _threads; i++) {
+    threads.emplace_back("bench", [&, i](int) {
+      ready.fetch_add(1);
+      while (!go.load()) {
+        Concurrency::yield();
+      }
+      _function(i);
+    });
+  }
+
+  while (ready.load() != _threads) {
+    Concurrency::yield();
+  }
+
+  Time::StopWatch timer;
+  timer.start();
+  go.store(true);
+  threads.each_fwd([](Concurrency::Thread& _thread) {
+    _thread.join();
+  });
+  timer.stop();
+
+  return timer.elapsed().total_seconds();
+}
+
+template<typename F>
+Float64 measure_threads(const char* _name, Size _threads, Size _operations, F&& _function) {
+  Float64 best = 0.0;
+  for (Size i = 0; i < k_runs; i++) {
+    const Float64 seconds = run_threads(_threads, _function);
+    if (i == 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+
+  const Float64 nanoseconds = best * 1e9 / static_cast<Float64>(_operations);
+  printf("%-40s %2zu thr %12.2f ns/op %12.3f ms\n", _name, _threads,
+    nanoseconds, best * 1e3);
+  return nanoseconds;
+}
+
+} // namespace rx::bench
+
+#endif // RX_BENCH_BENCH_THREADS_H
@@ -0,0 +1,106 @@
+#include "bench_threads.h"
+
+#include "rx/core/memory/bump_point_allocator.h"
+#include "rx/core/memory/system_allocator.h"
+
+#include "rx/core/concurrency/spin_lock.h"
+#include "rx/core/concurrency/scope_lock.h"
+
+#include "rx/core/assert.h"
+
+using namespace Rx;
+
+// Allocations each thread makes per run, in the size of a small render command.
+static constexpr const Size k_allocations = 100000;
+static constexpr const Size k_allocation_size = 64;
+
+// The allocator before it was lock-free, for comparison.
+struct LockedBumpPointAllocator {
+  LockedBumpPointAllocator(Byte* _memory, Size _size)
+    : m_data{_memory}
+    , m_size{_size}
+    , m_used{0}
+  {
+  }
+
+  Byte* allocate(Size _size) {
+    Concurrency::ScopeLock lock{m_lock};
+    if (m_used + _size > m_size) {
+      return nullptr;
+    }
+    Byte* result = m_data + m_used;
+    m_used += _size;
+    return result;
+  }
+
+  void reset() {
+    m_used = 0;
+  }
+
+private:
+  Concurrency::SpinLock m_lock;
+  Byte* m_data;
+  Size m_size;
+  Size m_used;
+};
+
+template<typename T>
+static void run(const char* _name, Size _threads, Byte* _memory, Size _size) {
+  Float64 best = 0.0;
+  for (Size i = 0; i < Bench::k_runs; i++) {
+    T allocator{_memory, _size};
+    const Float64 seconds = Bench::run_threads(_threads, [&](Size) {
+      for (Size j = 0; j < k_allocations; j++) {
+        Byte* data = allocator.allocate(k_allocation_size);
+        RX_ASSERT(data, "out of memory");
+        Bench::keep(data);
+      }
+    });
+    if (i == 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+
+  const Size operations = _threads * k_allocations;
+  printf("%-40s %2zu thr %12.2f ns/op %12.2f Mops/s\n", _name, _threads,
+    best * 1e9 / operations, operations / best * 1e-6);
+}
+
+int main(int _argc, char** _argv) {
+  Bench::Environment environment{_argc, _argv};
+
+  auto& system_allocator = Memory::SystemAllocator::instance();
+
+  for (Size threads = 1; threads <= environment.threads() * 2; threads *= 2) {
+    const Size size = threads * k_allocations * k_allocation_size;
+    Byte* memory = system_allocator.allocate(size);
+    RX_ASSERT(memory, "out of memory");
+
+    run<LockedBumpPointAllocator>("locked bump point allocate", threads, memory, size);
+    run<Memory::BumpPointAllocator>("BumpPointAllocator::allocate", threads, memory, size);
+
+    system_allocator.deallocate(memory);
+  }
+
+  // Growing the last allocation in place, as CommandBuffer does when a command
+  // is extended.
+  {
+    const Size size = k_allocations * k_allocation_size * 2;
+    Byte* memory = system_allocator.allocate(size);
+    RX_ASSERT(memory, "out of memory");
+
+    Bench::measure("BumpPointAllocator::reallocate in place", k_allocations, [&] {
+      Memory::BumpPointAllocator allocator{memory, size};
+      for (Size i = 0; i < k_allocations; i++) {
+        Byte* data = allocator.allocate(k_allocation_size);
+        data = allocator.reallocate(data, k_allocation_size * 2);
+        RX_ASSERT(data, "out of memory");
+        allocator.deallocate(data);
+      }
+    });
+
+    system_allocator.deallocate(memory);
+  }
+
+  return 0;
+}
@@ -0,0 +1,139 @@
+#include "bench.h"
+
+#include "rx/core/flat_map.h"
+#include "rx/core/map.h"
+#include "rx/core/string.h"
+
+#include "rx/core/prng/mt19937.h"
+
+#include "rx/core/assert.h"
+
+using namespace Rx;
+
+// Every measurement does at least this many operations, small maps are built
+// and torn down repeatedly, which includes the cost of their first allocation.
+static constexpr const Size k_operations = 1 << 20;
+
+template<template<typename, typename> typename M, typename K>
+static void run(const char* _name, const Vector<K>& _keys, const Vector<K>& _misses) {
+  const Size size = _keys.size();
+  const Size rounds = size < k_operations ? k_operations / size : 1;
+  const Size operations = rounds * size;
+
+  char name[64];
+
+  snprintf(name, sizeof name, "%s insert (%zu)", _name, size);
+  Bench::measure(name, operations, [&] {
+    for (Size round = 0; round < rounds; round++) {
+      M<K, Size> map;
+      for (Size i = 0; i < size; i++) {
+        map.insert(_keys[i], i);
+      }
+      Bench::keep(map.size());
+    }
+  });
+
+  M<K, Size> map;
+  for (Size i = 0; i < size; i++) {
+    map.insert(_keys[i], i);
+  }
+
+  snprintf(name, sizeof name, "%s find hit (%zu)", _name, size);
+  Bench::measure(name, operations, [&] {
+    Size sum = 0;
+    for (Size round = 0; round < rounds; round++) {
+      for (Size i = 0; i < size; i++) {
+        sum += *map.find(_keys[i]);
+      }
+    }
+    Bench::keep(sum);
+  });
+
+  snprintf(name, sizeof name, "%s find miss (%zu)", _name, size);
+  Bench::measure(name, operations, [&] {
+    Size misses = 0;
+    for (Size round = 0; round < rounds; round++) {
+      for (Size i = 0; i < size; i++) {
+        misses += map.find(_misses[i]) == nullptr;
+      }
+    }
+    RX_ASSERT(misses == operations, "unexpected hit");
+    Bench::keep(misses);
+  });
+
+  // Erasing needs a full map every round, building it is timed too. Subtract
+  // the insert measurement for the cost of erase alone.
+  snprintf(name, sizeof name, "%s insert+erase (%zu)", _name, size);
+  Bench::measure(name, operations, [&] {
+    for (Size round = 0; round < rounds; round++) {
+      M<K, Size> copy;
+      for (Size i = 0; i < size; i++) {
+        copy.insert(_keys[i], i);
+      }
+      for (Size i = 0; i < size; i++) {
+        copy.erase(_keys[i]);
+      }
+      Bench::keep(copy.size());
+    }
+  });
+}
+
+// Distinct keys, the first half are inserted and the second half are misses.
+static void generate(PRNG::MT19937& _random, Size _size, Vector<Uint64>& keys_, Vector<Uint64>& misses_) {
+  FlatMap<Uint64, bool> seen;
+  while (keys_.size() + misses_.size() < _size * 2) {
+    const Uint64 key = _random.u64();
+    if (seen.find(key)) {
+      continue;
+    }
+    seen.insert(key, true);
+    (keys_.size() < _size ? keys_ : misses_).push_back(key);
+  }
+}
+
+static void generate(PRNG::MT19937& _random, Size _size, Vector<String>& keys_, Vector<String>& misses_) {
+  Vector<Uint64> keys;
+  Vector<Uint64> misses;
+  generate(_random, _size, keys, misses);
+
+  // Identifier-like keys, as in the resource caches and console lookups.
+  keys.each_fwd([&](Uint64 _key) {
+    keys_.push_back(String::format("textures/%016llx.png", static_cast<unsigned long long>(_key)));
+  });
+  misses.each_fwd([&](Uint64 _key) {
+    misses_.push_back(String::format("textures/%016llx.png", static_cast<unsigned long long>(_key)));
+  });
+}
+
+template<typename K>
+static void run_all(const char* _key_name, PRNG::MT19937& _random, Size _size) {
+  Vector<K> keys;
+  Vector<K> misses;
+  generate(_random, _size, keys, misses);
+
+  char name[32];
+  snprintf(name, sizeof name, "FlatMap<%s>", _key_name);
+  run<FlatMap>(name, keys, misses);
+  snprintf(name, sizeof name, "Map<%s>", _key_name);
+  run<Map>(name, keys, misses);
+}
+
+int main(int _argc, char** _argv) {
+  Bench::Environment environment{_argc, _argv};
+
+  PRNG::MT19937 random;
+  random.seed(0x5eed);
+
+  static constexpr const Size k_integer_sizes[]{16, 1024, 1 << 20};
+  static constexpr const Size k_string_sizes[]{16, 1024, 1 << 16};
+
+  for (Size size : k_integer_sizes) {
+    run_all<Uint64>("Uint64", random, size);
+  }
+
+  for (Size size : k_string_sizes) {
+    run_all<String>("String", random, size);
+  }
+
+  return 0;
+}
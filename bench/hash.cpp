@@ -0,0 +1,65 @@
+#include "bench.h"
+
+#include "rx/core/hash/fnv1a.h"
+#include "rx/core/hash/wyhash.h"
+
+#include "rx/core/memory/system_allocator.h"
+#include "rx/core/prng/mt19937.h"
+
+#include "rx/core/assert.h"
+
+using namespace Rx;
+
+// The byte hashes can't be included together with rx/core/hash.h, the integer
+// hashes are measured by integer_hash.cpp.
+
+// Bytes hashed for every key size.
+static constexpr const Size k_bytes = 64 << 20;
+
+template<typename F>
+static void run_bytes(const char* _name, const Byte* _data, Size _size, F&& _hash) {
+  const Size keys = k_bytes / _size;
+
+  char name[64];
+  snprintf(name, sizeof name, "%s (%zu bytes)", _name, _size);
+
+  Bench::measure_bytes(name, keys, _size, [&] {
+    Uint64 sum = 0;
+    for (Size i = 0; i < keys; i++) {
+      // Hash different bytes every time so the keys aren't all in cache.
+      sum += _hash(_data + (i * _size) % (k_bytes - _size), _size);
+    }
+    Bench::keep(sum);
+  });
+}
+
+int main(int _argc, char** _argv) {
+  Bench::Environment environment{_argc, _argv};
+
+  auto& allocator = Memory::SystemAllocator::instance();
+  Byte* data = allocator.allocate(k_bytes);
+  RX_ASSERT(data, "out of memory");
+
+  PRNG::MT19937 random;
+  random.seed(0x5eed);
+  for (Size i = 0; i < k_bytes; i++) {
+    data[i] = static_cast<Byte>(random.u32());
+  }
+
+  static constexpr const Size k_sizes[]{4, 8, 16, 32, 64, 256, 1024, 64 << 10};
+  for (Size size : k_sizes) {
+    run_bytes("fnv1a<Uint64>", data, size, [](const Byte* _data, Size _size) {
+      return Hash::fnv1a<Uint64>(_data, _size);
+    });
+    run_bytes("wyhash", data, size, [](const Byte* _data, Size _size) {
+      return Hash::wyhash(_data, _size);
+    });
+    run_bytes("wyhash seeded", data, size, [](const Byte* _data, Size _size) {
+      return Hash::wyhash(_data, _size, 0x9e3779b97f4a7c15_u64);
+    });
+  }
+
+  allocator.deallocate(data);
+
+  return 0;
+}
@@ -0,0 +1,52 @@
+#include "bench.h"
+
+#include "rx/core/hash.h"
+
+using namespace Rx;
+
+static constexpr const Size k_integers = 1 << 26;
+
+// The integer hash before it was replaced by the MurmurHash3 finalizer, for
+// comparison.
+static constexpr Size thomas_wang_hash(Uint64 _value) {
+  _value = (~_value) + (_value << 21);
+  _value = _value ^ (_value >> 24);
+  _value = (_value + (_value << 3)) + (_value << 8);
+  _value = _value ^ (_value >> 14);
+  _value = (_value + (_value << 2)) + (_value << 4);
+  _value = _value ^ (_value << 28);
+  _value = _value + (_value << 31);
+  return static_cast<Size>(_value);
+}
+
+int main(int _argc, char** _argv) {
+  Bench::Environment environment{_argc, _argv};
+
+  // The hashes are measured on a dependent chain, as in hash_combine, so the
+  // latency of the hash is what's measured.
+  Bench::measure("Hash<Uint64> (latency)", k_integers, [&] {
+    Size hash = 0;
+    for (Size i = 0; i < k_integers; i++) {
+      hash = Hash<Uint64>{}(hash + i);
+    }
+    Bench::keep(hash);
+  });
+
+  Bench::measure("previous Hash<Uint64> (latency)", k_integers, [&] {
+    Size hash = 0;
+    for (Size i = 0; i < k_integers; i++) {
+      hash = thomas_wang_hash(hash + i);
+    }
+    Bench::keep(hash);
+  });
+
+  Bench::measure("hash_combine (latency)", k_integers, [&] {
+    Size hash = 0;
+    for (Size i = 0; i < k_integers; i++) {
+      hash = hash_combine(hash, i);
+    }
+    Bench::keep(hash);
+  });
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+#include <pthread.h> // pthread_mutex_t
+
+#include "bench_threads.h"
+
+#include "rx/core/concurrency/mutex.h"
+#include "rx/core/concurrency/spin_lock.h"
+#include "rx/core/concurrency/scope_lock.h"
+#include "rx/core/concurrency/wait_group.h"
+
+#include "rx/core/assert.h"
+
+using namespace Rx;
+
+// Lock and unlock pairs each thread makes per run.
+static constexpr const Size k_locks = 200000;
+
+// Signals each thread gives a wait group per run.
+static constexpr const Size k_signals = 100000;
+
+// The OS mutex, for comparison.
+struct PthreadMutex {
+  PthreadMutex() {
+    RX_ASSERT(pthread_mutex_init(&m_mutex, nullptr) == 0, "failed to create mutex");
+  }
+
+  ~PthreadMutex() {
+    RX_ASSERT(pthread_mutex_destroy(&m_mutex) == 0, "failed to destroy mutex");
+  }
+
+  void lock() {
+    RX_ASSERT(pthread_mutex_lock(&m_mutex) == 0, "failed to lock mutex");
+  }
+
+  void unlock() {
+    RX_ASSERT(pthread_mutex_unlock(&m_mutex) == 0, "failed to unlock mutex");
+  }
+
+private:
+  pthread_mutex_t m_mutex;
+};
+
+// Every thread increments one counter under the lock, the critical section is
+// as short as it gets so this measures the lock alone.
+template<typename T>
+static void run_lock(const char* _name, Size _threads) {
+  T lock;
+  Size counter = 0;
+
+  Bench::measure_threads(_name, _threads, _threads * k_locks, [&](Size) {
+    for (Size i = 0; i < k_locks; i++) {
+      Concurrency::ScopeLock locked{lock};
+      counter++;
+    }
+  });
+
+  RX_ASSERT(counter == _threads * k_locks * Bench::k_runs, "lost update");
+}
+
+// One thread waits while the others signal, the way ThreadPool users wait for
+// their tasks.
+static void run_wait_group(Size _signallers) {
+  Float64 best = 0.0;
+  for (Size i = 0; i < Bench::k_runs; i++) {
+    Concurrency::WaitGroup group{_signallers * k_signals};
+    const Float64 seconds = Bench::run_threads(_signallers + 1, [&](Size _index) {
+      if (_index == 0) {
+        group.wait();
+        return;
+      }
+      for (Size j = 0; j < k_signals; j++) {
+        group.signal();
+      }
+    });
+    if (i == 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+
+  const Size operations = _signallers * k_signals;
+  printf("%-40s %2zu thr %12.2f ns/op %12.3f ms\n", "WaitGroup::signal", _signallers,
+    best * 1e9 / operations, best * 1e3);
+}
+
+int main(int _argc, char** _argv) {
+  Bench::Environment environment{_argc, _argv};
+
+  for (Size threads = 1; threads <= environment.threads() * 2; threads *= 2) {
+    run_lock<PthreadMutex>("pthread_mutex_t (OS)", threads);
+    run_lock<Concurrency::Mutex>("Mutex", threads);
+    run_lock<Concurrency::SpinLock>("SpinLock", threads);
+  }
+
+  for (Size threads = 1; threads <= environment.threads() * 2; threads *= 2) {
+    run_wait_group(threads);
+  }
+
+  return 0;
+}
@@ -0,0 +1,212 @@
+#include "bench_threads.h"
+
+#include "rx/core/concurrency/spsc_queue.h"
+#include "rx/core/concurrency/mpmc_queue.h"
+#include "rx/core/concurrency/mpsc_queue.h"
+#include "rx/core/concurrency/mutex.h"
+#include "rx/core/concurrency/scope_lock.h"
+
+#include "rx/core/memory/system_allocator.h"
+#include "rx/core/algorithm/min.h"
+#include "rx/core/traits/is_same.h"
+
+#include "rx/core/assert.h"
+
+using namespace Rx;
+
+// Values each producer pushes per run.
+static constexpr const Size k_values = 200000;
+
+// Capacity of the bounded queues, the size ThreadPool uses is 4096.
+static constexpr const Size k_capacity = 1024;
+
+// Values moved per call by the batch measurements.
+static constexpr const Size k_batch = 32;
+
+// Round trips per run of the ping-pong measurement.
+static constexpr const Size k_round_trips = 100000;
+
+// A ring buffer under a mutex, what the lock-free queues replaced.
+template<typename T>
+struct LockedQueue {
+  LockedQueue(Size _capacity)
+    : m_head{0}
+    , m_tail{0}
+  {
+    RX_ASSERT(m_data.resize(_capacity), "out of memory");
+  }
+
+  bool push(const T& _value) {
+    Concurrency::ScopeLock lock{m_mutex};
+    if (m_tail - m_head == m_data.size()) {
+      return false;
+    }
+    m_data[m_tail++ % m_data.size()] = _value;
+    return true;
+  }
+
+  bool pop(T& value_) {
+    Concurrency::ScopeLock lock{m_mutex};
+    if (m_head == m_tail) {
+      return false;
+    }
+    value_ = m_data[m_head++ % m_data.size()];
+    return true;
+  }
+
+  Size push(const T* _values, Size _count) {
+    Concurrency::ScopeLock lock{m_mutex};
+    const Size count = Algorithm::min(_count, m_data.size() - (m_tail - m_head));
+    for (Size i = 0; i < count; i++) {
+      m_data[m_tail++ % m_data.size()] = _values[i];
+    }
+    return count;
+  }
+
+  Size pop(T* values_, Size _count) {
+    Concurrency::ScopeLock lock{m_mutex};
+    const Size count = Algorithm::min(_count, m_tail - m_head);
+    for (Size i = 0; i < count; i++) {
+      values_[i] = m_data[m_head++ % m_data.size()];
+    }
+    return count;
+  }
+
+private:
+  Concurrency::Mutex m_mutex;
+  Vector<T> m_data;
+  Size m_head;
+  Size m_tail;
+};
+
+template<typename T>
+static T* create_queue() {
+  if constexpr (traits::is_same<T, Concurrency::MPSCQueue<Uint64>>) {
+    return Memory::SystemAllocator::instance().create<T>();
+  } else {
+    return Memory::SystemAllocator::instance().create<T>(k_capacity);
+  }
+}
+
+// Thread zero consumes every value the other |_producers| threads push,
+// retrying when the queue is full or empty. With |_batch| values are pushed
+// and popped |k_batch| at a time.
+template<typename T>
+static void run_throughput(const char* _name, Size _producers, bool _batch) {
+  const Size values = _producers * k_values;
+
+  Float64 best = 0.0;
+  for (Size i = 0; i < Bench::k_runs; i++) {
+    T* queue = create_queue<T>();
+    RX_ASSERT(queue, "out of memory");
+
+    Uint64 sum = 0;
+    const Float64 seconds = Bench::run_threads(_producers + 1, [&](Size _index) {
+      Uint64 batch[k_batch];
+      if (_index == 0) {
+        for (Size popped = 0; popped < values; ) {
+          if (_batch) {
+            const Size count = queue->pop(batch, k_batch);
+            for (Size j = 0; j < count; j++) {
+              sum += batch[j];
+            }
+            popped += count;
+            if (count) {
+              continue;
+            }
+          } else if (queue->pop(batch[0])) {
+            sum += batch[0];
+            popped++;
+            continue;
+          }
+          Concurrency::yield();
+        }
+        return;
+      }
+
+      for (Size pushed = 0; pushed < k_values; ) {
+        if (_batch) {
+          const Size count = Algorithm::min(k_batch, k_values - pushed);
+          for (Size j = 0; j < count; j++) {
+            batch[j] = pushed + j;
+          }
+          const Size added = queue->push(batch, count);
+          pushed += added;
+          if (!added) {
+            Concurrency::yield();
+          }
+        } else if (queue->push(static_cast<Uint64>(pushed))) {
+          pushed++;
+        } else {
+          Concurrency::yield();
+        }
+      }
+    });
+
+    // Every producer pushes 0 to |k_values| - 1.
+    RX_ASSERT(sum == _producers * (k_values * (k_values - 1) / 2), "lost values");
+
+    Memory::SystemAllocator::instance().destroy<T>(queue);
+
+    if (i == 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+
+  char name[64];
+  snprintf(name, sizeof name, "%s%s", _name, _batch ? " (batch)" : "");
+  printf("%-40s %2zu thr %12.2f ns/op %12.2f Mops/s\n", name, _producers,
+    best * 1e9 / values, values / best * 1e-6);
+}
+
+// One value bounces between two threads through a pair of queues, the time of
+// a round trip is twice the latency of handing a value to another thread.
+static void run_ping_pong() {
+  Float64 best = 0.0;
+  for (Size i = 0; i < Bench::k_runs; i++) {
+    Concurrency::SPSCQueue<Uint64> ping{k_capacity};
+    Concurrency::SPSCQueue<Uint64> pong{k_capacity};
+    const Float64 seconds = Bench::run_threads(2, [&](Size _index) {
+      auto& in = _index == 0 ? pong : ping;
+      auto& out = _index == 0 ? ping : pong;
+      if (_index == 0) {
+        RX_ASSERT(out.push(0_u64), "queue full");
+      }
+      for (Size j = 0; j < k_round_trips; j++) {
+        Uint64 value;
+        while (!in.pop(value)) {
+          Concurrency::yield();
+        }
+        if (_index == 1 || j + 1 < k_round_trips) {
+          RX_ASSERT(out.push(value + 1), "queue full");
+        }
+      }
+    });
+    if (i == 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+
+  printf("%-40s %2d thr %12.2f ns/op\n", "SPSCQueue ping-pong round trip", 2,
+    best * 1e9 / k_round_trips);
+}
+
+int main(int _argc, char** _argv) {
+  Bench::Environment environment{_argc, _argv};
+
+  // Compare with the single producer lines below.
+  run_throughput<Concurrency::SPSCQueue<Uint64>>("SPSCQueue", 1, false);
+  run_throughput<Concurrency::SPSCQueue<Uint64>>("SPSCQueue", 1, true);
+
+  for (Size producers = 1; producers <= environment.threads() * 2; producers *= 2) {
+    run_throughput<LockedQueue<Uint64>>("Mutex + ring buffer", producers, false);
+    run_throughput<Concurrency::MPMCQueue<Uint64>>("MPMCQueue", producers, false);
+    run_throughput<Concurrency::MPMCQueue<Uint64>>("MPMCQueue", producers, true);
+    run_throughput<Concurrency::MPSCQueue<Uint64>>("MPSCQueue", producers, false);
+    run_throughput<Concurrency::MPSCQueue<Uint64>>("MPSCQueue", producers, true);
+  }
+
+  run_ping_pong();
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+#include <string.h> // memcpy
+
+#include "bench.h"
+
+#include "rx/core/algorithm/quick_sort.h"
+#include "rx/core/algorithm/merge_sort.h"
+#include "rx/core/algorithm/radix_sort.h"
+#include "rx/core/algorithm/parallel_sort.h"
+
+#include "rx/core/prng/mt19937.h"
+
+#include "rx/core/assert.h"
+
+using namespace Rx;
+
+// Small inputs are sorted repeatedly until at least this many elements are.
+static constexpr const Size k_elements = 1 << 20;
+
+// A sort key with a payload, about the size of a draw call or a particle.
+struct Record {
+  Uint32 key;
+  Uint32 index;
+  Byte payload[24];
+};
+
+static inline Uint64 key_of(Uint64 _value) {
+  return _value;
+}
+
+static inline Uint64 key_of(const Record& _record) {
+  return _record.key;
+}
+
+// Sorts a copy of |_input| with |_sort|, only the sort is timed.
+template<typename T, typename F>
+static void run(const char* _name, const Vector<T>& _input, F&& _sort) {
+  const Size size = _input.size();
+  const Size rounds = size < k_elements ? k_elements / size : 1;
+
+  Vector<T> data;
+  RX_ASSERT(data.resize(size), "out of memory");
+
+  Float64 best = 0.0;
+  for (Size i = 0; i < Bench::k_runs; i++) {
+    Float64 seconds = 0.0;
+    for (Size round = 0; round < rounds; round++) {
+      memcpy(data.data(), _input.data(), sizeof(T) * size);
+
+      Time::StopWatch timer;
+      timer.start();
+      RX_ASSERT(_sort(data.data(), data.data() + size), "out of memory");
+      timer.stop();
+
+      seconds += timer.elapsed().total_seconds();
+    }
+    if (i == 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+
+  for (Size i = 1; i < size; i++) {
+    RX_ASSERT(key_of(data[i - 1]) <= key_of(data[i]), "not sorted");
+  }
+
+  char name[80];
+  snprintf(name, sizeof name, "%s (%zu)", _name, size);
+
+  const Float64 nanoseconds = best * 1e9 / static_cast<Float64>(rounds * size);
+  printf("%-48s %12.2f ns/op %12.3f ms\n", name, nanoseconds, best * 1e3 / rounds);
+}
+
+template<typename T>
+static void run_all(const char* _type, const Vector<T>& _input) {
+  char name[48];
+
+  const auto compare = [](const T& _lhs, const T& _rhs) {
+    return key_of(_lhs) < key_of(_rhs);
+  };
+
+  snprintf(name, sizeof name, "quick_sort<%s>", _type);
+  run(name, _input, [&](T* _start, T* _end) {
+    Algorithm::quick_sort(_start, _end, compare);
+    return true;
+  });
+
+  snprintf(name, sizeof name, "merge_sort<%s>", _type);
+  run(name, _input, [&](T* _start, T* _end) {
+    return Algorithm::merge_sort(_start, _end, compare);
+  });
+
+  snprintf(name, sizeof name, "radix_sort<%s>", _type);
+  run(name, _input, [&](T* _start, T* _end) {
+    return Algorithm::radix_sort(_start, _end, [](const T& _value) {
+      return key_of(_value);
+    });
+  });
+
+  snprintf(name, sizeof name, "parallel_sort<%s>", _type);
+  run(name, _input, [&](T* _start, T* _end) {
+    return Algorithm::parallel_sort(_start, _end, compare);
+  });
+}
+
+int main(int _argc, char** _argv) {
+  Bench::Environment environment{_argc, _argv};
+
+  PRNG::MT19937 random;
+  random.seed(0x5eed);
+
+  static constexpr const Size k_integer_sizes[]{1 << 10, 1 << 16, 1 << 20, 10000000};
+  static constexpr const Size k_record_sizes[]{1 << 10, 1 << 16, 1 << 20};
+
+  for (Size size : k_integer_sizes) {
+    Vector<Uint64> input;
+    for (Size i = 0; i < size; i++) {
+      input.push_back(random.u64());
+    }
+    run_all("Uint64", input);
+  }
+
+  // Radix sort only has to look at the four bytes of the key here, the
+  // comparison sorts move the whole record.
+  for (Size size : k_record_sizes) {
+    Vector<Record> input;
+    for (Size i = 0; i < size; i++) {
+      input.push_back({random.u32(), static_cast<Uint32>(i), {}});
+    }
+    run_all("Record", input);
+  }
+
+  return 0;
+}
@@ -0,0 +1,173 @@
+#include <string.h> // strlen, strstr, memcpy
+
+#include "bench.h"
+
+#include "rx/core/string_table.h"
+#include "rx/core/stream.h"
+#include "rx/core/string.h"
+#include "rx/core/map.h"
+
+#include "rx/core/serialize/encoder.h"
+
+#include "rx/core/assert.h"
+
+using namespace Rx;
+
+// The payload is |k_strings| identifiers of which |k_unique| are different,
+// about what a large model or material library interns. Every fourth string
+// is the suffix of another so compaction has something to share.
+static constexpr const Size k_strings = 100000;
+static constexpr const Size k_unique = 50000;
+
+// The string table before it was indexed, for comparison. It searched the
+// table with strstr, which stops at the first null-terminator, so it almost
+// never found a duplicate and only ever did the work of appending.
+struct StrstrStringTable {
+  Optional<Size> insert(const char* _string, Size _size) {
+    if (m_data.size()) {
+      if (const char* search = strstr(m_data.data(), _string)) {
+        return static_cast<Size>(search - m_data.data());
+      }
+    }
+    const Size offset = m_data.size();
+    if (!m_data.resize(offset + _size + 1, Utility::UninitializedTag{})) {
+      return nullopt;
+    }
+    memcpy(m_data.data() + offset, _string, _size + 1);
+    return offset;
+  }
+
+  Size size() const {
+    return m_data.size();
+  }
+
+private:
+  Vector<char> m_data;
+};
+
+// Seekable stream into memory for the encoder.
+struct MemoryStream
+  final : Stream
+{
+  MemoryStream()
+    : Stream{k_write | k_tell | k_seek}
+    , m_name{"memory"}
+    , m_offset{0}
+  {
+  }
+
+  virtual Uint64 on_write(const Byte* _data, Uint64 _size) {
+    if (m_offset + _size > m_data.size()
+      && !m_data.resize(m_offset + _size, Utility::UninitializedTag{}))
+    {
+      return 0;
+    }
+    memcpy(m_data.data() + m_offset, _data, _size);
+    m_offset += _size;
+    return _size;
+  }
+
+  virtual bool on_seek(Sint64 _where, Whence _whence) {
+    switch (_whence) {
+    case Whence::k_set:
+      m_offset = _where;
+      break;
+    case Whence::k_current:
+      m_offset += _where;
+      break;
+    case Whence::k_end:
+      m_offset = m_data.size() + _where;
+      break;
+    }
+    return true;
+  }
+
+  virtual Uint64 on_tell() {
+    return m_offset;
+  }
+
+  virtual const String& name() const & {
+    return m_name;
+  }
+
+  Size size() const {
+    return m_data.size();
+  }
+
+private:
+  String m_name;
+  Vector<Byte> m_data;
+  Size m_offset;
+};
+
+int main(int _argc, char** _argv) {
+  Bench::Environment environment{_argc, _argv};
+
+  Vector<String> strings;
+  for (Size i = 0; i < k_strings; i++) {
+    strings.push_back(String::format((i & 3) == 3 ? "%zu_%s" : "identifier_%zu_%s",
+      (i * 7919) % k_unique, (i & 1) ? "uniform" : "material"));
+  }
+
+  Size size = 0;
+
+  Bench::measure("strstr StringTable::insert (previous)", k_strings, [&] {
+    StrstrStringTable table;
+    strings.each_fwd([&](const String& _string) {
+      RX_ASSERT(table.insert(_string.data(), _string.size()), "out of memory");
+    });
+    size = table.size();
+  });
+  printf("%-48s %12zu bytes\n", "", size);
+
+  Bench::measure("StringTable::insert", k_strings, [&] {
+    StringTable table;
+    strings.each_fwd([&](const String& _string) {
+      RX_ASSERT(table.insert(_string), "out of memory");
+    });
+    size = table.size();
+  });
+  printf("%-48s %12zu bytes\n", "", size);
+
+  // Every insert is a duplicate, what interning a repeated string costs.
+  {
+    StringTable table;
+    strings.each_fwd([&](const String& _string) {
+      RX_ASSERT(table.insert(_string), "out of memory");
+    });
+    Bench::measure("StringTable::insert (all duplicates)", k_strings, [&] {
+      Size sum = 0;
+      strings.each_fwd([&](const String& _string) {
+        sum += *table.insert(_string);
+      });
+      Bench::keep(sum);
+    });
+  }
+
+  Bench::measure("StringTable::insert + compact", k_strings, [&] {
+    StringTable table;
+    strings.each_fwd([&](const String& _string) {
+      RX_ASSERT(table.insert(_string), "out of memory");
+    });
+    Map<Size, Size> remap;
+    RX_ASSERT(table.compact(remap), "out of memory");
+    size = table.size();
+  });
+  printf("%-48s %12zu bytes\n", "", size);
+
+  // The whole payload through the encoder, a string and an integer per entry.
+  Bench::measure("serialize::Encoder payload", k_strings, [&] {
+    MemoryStream stream;
+    {
+      serialize::Encoder encoder{&stream};
+      strings.each_fwd([&](const String& _string) {
+        RX_ASSERT(encoder.write_string(_string), "write failed");
+        RX_ASSERT(encoder.write_uint(_string.size()), "write failed");
+      });
+    }
+    size = stream.size();
+  });
+  printf("%-48s %12zu bytes\n", "", size);
+
+  return 0;
+}
@@ -7,30 +7,81 @@
 #include "rx/console/command.h"
 #include "rx/console/parser.h"
 
-#include "rx/core/concurrency/spin_lock.h"
+#include "rx/core/concurrency/rw_lock.h"
 #include "rx/core/concurrency/scope_lock.h"
 
 #include "rx/core/filesystem/file.h"
-#include "rx/core/map.h"
+#include "rx/core/memory/tracing_allocator.h"
+#include "rx/core/memory/tagged_allocator.h"
+#include "rx/core/flat_map.h"
+#include "rx/core/string_view.h"
+#include "rx/core/string_builder.h"
+#include "rx/core/intrusive_rb_tree.h"
+#include "rx/core/intrusive_hash_table.h"
+
+#include "rx/core/utility/swap.h"
 
 #include "rx/core/log.h" // RX_LOG
 
 namespace Rx::Console {
 
-static Concurrency::SpinLock g_lock;
-static VariableReference* g_head RX_HINT_GUARDED_BY(g_lock);
+// Variables are registered during static initialization, they're kept ordered
+// by name for iteration and prefix searches and hashed by name for exact
+// lookups. Both indices use storage inside the variable itself and static
+// buckets, nothing is allocated on registration.
+static constexpr const Size k_variable_buckets = 256;
+static Concurrency::RWLock g_lock;
+static IntrusiveRBTree g_variables RX_HINT_GUARDED_BY(g_lock);
+static IntrusiveHashTable::Node* g_variable_buckets[k_variable_buckets];
+static IntrusiveHashTable g_variable_table RX_HINT_GUARDED_BY(g_lock)
+  {g_variable_buckets, k_variable_buckets};
+
+static Size hash_variable_name(const char* _name) {
+  return String::hash_of(_name, strlen(_name));
+}
+
+static int compare_variables(const VariableReference& _lhs, const VariableReference& _rhs) {
+  return strcmp(_lhs.name(), _rhs.name());
+}
+
+static int compare_variable_name(const char* _name, const VariableReference& _reference) {
+  return strcmp(_name, _reference.name());
+}
 
 RX_LOG("console", logger);
 
 static GlobalGroup g_group_cvars{"cvars"};
 static GlobalGroup g_group_console{"console"};
 
+static Global<Memory::TaggedAllocator> g_allocator{"allocators", "console",
+  Memory::SystemAllocator::instance(), "console"};
+
 // TODO(dweiler): limited line count queue for messages on the console.
-static Global<Vector<String>> g_lines{"console", "lines"};
-static Global<Map<String, Command>> g_commands{"console", "commands"};
+static Global<Vector<String>> g_lines{"console", "lines", *g_allocator};
+static Global<FlatMap<String, Command>> g_commands{"console", "commands", *g_allocator};
+
+// Command names kept sorted for prefix searches.
+static Global<Vector<String>> g_command_names{"console", "command_names", *g_allocator};
+
+// Index of the first name in |_names| which doesn't order before |_key|,
+// compares at most |_length| characters.
+static Size lower_bound(const Vector<String>& _names, const char* _key, Size _length) {
+  Size first = 0;
+  Size count = _names.size();
+  while (count) {
+    const Size half = count / 2;
+    if (strncmp(_names[first + half].data(), _key, _length) < 0) {
+      first += half + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+  return first;
+}
 
 void Interface::write(const String& message_) {
-  g_lines->push_back(message_);
+  g_lines->push_back({*g_allocator, message_});
 }
 
 void Interface::clear() {
@@ -44,7 +95,19 @@ const Vector<String>& Interface::lines() {
 void Interface::add_command(const String& _name, const char* _signature,
   Function<bool(const Vector<Command::Argument>&)>&& _function)
 {
-  g_commands->insert(_name, {_name, _signature, Utility::move(_function)});
+  g_commands->insert(_name, {*g_allocator, _name, _signature, Utility::move(_function)});
+
+  auto& names = *g_command_names;
+  const Size index = lower_bound(names, _name.data(), _name.size() + 1);
+  if (index < names.size() && names[index] == _name) {
+    return;
+  }
+
+  // Insert in order by moving the new name down from the end.
+  RX_ASSERT(names.push_back(_name), "out of memory");
+  for (Size i = names.size() - 1; i > index; i--) {
+    Utility::swap(names[i], names[i - 1]);
+  }
 }
 
 static bool type_check(VariableType _VariableType, Token::Type _token_type) {
@@ -74,7 +137,8 @@ static bool type_check(VariableType _VariableType, Token::Type _token_type) {
 }
 
 bool Interface::execute(const String& _contents) {
-  Parser parse{Memory::SystemAllocator::instance()};
+  RX_MEMORY_TRACE_SCOPE();
+  Parser parse{*g_allocator};
 
   if (!parse.parse(_contents)) {
     const auto& diagnostic{parse.error()};
@@ -142,31 +206,39 @@ bool Interface::execute(const String& _contents) {
 
 Vector<String> Interface::auto_complete_variables(const String& _prefix) {
   Vector<String> results;
-  for (VariableReference* node{g_head}; node; node = node->m_next) {
-    if (!strncmp(node->m_name, _prefix.data(), _prefix.size())) {
-      results.push_back(node->m_name);
+  Concurrency::ScopeReadLock locked{g_lock};
+
+  // Names sharing the prefix are adjacent in order, starting at the first
+  // name which doesn't order before the prefix.
+  const auto* reference = g_variables.lower_bound(_prefix.data(),
+    &VariableReference::m_link, compare_variable_name);
+  for (const IntrusiveRBTree::Node* node = reference ? &reference->m_link : nullptr;
+    node; node = node->next())
+  {
+    const auto* data = node->data(&VariableReference::m_link);
+    if (strncmp(data->m_name, _prefix.data(), _prefix.size())) {
+      break;
     }
+    results.push_back(data->m_name);
   }
+
   return results;
 }
 
 Vector<String> Interface::auto_complete_commands(const String& _prefix) {
   Vector<String> results;
-  g_commands->each_key([&](const String& _key) {
-    if (!strncmp(_key.data(), _prefix.data(), _prefix.size())) {
-      results.push_back(_key);
+  const auto& names = *g_command_names;
+  for (Size i = lower_bound(names, _prefix.data(), _prefix.size()); i < names.size(); i++) {
+    if (strncmp(names[i].data(), _prefix.data(), _prefix.size())) {
+      break;
     }
-  });
+    results.push_back(names[i]);
+  }
   return results;
 }
 
 bool Interface::load(const char* file_name) {
-  // sort references
-  {
-    Concurrency::ScopeLock locked{g_lock};
-    g_head = sort(g_head);
-  }
-
+  RX_MEMORY_TRACE_SCOPE();
   Filesystem::File file(file_name, "r");
   if (!file) {
     return false;
@@ -174,9 +246,9 @@ bool Interface::load(const char* file_name) {
 
   logger->info("loading '%s'", file_name);
 
-  Parser parse{Memory::SystemAllocator::instance()};
+  Parser parse{*g_allocator};
   for (String line_contents; file.read_line(line_contents); ) {
-    String line{line_contents.lstrip(" \t")};
+    const StringView line{StringView{line_contents}.lstrip(" \t")};
     if (line.is_empty() || strchr("#;[", line[0])) {
       // ignore empty and comment lines
       continue;
@@ -214,21 +286,25 @@ bool Interface::save(const char* file_name) {
   }
 
   logger->info("saving '%s'", file_name);
-  for (const VariableReference *head = g_head; head; head = head->m_next) {
-    if (VariableType_is_ranged(head->type())) {
-      file.print("## %s (in range %s, defaults to %s)\n",
-        head->description(), head->print_range(), head->print_initial());
-      file.print(head->is_initial() ? ";%s %s\n" : "%s %s\n",
-        head->name(), head->print_current());
+
+  // Build the whole file in memory and write it out at once.
+  StringBuilder contents;
+  Concurrency::ScopeReadLock locked{g_lock};
+  g_variables.each_fwd(&VariableReference::m_link, [&](const VariableReference* _reference) {
+    if (VariableType_is_ranged(_reference->type())) {
+      contents.format("## %s (in range %s, defaults to %s)\n",
+        _reference->description(), _reference->print_range(), _reference->print_initial());
+      contents.format(_reference->is_initial() ? ";%s %s\n" : "%s %s\n",
+        _reference->name(), _reference->print_current());
     } else {
-      file.print("## %s (defaults to %s)\n",
-        head->description(), head->print_initial());
-      file.print(head->is_initial() ? ";%s %s\n" : "%s %s\n",
-        head->name(), head->print_current());
+      contents.format("## %s (defaults to %s)\n",
+        _reference->description(), _reference->print_initial());
+      contents.format(_reference->is_initial() ? ";%s %s\n" : "%s %s\n",
+        _reference->name(), _reference->print_current());
     }
-  }
+  });
 
-  return true;
+  return contents.write(&file);
 }
 
 template<typename T>
@@ -283,62 +359,17 @@ VariableStatus Interface::set_from_reference_and_token(VariableReference* refere
 }
 
 VariableReference* Interface::find_variable_by_name(const char* _name) {
-  for (VariableReference* head{g_head}; head; head = head->m_next) {
-    if (!strcmp(head->name(), _name)) {
-      return head;
-    }
-  }
-  return nullptr;
+  Concurrency::ScopeReadLock locked{g_lock};
+  return g_variable_table.find(hash_variable_name(_name), &VariableReference::m_hashed,
+    [_name](const VariableReference& _reference) { return !strcmp(_name, _reference.name()); });
 }
 
-VariableReference* Interface::add_variable(VariableReference* reference) {
+void Interface::add_variable(VariableReference* reference) {
   logger->info("registered '%s'", reference->m_name);
   Concurrency::ScopeLock locked(g_lock);
-  VariableReference* next = g_head;
-  g_head = reference;
-  return next;
-}
-
-VariableReference* Interface::split(VariableReference* reference) {
-  if (!reference || !reference->m_next) {
-    return nullptr;
-  }
-  VariableReference* splitted = reference->m_next;
-  reference->m_next = splitted->m_next;
-  splitted->m_next = split(splitted->m_next);
-  return splitted;
-}
-
-VariableReference* Interface::merge(VariableReference* lhs, VariableReference* rhs) {
-  if (!lhs) {
-    return rhs;
-  }
-
-  if (!rhs) {
-    return lhs;
-  }
-
-  if (strcmp(lhs->m_name, rhs->m_name) > 0) {
-    rhs->m_next = merge(lhs, rhs->m_next);
-    return rhs;
-  }
-
-  lhs->m_next = merge(lhs->m_next, rhs);
-  return lhs;
-}
-
-VariableReference* Interface::sort(VariableReference* reference) {
-  if (!reference) {
-    return nullptr;
-  }
-
-  if (!reference->m_next) {
-    return reference;
-  }
-
-  VariableReference* splitted = split(reference);
-
-  return merge(sort(reference), sort(splitted));
+  const auto existing = g_variables.insert(&reference->m_link, &VariableReference::m_link, compare_variables);
+  RX_ASSERT(!existing, "variable '%s' already registered", reference->m_name);
+  g_variable_table.insert(&reference->m_hashed, hash_variable_name(reference->m_name));
 }
 
 } // namespace rx::console
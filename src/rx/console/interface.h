@@ -11,7 +11,7 @@ struct Interface {
   static bool load(const char* _file_name);
   static bool save(const char* _file_name);
 
-  static VariableReference* add_variable(VariableReference* _reference);
+  static void add_variable(VariableReference* _reference);
   static void add_command(const String& _name, const char* _signature,
     Function<bool(const Vector<Command::Argument>&)>&& _function);
 
@@ -36,11 +36,6 @@ private:
   // set variable |_reference| with value |_value|
   template<typename T>
   static VariableStatus set_from_reference_and_value(VariableReference* _reference, const T& _value);
-
-  // merge-sort variable references in alphabetical order
-  static VariableReference* split(VariableReference* _reference);
-  static VariableReference* merge(VariableReference* _lhs, VariableReference* _rhs);
-  static VariableReference* sort(VariableReference* _reference);
 };
 
 template<typename... Ts>
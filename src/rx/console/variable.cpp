@@ -56,7 +56,7 @@ VariableReference::VariableReference(const char* name,
   , m_handle{handle}
   , m_type{type}
 {
-  m_next = Interface::add_variable(this);
+  Interface::add_variable(this);
 }
 
 void VariableReference::reset() {
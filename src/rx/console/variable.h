@@ -6,6 +6,8 @@
 #include "rx/core/string.h" // string
 #include "rx/core/global.h" // global
 #include "rx/core/event.h" // event
+#include "rx/core/intrusive_rb_tree.h" // IntrusiveRBTree
+#include "rx/core/intrusive_hash_table.h" // IntrusiveHashTable
 
 #include "rx/math/vec2.h" // vec2{f,i}
 #include "rx/math/vec3.h" // vec3{f,i}
@@ -104,7 +106,8 @@ private:
   const char* m_description;
   void* m_handle;
   VariableType m_type;
-  VariableReference* m_next;
+  IntrusiveRBTree::Node m_link;
+  IntrusiveHashTable::Node m_hashed;
 };
 
 // variable_referece
@@ -0,0 +1,145 @@
+#ifndef RX_CORE_ALGORITHM_MERGE_SORT_H
+#define RX_CORE_ALGORITHM_MERGE_SORT_H
+#include "rx/core/algorithm/insertion_sort.h"
+#include "rx/core/algorithm/min.h"
+
+#include "rx/core/traits/is_trivially_copyable.h"
+
+#include "rx/core/utility/construct.h"
+#include "rx/core/utility/destruct.h"
+#include "rx/core/utility/forward.h"
+#include "rx/core/utility/move.h"
+
+#include "rx/core/memory/system_allocator.h"
+
+#include "rx/core/hints/unlikely.h"
+
+namespace Rx::Algorithm {
+
+// # Merge Sort
+//
+// Stable sort from |start_| to |end_| using |_compare| comparator. Elements
+// which compare equal keep their order, unlike |quick_sort|.
+//
+// Short runs are sorted with |insertion_sort| and then merged bottom-up,
+// back and forth between the elements and a buffer of the same size.
+//
+// Returns false when the buffer cannot be allocated from |_allocator|.
+template<typename T, typename F>
+bool merge_sort(Memory::Allocator& _allocator, T* start_, T* end_, F&& _compare);
+
+template<typename T, typename F>
+bool merge_sort(T* start_, T* end_, F&& _compare);
+
+namespace detail {
+  inline constexpr const Size k_merge_sort_run = 16;
+
+  // Merge sorted |_lhs| and |_rhs| into |dst_|. Elements of |_lhs| go first
+  // when equal.
+  template<typename T, typename F>
+  void merge(T* _lhs, Size _lhs_size, T* _rhs, Size _rhs_size, T* dst_, F& _compare) {
+    Size i = 0;
+    Size j = 0;
+    while (i < _lhs_size && j < _rhs_size) {
+      *dst_++ = _compare(_rhs[j], _lhs[i])
+        ? Utility::move(_rhs[j++]) : Utility::move(_lhs[i++]);
+    }
+    while (i < _lhs_size) {
+      *dst_++ = Utility::move(_lhs[i++]);
+    }
+    while (j < _rhs_size) {
+      *dst_++ = Utility::move(_rhs[j++]);
+    }
+  }
+
+  // Sort [_lo, _hi) of |data_| using the same range of |buffer_|, the result
+  // is always left in |data_|.
+  template<typename T, typename F>
+  void merge_sort(T* data_, T* buffer_, Size _lo, Size _hi, F& _compare) {
+    for (Size i = _lo; i < _hi; i += k_merge_sort_run) {
+      insertion_sort(data_ + i, data_ + Algorithm::min(i + k_merge_sort_run, _hi), _compare);
+    }
+
+    T* src = data_;
+    T* dst = buffer_;
+    for (Size width = k_merge_sort_run; width < _hi - _lo; width *= 2) {
+      for (Size lo = _lo; lo < _hi; lo += width * 2) {
+        const Size mid = Algorithm::min(lo + width, _hi);
+        const Size hi = Algorithm::min(lo + width * 2, _hi);
+        merge(src + lo, mid - lo, src + mid, hi - mid, dst + lo, _compare);
+      }
+      T* swap = src;
+      src = dst;
+      dst = swap;
+    }
+
+    if (src != data_) {
+      for (Size i = _lo; i < _hi; i++) {
+        data_[i] = Utility::move(src[i]);
+      }
+    }
+  }
+
+  // Merging move-assigns into the buffer so it must hold constructed elements.
+  // They're constructed by moving the elements into it, which makes the buffer
+  // the data to sort and the elements the buffer. Trivially copyable elements
+  // are sorted in place with an uninitialized buffer.
+  template<typename T>
+  T* merge_sort_buffer(Memory::Allocator& _allocator, T* _start, Size _size) {
+    auto buffer = reinterpret_cast<T*>(_allocator.allocate(sizeof(T), _size));
+    if constexpr (!traits::is_trivially_copyable<T>) {
+      if (buffer) {
+        for (Size i = 0; i < _size; i++) {
+          Utility::construct<T>(buffer + i, Utility::move(_start[i]));
+        }
+      }
+    }
+    return buffer;
+  }
+
+  // Move the sorted elements back and release the buffer.
+  template<typename T>
+  void merge_sort_buffer_release(Memory::Allocator& _allocator, T* _buffer, T* start_, Size _size) {
+    if constexpr (!traits::is_trivially_copyable<T>) {
+      for (Size i = 0; i < _size; i++) {
+        start_[i] = Utility::move(_buffer[i]);
+        Utility::destruct<T>(_buffer + i);
+      }
+    }
+    _allocator.deallocate(_buffer);
+  }
+} // namespace detail
+
+template<typename T, typename F>
+bool merge_sort(Memory::Allocator& _allocator, T* start_, T* end_, F&& _compare) {
+  const Size size = end_ - start_;
+  if (size <= detail::k_merge_sort_run) {
+    insertion_sort(start_, end_, _compare);
+    return true;
+  }
+
+  T* buffer = detail::merge_sort_buffer(_allocator, start_, size);
+  if (RX_HINT_UNLIKELY(!buffer)) {
+    return false;
+  }
+
+  if constexpr (traits::is_trivially_copyable<T>) {
+    detail::merge_sort(start_, buffer, 0, size, _compare);
+  } else {
+    detail::merge_sort(buffer, start_, 0, size, _compare);
+  }
+
+  detail::merge_sort_buffer_release(_allocator, buffer, start_, size);
+
+  return true;
+}
+
+template<typename T, typename F>
+inline bool merge_sort(T* start_, T* end_, F&& _compare) {
+  return merge_sort(Memory::SystemAllocator::instance(), start_, end_,
+    Utility::forward<F>(_compare));
+}
+
+} // namespace rx::algorithm
+
+#endif // RX_CORE_ALGORITHM_MERGE_SORT_H
@@ -0,0 +1,184 @@
+#ifndef RX_CORE_ALGORITHM_PARALLEL_SORT_H
+#define RX_CORE_ALGORITHM_PARALLEL_SORT_H
+#include "rx/core/algorithm/merge_sort.h"
+#include "rx/core/static_vector.h"
+
+#include "rx/core/concurrency/thread_pool.h"
+#include "rx/core/concurrency/wait_group.h"
+
+namespace Rx::Algorithm {
+
+// # Parallel Sort
+//
+// Stable sort from |start_| to |end_| using |_compare| comparator, spread over
+// the threads of |_pool| and the calling thread.
+//
+// The elements are split into one chunk per thread which are merge sorted
+// concurrently. The sorted chunks are then merged pairwise. Each of those
+// merges is split again by binary search so every thread has a share of the
+// merging too, including the final one.
+//
+// Small inputs aren't worth the synchronization and are sorted with
+// |merge_sort| on the calling thread.
+//
+// The calling thread waits for the tasks it gives to |_pool|, so this must not
+// be called from a task in the same pool.
+//
+// Returns false when a buffer for the elements cannot be allocated from
+// |_allocator|.
+template<typename T, typename F>
+bool parallel_sort(Concurrency::ThreadPool& _pool, Memory::Allocator& _allocator,
+  T* start_, T* end_, F&& _compare);
+
+template<typename T, typename F>
+bool parallel_sort(T* start_, T* end_, F&& _compare);
+
+namespace detail {
+  inline constexpr const Size k_parallel_sort_min_chunk = 8192;
+  inline constexpr const Size k_parallel_sort_max_chunks = 64;
+
+  // Call |_function| with [0, _count) using |_pool| and the calling thread.
+  template<typename F>
+  void parallel_for(Concurrency::ThreadPool& _pool, Size _count, F& _function) {
+    Concurrency::WaitGroup group{_count - 1};
+    for (Size i = 1; i < _count; i++) {
+      _pool.add([&_function, &group, i](int) {
+        _function(i);
+        group.signal();
+      });
+    }
+    _function(0);
+    group.wait();
+  }
+
+  template<typename T>
+  struct MergeTask {
+    T* lhs;
+    Size lhs_size;
+    T* rhs;
+    Size rhs_size;
+    T* dst;
+  };
+
+  // Split the merge of |_lhs| and |_rhs| into |dst_| into |_pieces| merges
+  // which can be done concurrently. The left half of |_lhs| and the elements
+  // of |_rhs| that are less than the middle of |_lhs| form one merge and the
+  // rest form the other, this keeps the merge stable.
+  template<typename T, typename F>
+  void split_merge(T* _lhs, Size _lhs_size, T* _rhs, Size _rhs_size, T* dst_,
+    Size _pieces, F& _compare, StaticVector<MergeTask<T>, k_parallel_sort_max_chunks>& tasks_)
+  {
+    if (_pieces <= 1 || _lhs_size == 0 || _lhs_size + _rhs_size < k_parallel_sort_min_chunk) {
+      tasks_.push_back({_lhs, _lhs_size, _rhs, _rhs_size, dst_});
+      return;
+    }
+
+    const Size lhs_split = _lhs_size / 2;
+
+    // Lower bound of the middle of |_lhs| in |_rhs|.
+    Size rhs_split = 0;
+    for (Size count = _rhs_size; count > 0; ) {
+      const Size step = count / 2;
+      if (_compare(_rhs[rhs_split + step], _lhs[lhs_split])) {
+        rhs_split += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+
+    split_merge(_lhs, lhs_split, _rhs, rhs_split, dst_, _pieces / 2,
+      _compare, tasks_);
+    split_merge(_lhs + lhs_split, _lhs_size - lhs_split, _rhs + rhs_split,
+      _rhs_size - rhs_split, dst_ + lhs_split + rhs_split, _pieces - _pieces / 2,
+      _compare, tasks_);
+  }
+} // namespace detail
+
+template<typename T, typename F>
+bool parallel_sort(Concurrency::ThreadPool& _pool, Memory::Allocator& _allocator,
+  T* start_, T* end_, F&& _compare)
+{
+  const Size size = end_ - start_;
+
+  // Use a power of two number of chunks so they can be merged in pairs.
+  Size chunks = 1;
+  while (chunks * 2 <= _pool.size() + 1
+    && chunks * 2 <= detail::k_parallel_sort_max_chunks
+    && size / (chunks * 2) >= detail::k_parallel_sort_min_chunk)
+  {
+    chunks *= 2;
+  }
+
+  if (chunks == 1) {
+    return merge_sort(_allocator, start_, end_, Utility::forward<F>(_compare));
+  }
+
+  T* buffer = detail::merge_sort_buffer(_allocator, start_, size);
+  if (RX_HINT_UNLIKELY(!buffer)) {
+    return false;
+  }
+
+  // See |merge_sort| for why the roles of the elements and buffer swap.
+  T* data = buffer;
+  T* scratch = start_;
+  if constexpr (traits::is_trivially_copyable<T>) {
+    data = start_;
+    scratch = buffer;
+  }
+
+  const auto chunk_start = [&](Size _chunk) {
+    return size * _chunk / chunks;
+  };
+
+  auto sort_chunk = [&](Size _chunk) {
+    detail::merge_sort(data, scratch, chunk_start(_chunk), chunk_start(_chunk + 1), _compare);
+  };
+  detail::parallel_for(_pool, chunks, sort_chunk);
+
+  T* src = data;
+  T* dst = scratch;
+  for (Size width = 1; width < chunks; width *= 2) {
+    StaticVector<detail::MergeTask<T>, detail::k_parallel_sort_max_chunks> tasks;
+    for (Size chunk = 0; chunk < chunks; chunk += width * 2) {
+      const Size lo = chunk_start(chunk);
+      const Size mid = chunk_start(chunk + width);
+      const Size hi = chunk_start(chunk + width * 2);
+      detail::split_merge(src + lo, mid - lo, src + mid, hi - mid, dst + lo,
+        width * 2, _compare, tasks);
+    }
+
+    auto merge_task = [&](Size _task) {
+      const auto& task = tasks[_task];
+      detail::merge(task.lhs, task.lhs_size, task.rhs, task.rhs_size, task.dst, _compare);
+    };
+    detail::parallel_for(_pool, tasks.size(), merge_task);
+
+    T* swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != data) {
+    auto move_chunk = [&](Size _chunk) {
+      for (Size i = chunk_start(_chunk); i < chunk_start(_chunk + 1); i++) {
+        data[i] = Utility::move(src[i]);
+      }
+    };
+    detail::parallel_for(_pool, chunks, move_chunk);
+  }
+
+  detail::merge_sort_buffer_release(_allocator, buffer, start_, size);
+
+  return true;
+}
+
+template<typename T, typename F>
+inline bool parallel_sort(T* start_, T* end_, F&& _compare) {
+  return parallel_sort(Concurrency::ThreadPool::instance(),
+    Memory::SystemAllocator::instance(), start_, end_, Utility::forward<F>(_compare));
+}
+
+} // namespace rx::algorithm
+
+#endif // RX_CORE_ALGORITHM_PARALLEL_SORT_H
@@ -43,6 +43,10 @@ void quick_sort(T* start_, T* end_, F&& _compare) {
       Utility::swap(*start_, *(end_ - 1));
     }
 
+    // The pivot was taken out of the middle, fill that with the element that
+    // isn't partitioned so it's place is free for the pivot afterwards.
+    *middle = Utility::move(*(end_ - 2));
+
     do {
       while (_compare(*item1, pivot)) {
         if (++item1 >= item2) {
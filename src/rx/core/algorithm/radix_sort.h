@@ -0,0 +1,148 @@
+#ifndef RX_CORE_ALGORITHM_RADIX_SORT_H
+#define RX_CORE_ALGORITHM_RADIX_SORT_H
+#include <string.h> // memcpy, memset
+
+#include "rx/core/traits/is_floating_point.h"
+#include "rx/core/traits/is_integral.h"
+#include "rx/core/traits/is_signed.h"
+#include "rx/core/traits/is_trivially_copyable.h"
+#include "rx/core/traits/remove_cvref.h"
+
+#include "rx/core/utility/forward.h"
+
+#include "rx/core/memory/system_allocator.h"
+
+#include "rx/core/hints/unlikely.h"
+
+namespace Rx::Algorithm {
+
+// # Radix Sort
+//
+// Stable LSD radix sort from |start_| to |end_| ordered by the key |_key|
+// extracts from each element. Keys may be any integer, Float32 or Float64.
+// Floats are ordered numerically with negative zero before zero, NaNs sort
+// to either end depending on their sign.
+//
+// The sort makes one pass over the elements per byte of the key, passes where
+// every key has the same byte are skipped, so small keys in large types are
+// cheap. The key is extracted on every pass and should be cheap to compute,
+// such as reading a field.
+//
+// The elements are moved with memcpy so they must be trivially copyable, use
+// a radix sort on indices or pointers for anything else.
+//
+// Returns false when a buffer for the elements cannot be allocated from
+// |_allocator|.
+template<typename T, typename F>
+bool radix_sort(Memory::Allocator& _allocator, T* start_, T* end_, F&& _key);
+
+template<typename T, typename F>
+bool radix_sort(T* start_, T* end_, F&& _key);
+
+namespace detail {
+  template<Size E>
+  struct RadixUnsigned;
+
+  template<> struct RadixUnsigned<1> { using Type = Uint8; };
+  template<> struct RadixUnsigned<2> { using Type = Uint16; };
+  template<> struct RadixUnsigned<4> { using Type = Uint32; };
+  template<> struct RadixUnsigned<8> { using Type = Uint64; };
+
+  // Map |_key| onto an unsigned integer of the same size such that unsigned
+  // comparison gives the same order as comparing the keys.
+  template<typename K>
+  inline auto radix_bits(K _key) {
+    static_assert(traits::is_integral<K> || traits::is_floating_point<K>,
+      "radix sort key must be an integer or float");
+
+    using U = typename RadixUnsigned<sizeof(K)>::Type;
+    U bits;
+    memcpy(&bits, &_key, sizeof bits);
+
+    constexpr const U k_sign = U{1} << (sizeof(U) * 8 - 1);
+    if constexpr (traits::is_floating_point<K>) {
+      // Negative floats have all bits flipped, positive just the sign bit.
+      return static_cast<U>(bits & k_sign ? ~bits : bits | k_sign);
+    } else if constexpr (traits::is_signed<K>) {
+      return static_cast<U>(bits ^ k_sign);
+    } else {
+      return bits;
+    }
+  }
+} // namespace detail
+
+template<typename T, typename F>
+bool radix_sort(Memory::Allocator& _allocator, T* start_, T* end_, F&& _key) {
+  static_assert(traits::is_trivially_copyable<T>,
+    "radix sort requires trivially copyable elements");
+
+  using K = traits::remove_cvref<decltype(_key(*start_))>;
+  static constexpr const Size k_passes = sizeof(K);
+
+  const Size size = end_ - start_;
+  if (size < 2) {
+    return true;
+  }
+
+  // Histograms of every byte of the key are built in a single pass.
+  Size counts[k_passes][256];
+  memset(counts, 0, sizeof counts);
+  for (Size i = 0; i < size; i++) {
+    const auto bits = detail::radix_bits(_key(start_[i]));
+    for (Size pass = 0; pass < k_passes; pass++) {
+      counts[pass][(bits >> (pass * 8)) & 0xff]++;
+    }
+  }
+
+  auto buffer = reinterpret_cast<T*>(_allocator.allocate(sizeof(T), size));
+  if (RX_HINT_UNLIKELY(!buffer)) {
+    return false;
+  }
+
+  T* src = start_;
+  T* dst = buffer;
+  for (Size pass = 0; pass < k_passes; pass++) {
+    Size* count = counts[pass];
+
+    // Every key has the same byte, this pass would not change the order.
+    const auto first = (detail::radix_bits(_key(src[0])) >> (pass * 8)) & 0xff;
+    if (count[first] == size) {
+      continue;
+    }
+
+    // Turn the histogram into offsets.
+    Size offset = 0;
+    for (Size i = 0; i < 256; i++) {
+      const Size n = count[i];
+      count[i] = offset;
+      offset += n;
+    }
+
+    for (Size i = 0; i < size; i++) {
+      const auto digit = (detail::radix_bits(_key(src[i])) >> (pass * 8)) & 0xff;
+      memcpy(dst + count[digit]++, src + i, sizeof(T));
+    }
+
+    T* swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  // An odd number of passes leaves the result in the buffer.
+  if (src != start_) {
+    memcpy(start_, src, sizeof(T) * size);
+  }
+
+  _allocator.deallocate(buffer);
+  return true;
+}
+
+template<typename T, typename F>
+inline bool radix_sort(T* start_, T* end_, F&& _key) {
+  return radix_sort(Memory::SystemAllocator::instance(), start_, end_,
+    Utility::forward<F>(_key));
+}
+
+} // namespace rx::algorithm
+
+#endif // RX_CORE_ALGORITHM_RADIX_SORT_H
@@ -0,0 +1,348 @@
+#include <string.h> // strlen, memcmp, memcpy
+
+#include "rx/core/atom.h"
+#include "rx/core/string.h"
+#include "rx/core/hashed_string.h"
+#include "rx/core/string_view.h"
+#include "rx/core/global.h"
+#include "rx/core/markers.h"
+
+#include "rx/core/concurrency/atomic.h"
+#include "rx/core/concurrency/cache_line.h"
+#include "rx/core/concurrency/spin_lock.h"
+#include "rx/core/concurrency/scope_lock.h"
+
+#include "rx/core/memory/tagged_allocator.h"
+#include "rx/core/memory/system_allocator.h"
+
+#include "rx/core/utility/construct.h"
+
+#include "rx/core/hints/unlikely.h"
+#include "rx/core/hints/thread.h"
+
+namespace Rx {
+
+static Global<Memory::TaggedAllocator> s_allocator{"allocators", "atoms",
+  Memory::SystemAllocator::instance(), "atoms"};
+
+// The entries of every atom are stored in chunks which are never moved, so
+// the entry of an atom can be read without a lock.
+static constexpr const Size k_chunk_bits = 12;
+static constexpr const Size k_chunk_size = 1_z << k_chunk_bits;
+static constexpr const Size k_max_chunks = 1024;
+
+// Number of shards and the size of the blocks the strings are stored in.
+static constexpr const Size k_shards = 16;
+static constexpr const Size k_block_size = 16384;
+
+struct AtomTable {
+  RX_MARK_NO_COPY(AtomTable);
+  RX_MARK_NO_MOVE(AtomTable);
+
+  AtomTable(Memory::Allocator& _allocator);
+  ~AtomTable();
+
+  struct Entry {
+    const char* data;
+    Size size;
+    Size hash;
+  };
+
+  Uint32 intern(const char* _string, Size _size, Size _hash);
+  const Entry& entry(Uint32 _id) const;
+
+private:
+  // Open addressed table of atom ids where zero is an empty slot. It's at most
+  // half full. When it grows, the previous table is kept alive until the atom
+  // table is destroyed since it may still be read without a lock.
+  struct Index {
+    Index* previous;
+    Size capacity;
+    Concurrency::Atomic<Uint32>* slots;
+  };
+
+  // Storage for the strings, strings are never freed individually.
+  struct Block {
+    Block* next;
+  };
+
+  struct ShardData {
+    Concurrency::SpinLock lock;
+    Concurrency::Atomic<Index*> index;
+    Size count RX_HINT_GUARDED_BY(lock);
+    Block* blocks RX_HINT_GUARDED_BY(lock);
+    Byte* cursor RX_HINT_GUARDED_BY(lock);
+    Size remaining RX_HINT_GUARDED_BY(lock);
+  };
+
+  // Shards are padded to the size of a cache line so that threads interning
+  // into different shards don't contend on the same line. They cannot be
+  // over-aligned since the table is stored in a Global.
+  struct Shard : ShardData {
+    Byte padding[Concurrency::k_cache_line - sizeof(ShardData) % Concurrency::k_cache_line];
+  };
+
+  Uint32 find(const Index* _index, const char* _string, Size _size, Size _hash) const;
+  Index* create_index(Size _capacity);
+  bool grow(Shard& shard_);
+  const char* store(Shard& shard_, const char* _string, Size _size);
+  Entry* allocate_entry(Uint32 _id);
+
+  Memory::Allocator& m_allocator;
+  Shard m_shards[k_shards];
+
+  Concurrency::SpinLock m_chunks_lock;
+  Concurrency::Atomic<Entry*> m_chunks[k_max_chunks];
+  Concurrency::Atomic<Uint32> m_count;
+};
+
+static Global<AtomTable> s_table{"system", "atoms", *s_allocator};
+
+// The empty string is always atom zero, it's not stored in the table.
+static const AtomTable::Entry k_empty_entry{"", 0, 0};
+
+AtomTable::AtomTable(Memory::Allocator& _allocator)
+  : m_allocator{_allocator}
+  , m_count{0}
+{
+  for (Size i = 0; i < k_shards; i++) {
+    Shard& shard = m_shards[i];
+    shard.index.store(nullptr, Concurrency::MemoryOrder::k_relaxed);
+    shard.count = 0;
+    shard.blocks = nullptr;
+    shard.cursor = nullptr;
+    shard.remaining = 0;
+  }
+
+  for (Size i = 0; i < k_max_chunks; i++) {
+    m_chunks[i].store(nullptr, Concurrency::MemoryOrder::k_relaxed);
+  }
+}
+
+AtomTable::~AtomTable() {
+  for (Size i = 0; i < k_shards; i++) {
+    Shard& shard = m_shards[i];
+    for (Index* index = shard.index.load(Concurrency::MemoryOrder::k_relaxed); index; ) {
+      Index* previous = index->previous;
+      m_allocator.deallocate(index);
+      index = previous;
+    }
+    for (Block* block = shard.blocks; block; ) {
+      Block* next = block->next;
+      m_allocator.deallocate(block);
+      block = next;
+    }
+  }
+
+  for (Size i = 0; i < k_max_chunks; i++) {
+    m_allocator.deallocate(m_chunks[i].load(Concurrency::MemoryOrder::k_relaxed));
+  }
+}
+
+const AtomTable::Entry& AtomTable::entry(Uint32 _id) const {
+  if (_id == 0) {
+    return k_empty_entry;
+  }
+  const Entry* chunk = m_chunks[_id >> k_chunk_bits].load(Concurrency::MemoryOrder::k_acquire);
+  return chunk[_id & (k_chunk_size - 1)];
+}
+
+Uint32 AtomTable::find(const Index* _index, const char* _string, Size _size, Size _hash) const {
+  if (!_index) {
+    return 0;
+  }
+
+  const Size mask = _index->capacity - 1;
+  for (Size slot = (_hash / k_shards) & mask; ; slot = (slot + 1) & mask) {
+    const Uint32 id = _index->slots[slot].load(Concurrency::MemoryOrder::k_acquire);
+    if (!id) {
+      return 0;
+    }
+
+    const Entry& check = entry(id);
+    if (check.hash == _hash && check.size == _size && !memcmp(check.data, _string, _size)) {
+      return id;
+    }
+  }
+}
+
+AtomTable::Index* AtomTable::create_index(Size _capacity) {
+  // The slots are stored immediately after the index.
+  const Size size = sizeof(Index) + sizeof(Concurrency::Atomic<Uint32>) * _capacity;
+  auto index = reinterpret_cast<Index*>(m_allocator.allocate(size));
+  if (RX_HINT_UNLIKELY(!index)) {
+    return nullptr;
+  }
+
+  index->previous = nullptr;
+  index->capacity = _capacity;
+  index->slots = reinterpret_cast<Concurrency::Atomic<Uint32>*>(index + 1);
+  for (Size i = 0; i < _capacity; i++) {
+    Utility::construct<Concurrency::Atomic<Uint32>>(index->slots + i, 0_u32);
+  }
+
+  return index;
+}
+
+bool AtomTable::grow(Shard& shard_) {
+  Index* previous = shard_.index.load(Concurrency::MemoryOrder::k_relaxed);
+  Index* index = create_index(previous ? previous->capacity * 2 : 64);
+  if (RX_HINT_UNLIKELY(!index)) {
+    return false;
+  }
+
+  if (previous) {
+    const Size mask = index->capacity - 1;
+    for (Size i = 0; i < previous->capacity; i++) {
+      const Uint32 id = previous->slots[i].load(Concurrency::MemoryOrder::k_relaxed);
+      if (!id) {
+        continue;
+      }
+      Size slot = (entry(id).hash / k_shards) & mask;
+      while (index->slots[slot].load(Concurrency::MemoryOrder::k_relaxed)) {
+        slot = (slot + 1) & mask;
+      }
+      index->slots[slot].store(id, Concurrency::MemoryOrder::k_relaxed);
+    }
+  }
+
+  // Publish the index with the slots written before it.
+  index->previous = previous;
+  shard_.index.store(index, Concurrency::MemoryOrder::k_release);
+
+  return true;
+}
+
+const char* AtomTable::store(Shard& shard_, const char* _string, Size _size) {
+  const Size size = _size + 1;
+
+  // Strings which don't fit in a block get a block of their own.
+  if (size > shard_.remaining) {
+    const Size capacity = size > k_block_size / 4 ? size : k_block_size;
+    auto block = reinterpret_cast<Block*>(m_allocator.allocate(sizeof(Block) + capacity));
+    if (RX_HINT_UNLIKELY(!block)) {
+      return nullptr;
+    }
+
+    block->next = shard_.blocks;
+    shard_.blocks = block;
+
+    if (capacity == k_block_size) {
+      shard_.cursor = reinterpret_cast<Byte*>(block + 1);
+      shard_.remaining = capacity;
+    } else {
+      auto data = reinterpret_cast<char*>(block + 1);
+      memcpy(data, _string, _size);
+      data[_size] = '\0';
+      return data;
+    }
+  }
+
+  auto data = reinterpret_cast<char*>(shard_.cursor);
+  memcpy(data, _string, _size);
+  data[_size] = '\0';
+
+  shard_.cursor += size;
+  shard_.remaining -= size;
+
+  return data;
+}
+
+AtomTable::Entry* AtomTable::allocate_entry(Uint32 _id) {
+  const Size chunk = _id >> k_chunk_bits;
+  if (RX_HINT_UNLIKELY(chunk >= k_max_chunks)) {
+    return nullptr;
+  }
+
+  Entry* entries = m_chunks[chunk].load(Concurrency::MemoryOrder::k_acquire);
+  if (RX_HINT_UNLIKELY(!entries)) {
+    Concurrency::ScopeLock lock{m_chunks_lock};
+    entries = m_chunks[chunk].load(Concurrency::MemoryOrder::k_relaxed);
+    if (!entries) {
+      entries = reinterpret_cast<Entry*>(m_allocator.allocate(sizeof(Entry), k_chunk_size));
+      if (RX_HINT_UNLIKELY(!entries)) {
+        return nullptr;
+      }
+      m_chunks[chunk].store(entries, Concurrency::MemoryOrder::k_release);
+    }
+  }
+
+  return entries + (_id & (k_chunk_size - 1));
+}
+
+Uint32 AtomTable::intern(const char* _string, Size _size, Size _hash) {
+  Shard& shard = m_shards[_hash % k_shards];
+
+  // Most strings are already interned, try without the lock first.
+  if (const Uint32 id = find(shard.index.load(Concurrency::MemoryOrder::k_acquire), _string, _size, _hash)) {
+    return id;
+  }
+
+  Concurrency::ScopeLock lock{shard.lock};
+
+  // Another thread may have interned the string before the lock was taken.
+  Index* index = shard.index.load(Concurrency::MemoryOrder::k_relaxed);
+  if (const Uint32 id = find(index, _string, _size, _hash)) {
+    return id;
+  }
+
+  if (!index || (shard.count + 1) * 2 > index->capacity) {
+    RX_ASSERT(grow(shard), "out of memory");
+    index = shard.index.load(Concurrency::MemoryOrder::k_relaxed);
+  }
+
+  const Uint32 id = m_count.fetch_add(1, Concurrency::MemoryOrder::k_relaxed) + 1;
+  Entry* entry = allocate_entry(id);
+  RX_ASSERT(entry, "too many atoms");
+
+  entry->data = store(shard, _string, _size);
+  entry->size = _size;
+  entry->hash = _hash;
+  RX_ASSERT(entry->data, "out of memory");
+
+  // Publish the atom with the entry written before it.
+  const Size mask = index->capacity - 1;
+  Size slot = (_hash / k_shards) & mask;
+  while (index->slots[slot].load(Concurrency::MemoryOrder::k_relaxed)) {
+    slot = (slot + 1) & mask;
+  }
+  index->slots[slot].store(id, Concurrency::MemoryOrder::k_release);
+  shard.count++;
+
+  return id;
+}
+
+Atom::Atom(const char* _string)
+  : Atom{_string, strlen(_string)}
+{
+}
+
+Atom::Atom(const char* _string, Size _size)
+  : m_id{_size ? s_table->intern(_string, _size, String::hash_of(_string, _size)) : 0}
+{
+}
+
+Atom::Atom(const String& _string)
+  : Atom{_string.data(), _string.size()}
+{
+}
+
+Atom::Atom(const HashedString& _string)
+  : m_id{_string.size() ? s_table->intern(_string.data(), _string.size(), _string.hash()) : 0}
+{
+}
+
+Atom::Atom(const StringView& _string)
+  : Atom{_string.data(), _string.size()}
+{
+}
+
+const char* Atom::data() const {
+  return s_table->entry(m_id).data;
+}
+
+Size Atom::size() const {
+  return s_table->entry(m_id).size;
+}
+
+} // namespace rx
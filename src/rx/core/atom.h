@@ -0,0 +1,76 @@
+#ifndef RX_CORE_ATOM_H
+#define RX_CORE_ATOM_H
+#include "rx/core/hash.h"
+
+namespace Rx {
+
+struct String;
+struct HashedString;
+struct StringView;
+
+// # Atom
+//
+// The idea behind an atom is to intern a string in a global table once and
+// refer to it by a 32-bit identifier from then on. Two atoms are equal when
+// their strings are equal, which makes comparing and hashing an atom O(1)
+// regardless of the length of the string. This makes atoms ideal keys for
+// identifiers like names which are looked up often.
+//
+// The intern table is append-only and thread-safe. It's split into shards
+// that each have their own lock for interning new strings. Finding a string
+// which is already interned, and reading the string of an atom, never lock.
+//
+// The default constructed atom is the empty string.
+//
+// The table exists for the lifetime of the "system/atoms" global. Atoms cannot
+// be constructed before it's initialized or used after it's finalized.
+//
+// 32-bit: 4 bytes
+// 64-bit: 4 bytes
+struct Atom {
+  constexpr Atom();
+  explicit Atom(const char* _string);
+  explicit Atom(const char* _string, Size _size);
+  explicit Atom(const String& _string);
+  explicit Atom(const HashedString& _string);
+  explicit Atom(const StringView& _string);
+
+  const char* data() const;
+  Size size() const;
+
+  constexpr Uint32 id() const;
+  constexpr bool is_empty() const;
+  constexpr Size hash() const;
+
+private:
+  Uint32 m_id;
+};
+
+inline constexpr Atom::Atom()
+  : m_id{0}
+{
+}
+
+inline constexpr Uint32 Atom::id() const {
+  return m_id;
+}
+
+inline constexpr bool Atom::is_empty() const {
+  return m_id == 0;
+}
+
+inline constexpr Size Atom::hash() const {
+  return Hash<Uint32>{}(m_id);
+}
+
+inline constexpr bool operator==(const Atom& _lhs, const Atom& _rhs) {
+  return _lhs.id() == _rhs.id();
+}
+
+inline constexpr bool operator!=(const Atom& _lhs, const Atom& _rhs) {
+  return _lhs.id() != _rhs.id();
+}
+
+} // namespace rx
+
+#endif // RX_CORE_ATOM_H
@@ -2,11 +2,83 @@
 
 #include "rx/core/bitset.h"
 #include "rx/core/assert.h" // RX_ASSERT
+#include "rx/core/config.h" // RX_HAS_{SSE2, AVX2}
 
 #include "rx/core/memory/system_allocator.h"
 
+#if defined(RX_HAS_AVX2)
+#include <immintrin.h> // __m256i, _mm256_*
+#endif
+
+#if defined(RX_HAS_SSE2)
+#include <emmintrin.h> // __m128i, _mm_*
+#endif
+
 namespace Rx {
 
+// Whole bitset operations, each combines two words, or two vectors of them.
+struct BitAnd {
+  static Bitset::BitType word(Bitset::BitType _lhs, Bitset::BitType _rhs) { return _lhs & _rhs; }
+#if defined(RX_HAS_AVX2)
+  static __m256i wide(__m256i _lhs, __m256i _rhs) { return _mm256_and_si256(_lhs, _rhs); }
+#endif
+#if defined(RX_HAS_SSE2)
+  static __m128i narrow(__m128i _lhs, __m128i _rhs) { return _mm_and_si128(_lhs, _rhs); }
+#endif
+};
+
+struct BitOr {
+  static Bitset::BitType word(Bitset::BitType _lhs, Bitset::BitType _rhs) { return _lhs | _rhs; }
+#if defined(RX_HAS_AVX2)
+  static __m256i wide(__m256i _lhs, __m256i _rhs) { return _mm256_or_si256(_lhs, _rhs); }
+#endif
+#if defined(RX_HAS_SSE2)
+  static __m128i narrow(__m128i _lhs, __m128i _rhs) { return _mm_or_si128(_lhs, _rhs); }
+#endif
+};
+
+struct BitXor {
+  static Bitset::BitType word(Bitset::BitType _lhs, Bitset::BitType _rhs) { return _lhs ^ _rhs; }
+#if defined(RX_HAS_AVX2)
+  static __m256i wide(__m256i _lhs, __m256i _rhs) { return _mm256_xor_si256(_lhs, _rhs); }
+#endif
+#if defined(RX_HAS_SSE2)
+  static __m128i narrow(__m128i _lhs, __m128i _rhs) { return _mm_xor_si128(_lhs, _rhs); }
+#endif
+};
+
+struct BitAndNot {
+  static Bitset::BitType word(Bitset::BitType _lhs, Bitset::BitType _rhs) { return _lhs & ~_rhs; }
+#if defined(RX_HAS_AVX2)
+  static __m256i wide(__m256i _lhs, __m256i _rhs) { return _mm256_andnot_si256(_rhs, _lhs); }
+#endif
+#if defined(RX_HAS_SSE2)
+  static __m128i narrow(__m128i _lhs, __m128i _rhs) { return _mm_andnot_si128(_rhs, _lhs); }
+#endif
+};
+
+template<typename T>
+static void combine(Bitset::BitType* lhs_, const Bitset::BitType* _rhs, Size _words) {
+  Size i = 0;
+#if defined(RX_HAS_AVX2)
+  for (; i + 4 <= _words; i += 4) {
+    auto lhs = reinterpret_cast<__m256i*>(lhs_ + i);
+    auto rhs = reinterpret_cast<const __m256i*>(_rhs + i);
+    _mm256_storeu_si256(lhs, T::wide(_mm256_loadu_si256(lhs), _mm256_loadu_si256(rhs)));
+  }
+#endif
+#if defined(RX_HAS_SSE2)
+  for (; i + 2 <= _words; i += 2) {
+    auto lhs = reinterpret_cast<__m128i*>(lhs_ + i);
+    auto rhs = reinterpret_cast<const __m128i*>(_rhs + i);
+    _mm_storeu_si128(lhs, T::narrow(_mm_loadu_si128(lhs), _mm_loadu_si128(rhs)));
+  }
+#endif
+  for (; i < _words; i++) {
+    lhs_[i] = T::word(lhs_[i], _rhs[i]);
+  }
+}
+
 Bitset::Bitset(Memory::Allocator& _allocator, Size _size)
   : m_allocator{&_allocator}
   , m_size{_size}
@@ -30,6 +102,8 @@ Bitset::Bitset(Memory::Allocator& _allocator, const Bitset& _bitset)
 Bitset& Bitset::operator=(Bitset&& bitset_) {
   RX_ASSERT(&bitset_ != this, "self assignment");
 
+  allocator().deallocate(m_data);
+
   m_allocator = &bitset_.allocator();
   m_size = Utility::exchange(bitset_.m_size, 0);
   m_data = Utility::exchange(bitset_.m_data, nullptr);
@@ -51,50 +125,182 @@ Bitset& Bitset::operator=(const Bitset& _bitset) {
   return *this;
 }
 
+Bitset& Bitset::operator&=(const Bitset& _bitset) {
+  RX_ASSERT(_bitset.m_size == m_size, "size mismatch");
+  combine<BitAnd>(m_data, _bitset.m_data, words_for_size(m_size));
+  update_summary(0, words_for_size(m_size));
+  return *this;
+}
+
+Bitset& Bitset::operator|=(const Bitset& _bitset) {
+  RX_ASSERT(_bitset.m_size == m_size, "size mismatch");
+  combine<BitOr>(m_data, _bitset.m_data, words_for_size(m_size));
+  update_summary(0, words_for_size(m_size));
+  return *this;
+}
+
+Bitset& Bitset::operator^=(const Bitset& _bitset) {
+  RX_ASSERT(_bitset.m_size == m_size, "size mismatch");
+  combine<BitXor>(m_data, _bitset.m_data, words_for_size(m_size));
+  update_summary(0, words_for_size(m_size));
+  return *this;
+}
+
+Bitset& Bitset::and_not(const Bitset& _bitset) {
+  RX_ASSERT(_bitset.m_size == m_size, "size mismatch");
+  combine<BitAndNot>(m_data, _bitset.m_data, words_for_size(m_size));
+  update_summary(0, words_for_size(m_size));
+  return *this;
+}
+
+void Bitset::set_range(Size _begin, Size _end) {
+  RX_ASSERT(_begin <= _end && _end <= m_size, "out of bounds");
+  if (_begin == _end) {
+    return;
+  }
+
+  const Size first = index(_begin);
+  const Size last = index(_end - 1);
+  const BitType head = ~BitType{0} << offset(_begin);
+  const BitType tail = ~BitType{0} >> (k_word_bits - 1 - offset(_end - 1));
+
+  if (first == last) {
+    m_data[first] |= head & tail;
+  } else {
+    m_data[first] |= head;
+    memset(m_data + first + 1, 0xff, sizeof(BitType) * (last - first - 1));
+    m_data[last] |= tail;
+  }
+
+  update_summary(first, last + 1);
+}
+
+void Bitset::clear_range(Size _begin, Size _end) {
+  RX_ASSERT(_begin <= _end && _end <= m_size, "out of bounds");
+  if (_begin == _end) {
+    return;
+  }
+
+  const Size first = index(_begin);
+  const Size last = index(_end - 1);
+  const BitType head = ~BitType{0} << offset(_begin);
+  const BitType tail = ~BitType{0} >> (k_word_bits - 1 - offset(_end - 1));
+
+  if (first == last) {
+    m_data[first] &= ~(head & tail);
+  } else {
+    m_data[first] &= ~head;
+    memset(m_data + first + 1, 0, sizeof(BitType) * (last - first - 1));
+    m_data[last] &= ~tail;
+  }
+
+  update_summary(first, last + 1);
+}
+
 void Bitset::clear_all() {
+  // Clears the summary too.
   memset(m_data, 0, bytes_for_size(m_size));
 }
 
 Size Bitset::count_set_bits() const {
+  const Size words = words_for_size(m_size);
+
   Size count = 0;
+  Size i = 0;
 
-  for (Size i = 0; i < m_size; i++) {
-    if (test(i)) {
-      count++;
-    }
+#if defined(RX_HAS_AVX2)
+  // Look up the count of every nibble in a table and sum the bytes of each
+  // word, four words at a time.
+  const __m256i table = _mm256_setr_epi8(
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  __m256i total = _mm256_setzero_si256();
+  for (; i + 4 <= words; i += 4) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_data + i));
+    const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(chunk, nibble));
+    const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(chunk, 4), nibble));
+    total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+  }
+  count += _mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1)
+         + _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3);
+#endif
+
+  for (; i < words; i++) {
+    count += bit_pop_count(m_data[i]);
   }
 
   return count;
 }
 
-Size Bitset::count_unset_bits() const {
-  Size count = 0;
+Size Bitset::find_next_set(Size _bit) const {
+  if (_bit >= m_size) {
+    return -1_z;
+  }
+
+  const Size words = words_for_size(m_size);
 
-  for (Size i = 0; i < m_size; i++) {
-    if (!test(i)) {
-      count++;
+  Size word = index(_bit);
+  BitType bits = m_data[word] & (~BitType{0} << offset(_bit));
+  while (!bits) {
+    word = next_word(any_summary(), 0, word + 1);
+    if (word == words) {
+      return -1_z;
     }
+    bits = m_data[word];
   }
 
-  return count;
+  return word * k_word_bits + bit_search_lsb(bits);
 }
 
-Size Bitset::find_first_unset() const {
-  for (Size i = 0; i < m_size; i++) {
-    if (!test(i)) {
-      return i;
+Size Bitset::find_next_unset(Size _bit) const {
+  if (_bit >= m_size) {
+    return -1_z;
+  }
+
+  const Size words = words_for_size(m_size);
+
+  Size word = index(_bit);
+  BitType bits = ~m_data[word] & (~BitType{0} << offset(_bit));
+  while (!bits) {
+    word = next_word(full_summary(), ~BitType{0}, word + 1);
+    if (word == words) {
+      return -1_z;
     }
+    bits = ~m_data[word];
+  }
+
+  // The bits beyond the size are always unset.
+  const Size bit = word * k_word_bits + bit_search_lsb(bits);
+  return bit < m_size ? bit : -1_z;
+}
+
+void Bitset::update_summary(Size _begin, Size _end) {
+  for (Size word = _begin; word < _end; word++) {
+    update_summary(word);
   }
-  return -1_z;
 }
 
-Size Bitset::find_first_set() const {
-  for (Size i = 0; i < m_size; i++) {
-    if (test(i)) {
-      return i;
+Size Bitset::next_word(const BitType* _summary, BitType _flip, Size _word) const {
+  const Size words = words_for_size(m_size);
+  if (_word >= words) {
+    return words;
+  }
+
+  const Size summary_words = summary_words_for_size(m_size);
+
+  Size i = index(_word);
+  BitType bits = (_summary[i] ^ _flip) & (~BitType{0} << offset(_word));
+  while (!bits) {
+    if (++i == summary_words) {
+      return words;
     }
+    bits = _summary[i] ^ _flip;
   }
-  return -1_z;
+
+  // The summary bits beyond the last word are unset, or set when flipped.
+  const Size word = i * k_word_bits + bit_search_lsb(bits);
+  return word < words ? word : words;
 }
 
 } // namespace rx
@@ -8,9 +8,21 @@
 #include "rx/core/memory/system_allocator.h"
 
 #include "rx/core/utility/exchange.h"
+#include "rx/core/utility/bit.h"
 
 namespace Rx {
 
+// # Bitset
+//
+// Bits are stored in words and operated on a word at a time, whole bitset
+// operations use SIMD when available.
+//
+// A summary level follows the words, with one bit per word for whether it has
+// any bit set and one for whether it has every bit set. Searches and
+// iteration scan the summary first, skipping 64 words at a time that are
+// empty, or full when looking for unset bits, so sparse or mostly full
+// bitsets are cheap to search. Bits beyond the size are always unset.
+//
 // 32-bit: 12 bytes
 // 64-bit: 24 bytes
 struct Bitset {
@@ -30,12 +42,26 @@ struct Bitset {
   Bitset& operator=(Bitset&& bitset_);
   Bitset& operator=(const Bitset& _bitset);
 
+  // the bitsets must be the same size
+  Bitset& operator&=(const Bitset& _bitset);
+  Bitset& operator|=(const Bitset& _bitset);
+  Bitset& operator^=(const Bitset& _bitset);
+
+  // clear every bit set in |_bitset|, must be the same size
+  Bitset& and_not(const Bitset& _bitset);
+
   // set |_bit|
   void set(Size _bit);
 
   // clear |_bit|
   void clear(Size _bit);
 
+  // set bits in [_begin, _end)
+  void set_range(Size _begin, Size _end);
+
+  // clear bits in [_begin, _end)
+  void clear_range(Size _begin, Size _end);
+
   // clear all bits
   void clear_all();
 
@@ -57,6 +83,12 @@ struct Bitset {
   // find the index of the first unset bit
   Size find_first_unset() const;
 
+  // find the index of the first set bit at or after |_bit|
+  Size find_next_set(Size _bit) const;
+
+  // find the index of the first unset bit at or after |_bit|
+  Size find_next_unset(Size _bit) const;
+
   // iterate bitset invoking |_function| with index of each set bit
   template<typename F>
   void each_set(F&& _function) const;
@@ -69,10 +101,25 @@ struct Bitset {
 
 private:
   static Size bytes_for_size(Size _size);
+  static Size words_for_size(Size _size);
+  static Size summary_words_for_size(Size _size);
 
   static Size index(Size bit);
   static Size offset(Size bit);
 
+  // one bit per word, set when the word has any bit set
+  BitType* any_summary() const;
+
+  // one bit per word, set when the word has every bit set
+  BitType* full_summary() const;
+
+  void update_summary(Size _word);
+  void update_summary(Size _begin, Size _end);
+
+  // index of the first word at or after |_word| with it's bit set in
+  // |_summary| after xor with |_flip|, or the number of words
+  Size next_word(const BitType* _summary, BitType _flip, Size _word) const;
+
   Memory::Allocator* m_allocator;
   Size m_size;
   BitType* m_data;
@@ -102,11 +149,13 @@ inline Bitset::~Bitset() {
 inline void Bitset::set(Size _bit) {
   RX_ASSERT(_bit < m_size, "out of bounds");
   m_data[index(_bit)] |= k_bit_one << offset(_bit);
+  update_summary(index(_bit));
 }
 
 inline void Bitset::clear(Size _bit) {
   RX_ASSERT(_bit < m_size, "out of bounds");
   m_data[index(_bit)] &= ~(k_bit_one << offset(_bit));
+  update_summary(index(_bit));
 }
 
 inline bool Bitset::test(Size _bit) const {
@@ -118,8 +167,28 @@ inline Size Bitset::size() const {
   return m_size;
 }
 
+inline Size Bitset::count_unset_bits() const {
+  return m_size - count_set_bits();
+}
+
+inline Size Bitset::find_first_set() const {
+  return find_next_set(0);
+}
+
+inline Size Bitset::find_first_unset() const {
+  return find_next_unset(0);
+}
+
 inline Size Bitset::bytes_for_size(Size _size) {
-  return sizeof(BitType) * (_size / k_word_bits + 1);
+  return sizeof(BitType) * (words_for_size(_size) + 2 * summary_words_for_size(_size));
+}
+
+inline Size Bitset::words_for_size(Size _size) {
+  return _size / k_word_bits + 1;
+}
+
+inline Size Bitset::summary_words_for_size(Size _size) {
+  return words_for_size(_size) / k_word_bits + 1;
 }
 
 inline Size Bitset::index(Size _bit) {
@@ -130,16 +199,37 @@ inline Size Bitset::offset(Size _bit) {
   return _bit % k_word_bits;
 }
 
+inline Bitset::BitType* Bitset::any_summary() const {
+  return m_data + words_for_size(m_size);
+}
+
+inline Bitset::BitType* Bitset::full_summary() const {
+  return any_summary() + summary_words_for_size(m_size);
+}
+
+inline void Bitset::update_summary(Size _word) {
+  const BitType bits = m_data[_word];
+  const BitType bit = k_bit_one << offset(_word);
+  BitType& any = any_summary()[index(_word)];
+  BitType& full = full_summary()[index(_word)];
+  any = bits ? any | bit : any & ~bit;
+  full = bits == ~BitType{0} ? full | bit : full & ~bit;
+}
+
 template<typename F>
 inline void Bitset::each_set(F&& _function) const {
-  for (Size i{0}; i < m_size; i++) {
-    if (test(i)) {
+  const Size words = words_for_size(m_size);
+  const BitType* summary = any_summary();
+  for (Size word = next_word(summary, 0, 0); word < words; word = next_word(summary, 0, word + 1)) {
+    // Iterate a copy so |_function| may change the bitset.
+    for (BitType bits = m_data[word]; bits; bits &= bits - 1) {
+      const Size bit = word * k_word_bits + bit_search_lsb(bits);
       if constexpr (traits::is_same<bool, traits::return_type<F>>) {
-        if (!_function(i)) {
+        if (!_function(bit)) {
           return;
         }
       } else {
-        _function(i);
+        _function(bit);
       }
     }
   }
@@ -147,14 +237,21 @@ inline void Bitset::each_set(F&& _function) const {
 
 template<typename F>
 inline void Bitset::each_unset(F&& _function) const {
-  for (Size i{0}; i < m_size; i++) {
-    if (!test(i)) {
+  const Size words = words_for_size(m_size);
+  const BitType* summary = full_summary();
+  const BitType flip = ~BitType{0};
+  for (Size word = next_word(summary, flip, 0); word < words; word = next_word(summary, flip, word + 1)) {
+    for (BitType bits = ~m_data[word]; bits; bits &= bits - 1) {
+      const Size bit = word * k_word_bits + bit_search_lsb(bits);
+      if (bit >= m_size) {
+        return;
+      }
       if constexpr (traits::is_same<bool, traits::return_type<F>>) {
-        if (!_function(i)) {
+        if (!_function(bit)) {
           return;
         }
       } else {
-        _function(i);
+        _function(bit);
       }
     }
   }
@@ -80,41 +80,41 @@ namespace detail {
     bool compare_exchange_weak(T& expected_, T _value, MemoryOrder _success,
       MemoryOrder _failure) volatile
     {
-      return atomic_compare_exchange_weak(&m_value, expected_, _value, _success, _failure);
+      return atomic_compare_exchange_weak(&m_value, &expected_, _value, _success, _failure);
     }
 
     bool compare_exchange_weak(T& expected_, T _value, MemoryOrder _success,
       MemoryOrder _failure)
     {
-      return atomic_compare_exchange_weak(&m_value, expected_, _value, _success, _failure);
+      return atomic_compare_exchange_weak(&m_value, &expected_, _value, _success, _failure);
     }
 
     bool compare_exchange_strong(T& expected_, T _value, MemoryOrder _success,
       MemoryOrder _failure) volatile
     {
-      return atomic_compare_exchange_strong(&m_value, expected_, _value, _success, _failure);
+      return atomic_compare_exchange_strong(&m_value, &expected_, _value, _success, _failure);
     }
 
     bool compare_exchange_strong(T& expected_, T _value, MemoryOrder _success,
       MemoryOrder _failure)
     {
-      return atomic_compare_exchange_strong(&m_value, expected_, _value, _success, _failure);
+      return atomic_compare_exchange_strong(&m_value, &expected_, _value, _success, _failure);
     }
 
     bool compare_exchange_weak(T& expected_, T _value, MemoryOrder _order = MemoryOrder::k_seq_cst) volatile {
-      return atomic_compare_exchange_weak(&m_value, expected_, _value, _order, _order);
+      return atomic_compare_exchange_weak(&m_value, &expected_, _value, _order, _order);
     }
 
     bool compare_exchange_weak(T& expected_, T _value, MemoryOrder _order = MemoryOrder::k_seq_cst) {
-      return atomic_compare_exchange_weak(&m_value, expected_, _value, _order, _order);
+      return atomic_compare_exchange_weak(&m_value, &expected_, _value, _order, _order);
     }
 
     bool compare_exchange_strong(T& expected_, T _value, MemoryOrder _order) volatile {
-      return atomic_compare_exchange_strong(&m_value, expected_, _value, _order, _order);
+      return atomic_compare_exchange_strong(&m_value, &expected_, _value, _order, _order);
     }
 
     bool compare_exchange_strong(T& expected_, T _value, MemoryOrder _order) {
-      return atomic_compare_exchange_strong(&m_value, expected_, _value, _order, _order);
+      return atomic_compare_exchange_strong(&m_value, &expected_, _value, _order, _order);
     }
 
   protected:
@@ -345,6 +345,12 @@ struct Atomic<T*> : detail::Atomic<T*> {
   }
 };
 
+// Order the memory operations around the fence by |_order| without an atomic
+// operation to attach the order to.
+inline void atomic_thread_fence(MemoryOrder _order) {
+  detail::atomic_thread_fence(_order);
+}
+
 struct AtomicFlag {
   RX_MARK_NO_COPY(AtomicFlag);
 
@@ -359,6 +365,14 @@ struct AtomicFlag {
     return detail::atomic_exchange(&m_value, true, _order);
   }
 
+  bool test(MemoryOrder _order = MemoryOrder::k_seq_cst) const volatile {
+    return detail::atomic_load(&m_value, _order);
+  }
+
+  bool test(MemoryOrder _order = MemoryOrder::k_seq_cst) const {
+    return detail::atomic_load(&m_value, _order);
+  }
+
   void clear(MemoryOrder _order = MemoryOrder::k_seq_cst) volatile {
     detail::atomic_store(&m_value, false, _order);
   }
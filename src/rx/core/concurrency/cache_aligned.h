@@ -0,0 +1,90 @@
+#ifndef RX_CORE_CONCURRENCY_CACHE_ALIGNED_H
+#define RX_CORE_CONCURRENCY_CACHE_ALIGNED_H
+#include "rx/core/markers.h"
+
+#include "rx/core/concurrency/cache_line.h"
+
+#include "rx/core/memory/allocator.h"
+
+#include "rx/core/utility/forward.h"
+
+#include "rx/core/hints/force_inline.h"
+
+namespace Rx::Concurrency {
+
+// # Cache Aligned
+//
+// Keeps a value on cache lines no other data shares, so threads writing it
+// don't contend with threads using whatever is next to it in memory.
+//
+// Since memory is only ever aligned to |Memory::Allocator::k_alignment| the
+// value is padded on both sides rather than aligned. The padding is as large
+// as the distance from any such alignment to the next cache line, which puts
+// the value past the last cache line of whatever comes before it and leaves
+// room for the first cache line of whatever comes after it to start past the
+// value.
+template<typename T>
+struct CacheAligned {
+  template<typename... Ts>
+  constexpr CacheAligned(Ts&&... _arguments);
+
+  constexpr T& get();
+  constexpr const T& get() const;
+
+  constexpr T& operator*();
+  constexpr const T& operator*() const;
+
+  constexpr T* operator->();
+  constexpr const T* operator->() const;
+
+private:
+  static inline constexpr const Size k_padding =
+    k_cache_line - Memory::Allocator::k_alignment;
+
+  Byte m_padding0[k_padding];
+  T m_value;
+  Byte m_padding1[k_padding];
+};
+
+template<typename T>
+template<typename... Ts>
+inline constexpr CacheAligned<T>::CacheAligned(Ts&&... _arguments)
+  : m_padding0{}
+  , m_value{Utility::forward<Ts>(_arguments)...}
+  , m_padding1{}
+{
+}
+
+template<typename T>
+RX_HINT_FORCE_INLINE constexpr T& CacheAligned<T>::get() {
+  return m_value;
+}
+
+template<typename T>
+RX_HINT_FORCE_INLINE constexpr const T& CacheAligned<T>::get() const {
+  return m_value;
+}
+
+template<typename T>
+RX_HINT_FORCE_INLINE constexpr T& CacheAligned<T>::operator*() {
+  return m_value;
+}
+
+template<typename T>
+RX_HINT_FORCE_INLINE constexpr const T& CacheAligned<T>::operator*() const {
+  return m_value;
+}
+
+template<typename T>
+RX_HINT_FORCE_INLINE constexpr T* CacheAligned<T>::operator->() {
+  return &m_value;
+}
+
+template<typename T>
+RX_HINT_FORCE_INLINE constexpr const T* CacheAligned<T>::operator->() const {
+  return &m_value;
+}
+
+} // namespace rx::concurrency
+
+#endif // RX_CORE_CONCURRENCY_CACHE_ALIGNED_H
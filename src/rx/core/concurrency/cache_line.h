@@ -0,0 +1,17 @@
+#ifndef RX_CORE_CONCURRENCY_CACHE_LINE_H
+#define RX_CORE_CONCURRENCY_CACHE_LINE_H
+#include "rx/core/types.h"
+
+namespace Rx::Concurrency {
+
+// Size of a cache line on every supported processor. Data written by different
+// threads should be kept at least this far apart so the threads don't contend
+// on the same line, known as false sharing.
+//
+// Most of the engine's state lives in Globals, which cannot be over-aligned,
+// so the usual approach is to pad by a cache line rather than align to one.
+inline constexpr const Size k_cache_line = 64;
+
+} // namespace rx::concurrency
+
+#endif // RX_CORE_CONCURRENCY_CACHE_LINE_H
@@ -1,13 +1,12 @@
-
 #include "rx/core/concurrency/condition_variable.h"
 #include "rx/core/concurrency/recursive_mutex.h"
 #include "rx/core/concurrency/mutex.h"
 
-#include "rx/core/config.h" // RX_PLATFORM_{POSIX,WINDOWS}
+#include "rx/core/config.h" // RX_PLATFORM_{LINUX,WINDOWS}
 #include "rx/core/abort.h"
 
-#if defined(RX_PLATFORM_POSIX)
-#include <pthread.h> // pthread_cond_t, pthread_cond_{init,destroy,wait,signal,broadcast}
+#if defined(RX_PLATFORM_LINUX)
+#include "rx/core/concurrency/futex.h"
 #elif defined(RX_PLATFORM_WINDOWS)
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
@@ -19,11 +18,8 @@
 namespace Rx::Concurrency {
 
 ConditionVariable::ConditionVariable() {
-#if defined(RX_PLATFORM_POSIX)
-  auto handle = reinterpret_cast<pthread_cond_t*>(m_cond);
-  if (pthread_cond_init(handle, nullptr) != 0) {
-    abort("ConditionVariable creation failed");
-  }
+#if defined(RX_PLATFORM_LINUX)
+  m_sequence.store(0, MemoryOrder::k_relaxed);
 #elif defined(RX_PLATFORM_WINDOWS)
   auto handle = reinterpret_cast<CONDITION_VARIABLE*>(m_cond);
   InitializeConditionVariable(handle);
@@ -31,22 +27,15 @@ ConditionVariable::ConditionVariable() {
 }
 
 ConditionVariable::~ConditionVariable() {
-#if defined(RX_PLATFORM_POSIX)
-  auto handle = reinterpret_cast<pthread_cond_t*>(m_cond);
-  if (pthread_cond_destroy(handle) != 0) {
-    abort("ConditionVariable desstruction failed");
-  }
-#endif
-  // Windows does not require destruction of CONDITION_VARIABLE.
+  // Neither the futex nor Windows CONDITION_VARIABLE require destruction.
 }
 
 void ConditionVariable::wait([[maybe_unused]] Mutex& _mutex) {
-#if defined(RX_PLATFORM_POSIX)
-  auto cond_handle = reinterpret_cast<pthread_cond_t*>(m_cond);
-  auto mutex_handle = reinterpret_cast<pthread_mutex_t*>(_mutex.m_mutex);
-  if (pthread_cond_wait(cond_handle, mutex_handle) != 0) {
-    abort("ConditionVariable wait failed on Mutex");
-  }
+#if defined(RX_PLATFORM_LINUX)
+  const Uint32 sequence = m_sequence.load(MemoryOrder::k_relaxed);
+  _mutex.unlock();
+  futex_wait(m_sequence, sequence);
+  _mutex.lock();
 #elif defined(RX_PLATFORM_WINDOWS)
   auto cond_handle = reinterpret_cast<CONDITION_VARIABLE*>(m_cond);
   auto mutex_handle = reinterpret_cast<CRITICAL_SECTION*>(_mutex.m_mutex);
@@ -57,12 +46,11 @@ void ConditionVariable::wait([[maybe_unused]] Mutex& _mutex) {
 }
 
 void ConditionVariable::wait([[maybe_unused]] RecursiveMutex& _mutex) {
-#if defined(RX_PLATFORM_POSIX)
-  auto cond_handle = reinterpret_cast<pthread_cond_t*>(m_cond);
-  auto mutex_handle = reinterpret_cast<pthread_mutex_t*>(_mutex.m_mutex);
-  if (pthread_cond_wait(cond_handle, mutex_handle) != 0) {
-    abort("ConditionVariable wait failed on RecursiveMutex");
-  }
+#if defined(RX_PLATFORM_LINUX)
+  const Uint32 sequence = m_sequence.load(MemoryOrder::k_relaxed);
+  _mutex.unlock();
+  futex_wait(m_sequence, sequence);
+  _mutex.lock();
 #elif defined(RX_PLATFORM_WINDOWS)
   auto cond_handle = reinterpret_cast<CONDITION_VARIABLE*>(m_cond);
   auto mutex_handle = reinterpret_cast<CRITICAL_SECTION*>(_mutex.m_mutex);
@@ -73,11 +61,9 @@ void ConditionVariable::wait([[maybe_unused]] RecursiveMutex& _mutex) {
 }
 
 void ConditionVariable::signal() {
-#if defined(RX_PLATFORM_POSIX)
-  auto handle = reinterpret_cast<pthread_cond_t*>(m_cond);
-  if (pthread_cond_signal(handle) != 0) {
-    abort("ConditionVariable signal failed");
-  }
+#if defined(RX_PLATFORM_LINUX)
+  m_sequence.fetch_add(1, MemoryOrder::k_relaxed);
+  futex_wake(m_sequence, 1);
 #elif defined(RX_PLATFORM_WINDOWS)
   auto handle = reinterpret_cast<CONDITION_VARIABLE*>(m_cond);
   WakeConditionVariable(handle);
@@ -85,11 +71,9 @@ void ConditionVariable::signal() {
 }
 
 void ConditionVariable::broadcast() {
-#if defined(RX_PLATFORM_POSIX)
-  auto handle = reinterpret_cast<pthread_cond_t*>(m_cond);
-  if (pthread_cond_broadcast(handle) != 0) {
-    abort("ConditionVariable broadcast failed");
-  }
+#if defined(RX_PLATFORM_LINUX)
+  m_sequence.fetch_add(1, MemoryOrder::k_relaxed);
+  futex_wake(m_sequence, 0x7fffffff);
 #elif defined(RX_PLATFORM_WINDOWS)
   auto handle = reinterpret_cast<CONDITION_VARIABLE*>(m_cond);
   WakeAllConditionVariable(handle);
@@ -1,13 +1,26 @@
 #ifndef RX_CORE_CONCURRENCY_CONDITION_VARIABLE_H
 #define RX_CORE_CONCURRENCY_CONDITION_VARIABLE_H
 #include "rx/core/types.h"
+#include "rx/core/config.h" // RX_PLATFORM_LINUX
 #include "rx/core/concurrency/scope_lock.h"
 
+#if defined(RX_PLATFORM_LINUX)
+#include "rx/core/concurrency/atomic.h"
+#endif
+
 namespace Rx::Concurrency {
 
 struct Mutex;
 struct RecursiveMutex;
 
+// # Condition Variable
+//
+// On Linux the condition variable is a futex word holding a sequence number
+// which every signal increments. A waiter reads the sequence before unlocking
+// the mutex and sleeps only if it hasn't changed since, so a signal between
+// unlocking and sleeping isn't lost. Signalling never takes a lock.
+//
+// Other platforms use the OS condition variable.
 struct ConditionVariable {
   ConditionVariable();
   ~ConditionVariable();
@@ -29,8 +42,12 @@ struct ConditionVariable {
   void broadcast();
 
 private:
+#if defined(RX_PLATFORM_LINUX)
+  Atomic<Uint32> m_sequence;
+#else
   // Fixed-capacity storage for any OS condition variable type, adjust if necessary.
   alignas(16) Byte m_cond[64];
+#endif
 };
 
 inline void ConditionVariable::wait(ScopeLock<Mutex>& _scope_lock) {
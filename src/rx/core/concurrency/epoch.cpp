@@ -0,0 +1,227 @@
+#include "rx/core/concurrency/epoch.h"
+#include "rx/core/concurrency/atomic.h"
+#include "rx/core/concurrency/cache_aligned.h"
+#include "rx/core/concurrency/spin_lock.h"
+#include "rx/core/concurrency/scope_lock.h"
+#include "rx/core/concurrency/yield.h"
+
+#include "rx/core/memory/heap_allocator.h"
+
+#include "rx/core/utility/construct.h"
+
+#include "rx/core/hints/likely.h"
+
+#include "rx/core/assert.h"
+
+namespace Rx::Concurrency {
+
+// Retire collects on its own once a thread has this many retired allocations
+// waiting, in case nothing else collects.
+static constexpr const Size k_collect_threshold = 256;
+
+struct Retired {
+  Memory::Allocator* allocator;
+  void* data;
+  Epoch::Reclaim reclaim;
+  Uint64 epoch;
+  Retired* next;
+};
+
+// Every thread that ever pinned has a record. The epoch is the global epoch
+// the thread observed shifted up by one with the low bit set while the thread
+// is pinned, or zero when it isn't.
+//
+// The memory a thread retires is kept in it's record. Only the owning thread
+// adds to the list but any thread may collect from it, the lock is almost
+// never contended.
+//
+// Records are never released since threads do not notify us when they exit, a
+// thread that is torn down leaks it's record. This is bounded by the number of
+// threads that have ever pinned or retired. Memory retired by such a thread is
+// still collected by the others.
+struct Record {
+  Record(Record* _next);
+
+  Atomic<Uint64> epoch;
+  Record* next;
+
+  SpinLock lock;
+  Retired* retired RX_HINT_GUARDED_BY(lock);
+  Size retired_count RX_HINT_GUARDED_BY(lock);
+
+  // Only touched by the owning thread.
+  Size depth;
+};
+
+Record::Record(Record* _next)
+  : epoch{0}
+  , next{_next}
+  , retired{nullptr}
+  , retired_count{0}
+  , depth{0}
+{
+}
+
+static Atomic<Uint64> g_epoch{0};
+static Atomic<Record*> g_records{nullptr};
+
+// Retired allocations not yet freed across every record, lets collect return
+// early when there's nothing to do. Every retire writes it, keep it away from
+// the epoch every pin reads.
+static CacheAligned<Atomic<Size>> g_retired_count{0_z};
+
+static thread_local Record* t_record;
+
+static Record* acquire_record() {
+  // Records are allocated on the heap allocator directly since they outlive
+  // every other allocator.
+  Byte* data = Memory::HeapAllocator::instance().allocate(sizeof(Record));
+  RX_ASSERT(data, "out of memory");
+
+  Record* head = g_records.load(MemoryOrder::k_relaxed);
+  Record* record = Utility::construct<Record>(data, head);
+  while (!g_records.compare_exchange_weak(record->next, record,
+    MemoryOrder::k_release, MemoryOrder::k_relaxed))
+  {
+    // |record->next| was updated with the current head by the failed exchange.
+  }
+
+  return t_record = record;
+}
+
+static inline Record* this_record() {
+  Record* record = t_record;
+  return RX_HINT_LIKELY(record) ? record : acquire_record();
+}
+
+// Advances the global epoch when every pinned thread has observed it.
+static bool try_advance() {
+  const Uint64 epoch = g_epoch.load(MemoryOrder::k_relaxed);
+
+  // Pairs with the fence in enter so a thread pinning concurrently either
+  // shows up as pinned here or observes everything unlinked before this.
+  atomic_thread_fence(MemoryOrder::k_seq_cst);
+
+  // Acquiring the record synchronizes with the release store the thread last
+  // pinned or unpinned with, whatever it read before that happens before any
+  // memory is freed.
+  for (Record* record = g_records.load(MemoryOrder::k_acquire); record; record = record->next) {
+    const Uint64 local = record->epoch.load(MemoryOrder::k_acquire);
+    if ((local & 1) && (local >> 1) != epoch) {
+      return false;
+    }
+  }
+
+  Uint64 expected = epoch;
+  return g_epoch.compare_exchange_strong(expected, epoch + 1,
+    MemoryOrder::k_release, MemoryOrder::k_relaxed);
+}
+
+void Epoch::enter() {
+  Record* record = this_record();
+  if (record->depth++ == 0) {
+    const Uint64 epoch = g_epoch.load(MemoryOrder::k_relaxed);
+    record->epoch.store((epoch << 1) | 1, MemoryOrder::k_release);
+    atomic_thread_fence(MemoryOrder::k_seq_cst);
+  }
+}
+
+void Epoch::leave() {
+  Record* record = t_record;
+  RX_ASSERT(record && record->depth, "not pinned");
+  if (--record->depth == 0) {
+    record->epoch.store(0, MemoryOrder::k_release);
+  }
+}
+
+void Epoch::retire(Memory::Allocator& _allocator, void* _data, Reclaim _reclaim) {
+  auto retired = reinterpret_cast<Retired*>(_allocator.allocate(sizeof(Retired)));
+  RX_ASSERT(retired, "out of memory");
+
+  retired->allocator = &_allocator;
+  retired->data = _data;
+  retired->reclaim = _reclaim;
+
+  // The epoch must be read after |_data| was unlinked.
+  atomic_thread_fence(MemoryOrder::k_seq_cst);
+  retired->epoch = g_epoch.load(MemoryOrder::k_relaxed);
+
+  Record* record = this_record();
+
+  bool should_collect = false;
+  {
+    ScopeLock lock{record->lock};
+    retired->next = record->retired;
+    record->retired = retired;
+    should_collect = ++record->retired_count >= k_collect_threshold;
+  }
+
+  g_retired_count->fetch_add(1, MemoryOrder::k_relaxed);
+
+  if (should_collect) {
+    collect();
+  }
+}
+
+Size Epoch::collect() {
+  if (g_retired_count->load(MemoryOrder::k_relaxed) == 0) {
+    return 0;
+  }
+
+  try_advance();
+
+  // Memory retired two epochs ago cannot be reachable by any pinned thread.
+  const Uint64 epoch = g_epoch.load(MemoryOrder::k_acquire);
+
+  Retired* reclaimable = nullptr;
+  Size count = 0;
+  for (Record* record = g_records.load(MemoryOrder::k_acquire); record; record = record->next) {
+    ScopeLock lock{record->lock};
+    Size removed = 0;
+    for (Retired** link = &record->retired; *link; ) {
+      Retired* retired = *link;
+      if (retired->epoch + 2 <= epoch) {
+        *link = retired->next;
+        retired->next = reclaimable;
+        reclaimable = retired;
+        removed++;
+      } else {
+        link = &retired->next;
+      }
+    }
+    record->retired_count -= removed;
+    count += removed;
+  }
+
+  if (count == 0) {
+    return 0;
+  }
+
+  g_retired_count->fetch_sub(count, MemoryOrder::k_relaxed);
+
+  // Reclaim outside the locks since destructors may retire more memory.
+  while (reclaimable) {
+    Retired* next = reclaimable->next;
+    Memory::Allocator& allocator = *reclaimable->allocator;
+    reclaimable->reclaim(allocator, reclaimable->data);
+    allocator.deallocate(reclaimable);
+    reclaimable = next;
+  }
+
+  return count;
+}
+
+void Epoch::synchronize() {
+  RX_ASSERT(!t_record || !t_record->depth, "synchronize while pinned");
+
+  const Uint64 target = g_epoch.load(MemoryOrder::k_acquire) + 2;
+  while (g_epoch.load(MemoryOrder::k_acquire) < target) {
+    if (!try_advance()) {
+      yield();
+    }
+  }
+
+  collect();
+}
+
+} // namespace rx::concurrency
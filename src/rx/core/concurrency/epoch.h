@@ -0,0 +1,92 @@
+#ifndef RX_CORE_CONCURRENCY_EPOCH_H
+#define RX_CORE_CONCURRENCY_EPOCH_H
+#include "rx/core/types.h"
+#include "rx/core/markers.h"
+
+#include "rx/core/utility/destruct.h"
+
+#include "rx/core/memory/allocator.h"
+
+namespace Rx::Concurrency {
+
+// # Epoch-Based Reclamation
+//
+// The idea behind epoch-based reclamation is to let lock-free readers keep
+// using memory a writer has already unlinked from a shared structure, since
+// the writer cannot know when the last reader is done with it. Instead of
+// freeing unlinked memory the writer retires it, and it's only freed once
+// every thread that could still be reading it has moved on.
+//
+// Readers pin the thread with a Guard for as long as they hold pointers into
+// a shared structure. Pinning records the global epoch the thread observed,
+// the global epoch only advances once every pinned thread has observed the
+// current one. Memory retired in an epoch is freed two epochs later, by then
+// no thread that was pinned when it was unlinked can still be.
+//
+// Pinning is a store to a thread-owned record and a fence, readers never
+// write shared memory. Guards nest, only the outermost one pins.
+//
+// Every thread keeps the memory it retires in a list of it's own, so retiring
+// doesn't contend with other threads. The list nodes are allocated from the
+// same allocator as the retired memory, which keeps the cost of memory waiting
+// to be freed accounted to the allocator it belongs to.
+//
+// Retired memory is freed in bulk by collect, from any thread. Nothing in the
+// engine retires memory yet so nothing collects on a schedule either, a user
+// should call collect from somewhere it reaches regularly, like a frame
+// boundary. Retire only collects on it's own when a thread has a lot of
+// memory waiting. Use synchronize to free all of it at once.
+//
+// A thread must not block on another thread while pinned, since that stops
+// the epoch from advancing and nothing is freed until it unpins.
+struct Epoch {
+  using Reclaim = void (*)(Memory::Allocator& _allocator, void* _data);
+
+  struct Guard {
+    RX_MARK_NO_COPY(Guard);
+    RX_MARK_NO_MOVE(Guard);
+
+    Guard();
+    ~Guard();
+  };
+
+  static void enter();
+  static void leave();
+
+  // Calls |_reclaim| with |_allocator| and |_data| once no thread can still be
+  // reading |_data|. Unlink |_data| from the shared structure first.
+  static void retire(Memory::Allocator& _allocator, void* _data, Reclaim _reclaim);
+
+  // Destructs and deallocates |_data| with |_allocator| once no thread can
+  // still be reading it.
+  template<typename T>
+  static void retire(Memory::Allocator& _allocator, T* _data);
+
+  // Frees the memory retired by any thread which is safe to free and returns
+  // how much that was. Never waits, cheap when nothing is retired.
+  static Size collect();
+
+  // Waits for every thread pinned at the time of the call to unpin and frees
+  // all memory retired before the call. Must not be called while pinned.
+  static void synchronize();
+};
+
+inline Epoch::Guard::Guard() {
+  enter();
+}
+
+inline Epoch::Guard::~Guard() {
+  leave();
+}
+
+template<typename T>
+inline void Epoch::retire(Memory::Allocator& _allocator, T* _data) {
+  retire(_allocator, _data, [](Memory::Allocator& _allocator, void* _data) {
+    Utility::destruct<T>(_data);
+    _allocator.deallocate(_data);
+  });
+}
+
+} // namespace rx::concurrency
+
+#endif // RX_CORE_CONCURRENCY_EPOCH_H
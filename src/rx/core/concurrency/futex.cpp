@@ -0,0 +1,26 @@
+#include "rx/core/concurrency/futex.h"
+
+#if defined(RX_PLATFORM_LINUX)
+#include <linux/futex.h> // FUTEX_{WAIT,WAKE}_PRIVATE
+#include <sys/syscall.h> // SYS_futex
+#include <unistd.h> // syscall
+
+namespace Rx::Concurrency {
+
+static_assert(sizeof(Atomic<Uint32>) == sizeof(Uint32),
+  "futex requires a word-sized atomic");
+
+void futex_wait(Atomic<Uint32>& _word, Uint32 _expected) {
+  syscall(SYS_futex, reinterpret_cast<Uint32*>(&_word), FUTEX_WAIT_PRIVATE,
+    _expected, nullptr, nullptr, 0);
+}
+
+Sint32 futex_wake(Atomic<Uint32>& _word, Sint32 _count) {
+  const auto result = syscall(SYS_futex, reinterpret_cast<Uint32*>(&_word), FUTEX_WAKE_PRIVATE,
+    _count, nullptr, nullptr, 0);
+  return result > 0 ? static_cast<Sint32>(result) : 0;
+}
+
+} // namespace rx::concurrency
+
+#endif // defined(RX_PLATFORM_LINUX)
@@ -0,0 +1,28 @@
+#ifndef RX_CORE_CONCURRENCY_FUTEX_H
+#define RX_CORE_CONCURRENCY_FUTEX_H
+#include "rx/core/config.h" // RX_PLATFORM_LINUX
+#include "rx/core/concurrency/atomic.h"
+
+#if defined(RX_PLATFORM_LINUX)
+
+namespace Rx::Concurrency {
+
+// # Futex
+//
+// Thin wrapper around the Linux futex system call. A futex lets a thread sleep
+// on a 32-bit word until another thread changes it and wakes it up, the kernel
+// is only entered when there is actually something to wait for.
+//
+// Waiting returns immediately when |_word| isn't |_expected|. It may also
+// return spuriously, so always check the word again.
+void futex_wait(Atomic<Uint32>& _word, Uint32 _expected);
+
+// Wake up to |_count| threads waiting on |_word|. Returns the number of threads
+// woken up.
+Sint32 futex_wake(Atomic<Uint32>& _word, Sint32 _count);
+
+} // namespace rx::concurrency
+
+#endif // defined(RX_PLATFORM_LINUX)
+
+#endif // RX_CORE_CONCURRENCY_FUTEX_H
@@ -0,0 +1,313 @@
+#ifndef RX_CORE_CONCURRENCY_MPMC_QUEUE_H
+#define RX_CORE_CONCURRENCY_MPMC_QUEUE_H
+#include "rx/core/assert.h"
+#include "rx/core/markers.h"
+#include "rx/core/uninitialized.h"
+
+#include "rx/core/concurrency/atomic.h"
+#include "rx/core/concurrency/cache_line.h"
+
+#include "rx/core/algorithm/min.h"
+
+#include "rx/core/utility/forward.h"
+#include "rx/core/utility/move.h"
+
+#include "rx/core/memory/system_allocator.h"
+
+#include "rx/core/hints/force_inline.h"
+
+namespace Rx::Concurrency {
+
+// # Multi-Producer Multi-Consumer Queue
+//
+// Bounded lock-free FIFO queue any number of threads can push to and pop from
+// at the same time. It's also the bounded queue to use with multiple producers
+// and a single consumer.
+//
+// The values are stored in a ring buffer with a power of two capacity where
+// every cell has a sequence number that says whether it's ready to be written
+// or read for the current lap around the ring. Producers claim cells by
+// advancing the tail and consumers by advancing the head, each on their own
+// cache line, with a single compare-and-swap. Only a thread which claimed a
+// cell touches its contents.
+//
+// Batch push and pop claim every consecutive ready cell up to the count with
+// a single compare-and-swap.
+//
+// The indices are padded by a cache line rather than aligned to one so the
+// queue can be stored anywhere, including in a Global.
+template<typename T>
+struct MPMCQueue {
+  RX_MARK_NO_COPY(MPMCQueue);
+  RX_MARK_NO_MOVE(MPMCQueue);
+
+  // The capacity is |_capacity| rounded up to a power of two.
+  MPMCQueue(Memory::Allocator& _allocator, Size _capacity);
+  MPMCQueue(Size _capacity);
+  ~MPMCQueue();
+
+  // Returns false when the queue is full.
+  template<typename... Ts>
+  bool emplace(Ts&&... _arguments);
+  bool push(const T& _value);
+  bool push(T&& value_);
+
+  // Moves as many of the |_count| values of |values_| in as fit and returns
+  // how many that was.
+  Size push(T* values_, Size _count);
+
+  // Returns false when the queue is empty.
+  bool pop(T& value_);
+
+  // Moves up to |_count| values out into |values_| and returns how many that
+  // was.
+  Size pop(T* values_, Size _count);
+
+  // Approximate when called concurrently with a push or pop.
+  Size size() const;
+  bool is_empty() const;
+
+  Size capacity() const;
+
+  constexpr Memory::Allocator& allocator() const;
+
+private:
+  // A cell with sequence |n| is ready to be written by the producer that
+  // claimed index |n| and ready to be read by the consumer that claimed
+  // index |n - 1|.
+  struct Cell {
+    Atomic<Size> sequence;
+    Uninitialized<T> value;
+  };
+
+  Memory::Allocator& m_allocator;
+  Cell* m_cells;
+  Size m_mask;
+  Byte m_padding0[k_cache_line];
+
+  Atomic<Size> m_head;
+  Byte m_padding1[k_cache_line];
+
+  Atomic<Size> m_tail;
+  Byte m_padding2[k_cache_line];
+};
+
+template<typename T>
+inline MPMCQueue<T>::MPMCQueue(Memory::Allocator& _allocator, Size _capacity)
+  : m_allocator{_allocator}
+  , m_cells{nullptr}
+  , m_mask{0}
+  , m_head{0}
+  , m_tail{0}
+{
+  Size capacity = 1;
+  while (capacity < _capacity) {
+    capacity *= 2;
+  }
+
+  m_cells = reinterpret_cast<Cell*>(allocator().allocate(sizeof(Cell), capacity));
+  RX_ASSERT(m_cells, "out of memory");
+
+  for (Size i = 0; i < capacity; i++) {
+    m_cells[i].sequence.store(i, MemoryOrder::k_relaxed);
+  }
+
+  m_mask = capacity - 1;
+}
+
+template<typename T>
+inline MPMCQueue<T>::MPMCQueue(Size _capacity)
+  : MPMCQueue{Memory::SystemAllocator::instance(), _capacity}
+{
+}
+
+template<typename T>
+inline MPMCQueue<T>::~MPMCQueue() {
+  const Size tail = m_tail.load(MemoryOrder::k_relaxed);
+  for (Size head = m_head.load(MemoryOrder::k_relaxed); head != tail; head++) {
+    m_cells[head & m_mask].value.fini();
+  }
+  allocator().deallocate(m_cells);
+}
+
+template<typename T>
+template<typename... Ts>
+inline bool MPMCQueue<T>::emplace(Ts&&... _arguments) {
+  Size tail = m_tail.load(MemoryOrder::k_relaxed);
+  for (;;) {
+    Cell& cell = m_cells[tail & m_mask];
+    const Size sequence = cell.sequence.load(MemoryOrder::k_acquire);
+    const auto difference = static_cast<PtrDiff>(sequence - tail);
+    if (difference == 0) {
+      if (m_tail.compare_exchange_weak(tail, tail + 1,
+        MemoryOrder::k_relaxed, MemoryOrder::k_relaxed))
+      {
+        cell.value.init(Utility::forward<Ts>(_arguments)...);
+        cell.sequence.store(tail + 1, MemoryOrder::k_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      // The cell still holds a value from the previous lap.
+      return false;
+    } else {
+      tail = m_tail.load(MemoryOrder::k_relaxed);
+    }
+  }
+}
+
+template<typename T>
+inline bool MPMCQueue<T>::push(const T& _value) {
+  return emplace(_value);
+}
+
+template<typename T>
+inline bool MPMCQueue<T>::push(T&& value_) {
+  return emplace(Utility::move(value_));
+}
+
+template<typename T>
+inline Size MPMCQueue<T>::push(T* values_, Size _count) {
+  if (_count == 0) {
+    return 0;
+  }
+
+  Size tail = m_tail.load(MemoryOrder::k_relaxed);
+  Size count = 0;
+  for (;;) {
+    // Cells can only stop being ready for writing once the tail passes them,
+    // so they're all still ready when the tail is claimed unchanged.
+    count = 0;
+    while (count < _count) {
+      const Cell& cell = m_cells[(tail + count) & m_mask];
+      if (cell.sequence.load(MemoryOrder::k_acquire) != tail + count) {
+        break;
+      }
+      count++;
+    }
+
+    if (count == 0) {
+      const Size sequence =
+        m_cells[tail & m_mask].sequence.load(MemoryOrder::k_acquire);
+      if (static_cast<PtrDiff>(sequence - tail) < 0) {
+        return 0;
+      }
+      tail = m_tail.load(MemoryOrder::k_relaxed);
+      continue;
+    }
+
+    if (m_tail.compare_exchange_weak(tail, tail + count,
+      MemoryOrder::k_relaxed, MemoryOrder::k_relaxed))
+    {
+      break;
+    }
+  }
+
+  for (Size i = 0; i < count; i++) {
+    Cell& cell = m_cells[(tail + i) & m_mask];
+    cell.value.init(Utility::move(values_[i]));
+    cell.sequence.store(tail + i + 1, MemoryOrder::k_release);
+  }
+
+  return count;
+}
+
+template<typename T>
+inline bool MPMCQueue<T>::pop(T& value_) {
+  Size head = m_head.load(MemoryOrder::k_relaxed);
+  for (;;) {
+    Cell& cell = m_cells[head & m_mask];
+    const Size sequence = cell.sequence.load(MemoryOrder::k_acquire);
+    const auto difference = static_cast<PtrDiff>(sequence - (head + 1));
+    if (difference == 0) {
+      if (m_head.compare_exchange_weak(head, head + 1,
+        MemoryOrder::k_relaxed, MemoryOrder::k_relaxed))
+      {
+        value_ = Utility::move(*cell.value.data());
+        cell.value.fini();
+        cell.sequence.store(head + m_mask + 1, MemoryOrder::k_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      // The cell hasn't been written this lap.
+      return false;
+    } else {
+      head = m_head.load(MemoryOrder::k_relaxed);
+    }
+  }
+}
+
+template<typename T>
+inline Size MPMCQueue<T>::pop(T* values_, Size _count) {
+  if (_count == 0) {
+    return 0;
+  }
+
+  Size head = m_head.load(MemoryOrder::k_relaxed);
+  Size count = 0;
+  for (;;) {
+    // Same as the batch push, cells stay ready for reading until the head
+    // passes them.
+    count = 0;
+    while (count < _count) {
+      const Cell& cell = m_cells[(head + count) & m_mask];
+      if (cell.sequence.load(MemoryOrder::k_acquire) != head + count + 1) {
+        break;
+      }
+      count++;
+    }
+
+    if (count == 0) {
+      const Size sequence =
+        m_cells[head & m_mask].sequence.load(MemoryOrder::k_acquire);
+      if (static_cast<PtrDiff>(sequence - (head + 1)) < 0) {
+        return 0;
+      }
+      head = m_head.load(MemoryOrder::k_relaxed);
+      continue;
+    }
+
+    if (m_head.compare_exchange_weak(head, head + count,
+      MemoryOrder::k_relaxed, MemoryOrder::k_relaxed))
+    {
+      break;
+    }
+  }
+
+  for (Size i = 0; i < count; i++) {
+    Cell& cell = m_cells[(head + i) & m_mask];
+    values_[i] = Utility::move(*cell.value.data());
+    cell.value.fini();
+    cell.sequence.store(head + i + m_mask + 1, MemoryOrder::k_release);
+  }
+
+  return count;
+}
+
+template<typename T>
+inline Size MPMCQueue<T>::size() const {
+  const Size head = m_head.load(MemoryOrder::k_relaxed);
+  const Size tail = m_tail.load(MemoryOrder::k_relaxed);
+  // Pushes and pops between the two reads can make it look over capacity or
+  // the head appear past the tail.
+  const auto size = static_cast<PtrDiff>(tail - head);
+  return size < 0 ? 0 : Algorithm::min(static_cast<Size>(size), m_mask + 1);
+}
+
+template<typename T>
+inline bool MPMCQueue<T>::is_empty() const {
+  return size() == 0;
+}
+
+template<typename T>
+inline Size MPMCQueue<T>::capacity() const {
+  return m_mask + 1;
+}
+
+template<typename T>
+RX_HINT_FORCE_INLINE constexpr Memory::Allocator& MPMCQueue<T>::allocator() const {
+  return m_allocator;
+}
+
+} // namespace rx::concurrency
+
+#endif // RX_CORE_CONCURRENCY_MPMC_QUEUE_H
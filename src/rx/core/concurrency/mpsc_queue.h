@@ -0,0 +1,229 @@
+#ifndef RX_CORE_CONCURRENCY_MPSC_QUEUE_H
+#define RX_CORE_CONCURRENCY_MPSC_QUEUE_H
+#include "rx/core/assert.h"
+#include "rx/core/markers.h"
+#include "rx/core/uninitialized.h"
+
+#include "rx/core/concurrency/atomic.h"
+#include "rx/core/concurrency/cache_line.h"
+
+#include "rx/core/utility/forward.h"
+#include "rx/core/utility/move.h"
+
+#include "rx/core/memory/system_allocator.h"
+
+#include "rx/core/hints/force_inline.h"
+#include "rx/core/hints/unlikely.h"
+
+namespace Rx::Concurrency {
+
+// # Multi-Producer Single-Consumer Queue
+//
+// Unbounded lock-free FIFO queue any number of producer threads can push to
+// and a single consumer thread pops from.
+//
+// Every value is stored in a node allocated from the queue's allocator, use a
+// pool allocator with objects of |k_node_size| to avoid the heap. The nodes
+// form a singly linked list, producers append to it by exchanging the head
+// and the consumer removes from the tail. Values from the same producer are
+// popped in the order they're pushed.
+//
+// A push is an allocation and a single exchange, a batch push links all of
+// its nodes up first and appends them with a single exchange too. Producers
+// never wait for each other or the consumer.
+//
+// The consumer can briefly see the queue as empty while a producer is between
+// its exchange and linking the node in, it only ever sees the values in
+// order.
+//
+// Popping from more than one thread at a time requires external locking.
+template<typename T>
+struct MPSCQueue {
+  RX_MARK_NO_COPY(MPSCQueue);
+  RX_MARK_NO_MOVE(MPSCQueue);
+
+private:
+  struct Node {
+    Atomic<Node*> next;
+    Uninitialized<T> value;
+  };
+
+public:
+  // Size of the allocation made for every value.
+  static constexpr const Size k_node_size = sizeof(Node);
+
+  MPSCQueue(Memory::Allocator& _allocator);
+  MPSCQueue();
+  ~MPSCQueue();
+
+  // Producer. Returns false when a node cannot be allocated.
+  template<typename... Ts>
+  bool emplace(Ts&&... _arguments);
+  bool push(const T& _value);
+  bool push(T&& value_);
+
+  // Producer. Moves the |_count| values of |values_| in and returns how many
+  // could be allocated.
+  Size push(T* values_, Size _count);
+
+  // Consumer. Returns false when the queue is empty.
+  bool pop(T& value_);
+
+  // Consumer. Moves up to |_count| values out into |values_| and returns how
+  // many that was.
+  Size pop(T* values_, Size _count);
+
+  // Consumer.
+  bool is_empty() const;
+
+  constexpr Memory::Allocator& allocator() const;
+
+private:
+  Node* create_node();
+
+  Memory::Allocator& m_allocator;
+  Byte m_padding0[k_cache_line];
+
+  // Exchanged by producers.
+  Atomic<Node*> m_head;
+  Byte m_padding1[k_cache_line];
+
+  // Owned by the consumer, the node it points to is always consumed.
+  Node* m_tail;
+  Byte m_padding2[k_cache_line];
+};
+
+template<typename T>
+inline MPSCQueue<T>::MPSCQueue(Memory::Allocator& _allocator)
+  : m_allocator{_allocator}
+  , m_head{nullptr}
+  , m_tail{nullptr}
+{
+  m_tail = create_node();
+  RX_ASSERT(m_tail, "out of memory");
+  m_head.store(m_tail, MemoryOrder::k_relaxed);
+}
+
+template<typename T>
+inline MPSCQueue<T>::MPSCQueue()
+  : MPSCQueue{Memory::SystemAllocator::instance()}
+{
+}
+
+template<typename T>
+inline MPSCQueue<T>::~MPSCQueue() {
+  Node* node = m_tail->next.load(MemoryOrder::k_relaxed);
+  allocator().deallocate(m_tail);
+  while (node) {
+    Node* next = node->next.load(MemoryOrder::k_relaxed);
+    node->value.fini();
+    allocator().deallocate(node);
+    node = next;
+  }
+}
+
+template<typename T>
+template<typename... Ts>
+inline bool MPSCQueue<T>::emplace(Ts&&... _arguments) {
+  Node* node = create_node();
+  if (RX_HINT_UNLIKELY(!node)) {
+    return false;
+  }
+
+  node->value.init(Utility::forward<Ts>(_arguments)...);
+
+  Node* prev = m_head.exchange(node, MemoryOrder::k_acq_rel);
+  prev->next.store(node, MemoryOrder::k_release);
+  return true;
+}
+
+template<typename T>
+inline bool MPSCQueue<T>::push(const T& _value) {
+  return emplace(_value);
+}
+
+template<typename T>
+inline bool MPSCQueue<T>::push(T&& value_) {
+  return emplace(Utility::move(value_));
+}
+
+template<typename T>
+inline Size MPSCQueue<T>::push(T* values_, Size _count) {
+  Node* first = nullptr;
+  Node* last = nullptr;
+  Size count = 0;
+  for (; count < _count; count++) {
+    Node* node = create_node();
+    if (RX_HINT_UNLIKELY(!node)) {
+      break;
+    }
+
+    node->value.init(Utility::move(values_[count]));
+
+    // The links are published by the release store that appends the chain.
+    if (last) {
+      last->next.store(node, MemoryOrder::k_relaxed);
+    } else {
+      first = node;
+    }
+    last = node;
+  }
+
+  if (count) {
+    Node* prev = m_head.exchange(last, MemoryOrder::k_acq_rel);
+    prev->next.store(first, MemoryOrder::k_release);
+  }
+
+  return count;
+}
+
+template<typename T>
+inline bool MPSCQueue<T>::pop(T& value_) {
+  Node* tail = m_tail;
+  Node* next = tail->next.load(MemoryOrder::k_acquire);
+  if (!next) {
+    return false;
+  }
+
+  // The popped node stays around as the consumed node the tail points to.
+  value_ = Utility::move(*next->value.data());
+  next->value.fini();
+
+  m_tail = next;
+  allocator().deallocate(tail);
+
+  return true;
+}
+
+template<typename T>
+inline Size MPSCQueue<T>::pop(T* values_, Size _count) {
+  Size count = 0;
+  while (count < _count && pop(values_[count])) {
+    count++;
+  }
+  return count;
+}
+
+template<typename T>
+inline bool MPSCQueue<T>::is_empty() const {
+  return m_tail->next.load(MemoryOrder::k_acquire) == nullptr;
+}
+
+template<typename T>
+inline typename MPSCQueue<T>::Node* MPSCQueue<T>::create_node() {
+  auto node = reinterpret_cast<Node*>(allocator().allocate(sizeof(Node)));
+  if (RX_HINT_UNLIKELY(!node)) {
+    return nullptr;
+  }
+  node->next.store(nullptr, MemoryOrder::k_relaxed);
+  return node;
+}
+
+template<typename T>
+RX_HINT_FORCE_INLINE constexpr Memory::Allocator& MPSCQueue<T>::allocator() const {
+  return m_allocator;
+}
+
+} // namespace rx::concurrency
+
+#endif // RX_CORE_CONCURRENCY_MPSC_QUEUE_H
@@ -1,11 +1,11 @@
 #include "rx/core/concurrency/mutex.h"
-#include "rx/core/config.h" // RX_PLATFORM_{POSIX,WINDOWS}
+#include "rx/core/config.h" // RX_PLATFORM_{LINUX,WINDOWS}
 #include "rx/core/abort.h"
 
-#if defined(RX_PLATFORM_POSIX)
-#include <pthread.h> // pthread_mutex_t, pthread_mutex_{init,destroy,lock,unlock}
-#include <string.h> // strerror_r
-#include <errno.h> // errno
+#if defined(RX_PLATFORM_LINUX)
+#include "rx/core/concurrency/futex.h"
+#include "rx/core/concurrency/yield.h" // relax
+#include "rx/core/hints/likely.h"
 #elif defined(RX_PLATFORM_WINDOWS)
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
@@ -16,20 +16,19 @@
 
 namespace Rx::Concurrency {
 
+#if defined(RX_PLATFORM_LINUX)
+// The states of the futex word.
+static constexpr const Uint32 k_unlocked = 0;
+static constexpr const Uint32 k_locked = 1;
+static constexpr const Uint32 k_contended = 2;
+
+// Upper bound on the pause instructions spent spinning, about a microsecond.
+static constexpr const Size k_max_spin = 256;
+#endif
+
 Mutex::Mutex() {
-#if defined(RX_PLATFORM_POSIX)
-  auto handle = reinterpret_cast<pthread_mutex_t*>(m_mutex);
-  // The default behavior is to use PTHREAD_MUTEX_DEFAULT which may or may not
-  // be PTHREAD_MUTEX_NORMAL. Here we always want a non-recursive mutex. So
-  // explicitly force the mutex type.
-  pthread_mutexattr_t attributes;
-  if (pthread_mutexattr_init(&attributes) != 0
-    || pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_NORMAL) != 0
-    || pthread_mutex_init(handle, &attributes) != 0
-    || pthread_mutexattr_destroy(&attributes) != 0)
-  {
-    abort("Mutex creation failed %s", strerror(errno));
-  }
+#if defined(RX_PLATFORM_LINUX)
+  m_state.store(k_unlocked, MemoryOrder::k_relaxed);
 #elif defined(RX_PLATFORM_WINDOWS)
   auto handle = reinterpret_cast<CRITICAL_SECTION*>(m_mutex);
   InitializeCriticalSection(handle);
@@ -37,9 +36,8 @@ Mutex::Mutex() {
 }
 
 Mutex::~Mutex() {
-#if defined(RX_PLATFORM_POSIX)
-  auto handle = reinterpret_cast<pthread_mutex_t*>(m_mutex);
-  if (pthread_mutex_destroy(handle) != 0) {
+#if defined(RX_PLATFORM_LINUX)
+  if (m_state.load(MemoryOrder::k_relaxed) != k_unlocked) {
     abort("Mutex destruction failed");
   }
 #elif defined(RX_PLATFORM_WINDOWS)
@@ -49,11 +47,14 @@ Mutex::~Mutex() {
 }
 
 void Mutex::lock() {
-#if defined(RX_PLATFORM_POSIX)
-  auto handle = reinterpret_cast<pthread_mutex_t*>(m_mutex);
-  if (pthread_mutex_lock(handle) != 0) {
-    abort("Mutex lock failed");
+#if defined(RX_PLATFORM_LINUX)
+  Uint32 state = k_unlocked;
+  if (RX_HINT_LIKELY(m_state.compare_exchange_strong(state, k_locked,
+    MemoryOrder::k_acquire, MemoryOrder::k_relaxed)))
+  {
+    return;
   }
+  lock_contended();
 #elif defined(RX_PLATFORM_WINDOWS)
   auto handle = reinterpret_cast<CRITICAL_SECTION*>(m_mutex);
   EnterCriticalSection(handle);
@@ -61,10 +62,10 @@ void Mutex::lock() {
 }
 
 void Mutex::unlock() {
-#if defined(RX_PLATFORM_POSIX)
-  auto handle = reinterpret_cast<pthread_mutex_t*>(m_mutex);
-  if (pthread_mutex_unlock(handle) != 0) {
-    abort("Mutex unlock failed");
+#if defined(RX_PLATFORM_LINUX)
+  // Only wake a thread when one may be sleeping.
+  if (m_state.exchange(k_unlocked, MemoryOrder::k_release) == k_contended) {
+    futex_wake(m_state, 1);
   }
 #elif defined(RX_PLATFORM_WINDOWS)
   auto handle = reinterpret_cast<CRITICAL_SECTION*>(m_mutex);
@@ -72,4 +73,34 @@ void Mutex::unlock() {
 #endif
 }
 
+#if defined(RX_PLATFORM_LINUX)
+void Mutex::lock_contended() {
+  // Spin while the owner holds it and nobody sleeps on it, backing off
+  // exponentially so the spinning threads don't hammer the cache line.
+  for (Size spin = 1; spin <= k_max_spin; spin *= 2) {
+    for (Size i = 0; i < spin; i++) {
+      relax();
+    }
+
+    Uint32 state = m_state.load(MemoryOrder::k_relaxed);
+    if (state == k_contended) {
+      break;
+    }
+
+    if (state == k_unlocked && m_state.compare_exchange_weak(state, k_locked,
+      MemoryOrder::k_acquire, MemoryOrder::k_relaxed))
+    {
+      return;
+    }
+  }
+
+  // Mark the mutex contended and sleep until it's unlocked. The mutex is
+  // taken as contended since there is no telling if other threads still
+  // sleep on it.
+  while (m_state.exchange(k_contended, MemoryOrder::k_acquire) != k_unlocked) {
+    futex_wait(m_state, k_contended);
+  }
+}
+#endif
+
 } // namespace rx::concurrency
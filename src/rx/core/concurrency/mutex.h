@@ -1,10 +1,28 @@
 #ifndef RX_CORE_CONCURRENCY_MUTEX_H
 #define RX_CORE_CONCURRENCY_MUTEX_H
 #include "rx/core/types.h" // Byte
+#include "rx/core/config.h" // RX_PLATFORM_LINUX
 #include "rx/core/hints/thread.h"
 
+#if defined(RX_PLATFORM_LINUX)
+#include "rx/core/concurrency/atomic.h"
+#endif
+
 namespace Rx::Concurrency {
 
+// # Mutex
+//
+// On Linux the mutex is a single futex word which is zero when unlocked, one
+// when locked and two when locked with threads waiting for it. Locking and
+// unlocking without contention is a single atomic operation and never enters
+// the kernel.
+//
+// When the mutex is contended, lock spins for a short while with exponential
+// backoff before sleeping, since most critical sections are short enough that
+// the owner releases it sooner than a sleep and wake up would take. Spinning
+// stops early once other threads are already sleeping on the mutex.
+//
+// Other platforms use the OS mutex.
 struct RX_HINT_LOCKABLE Mutex {
   Mutex();
   ~Mutex();
@@ -15,8 +33,14 @@ struct RX_HINT_LOCKABLE Mutex {
 private:
   friend struct ConditionVariable;
 
+#if defined(RX_PLATFORM_LINUX)
+  void lock_contended();
+
+  Atomic<Uint32> m_state;
+#else
   // Fixed-capacity storage for any OS mutex Type, adjust if necessary.
   alignas(16) Byte m_mutex[64];
+#endif
 };
 
 } // namespace rx::concurrency
@@ -0,0 +1,70 @@
+#include "rx/core/concurrency/per_core_counter.h"
+
+#include "rx/core/utility/construct.h"
+#include "rx/core/utility/destruct.h"
+
+#include "rx/core/hints/likely.h"
+
+#include "rx/core/assert.h"
+
+namespace Rx::Concurrency {
+
+static Atomic<Size> g_next_slot{0};
+
+// Slot index plus one, zero until the thread first adds to a counter.
+static thread_local Size t_slot;
+
+PerCoreCounter::PerCoreCounter(Memory::Allocator& _allocator)
+  : m_allocator{_allocator}
+  , m_data{nullptr}
+  , m_slots{nullptr}
+{
+  // Over allocate by a cache line so the slots can be aligned to one.
+  m_data = allocator().allocate(sizeof(Slot) * k_slots + k_cache_line);
+  RX_ASSERT(m_data, "out of memory");
+
+  const auto address = reinterpret_cast<UintPtr>(m_data);
+  const auto aligned = (address + k_cache_line - 1) & ~(k_cache_line - 1);
+  m_slots = reinterpret_cast<Slot*>(aligned);
+
+  for (Size i = 0; i < k_slots; i++) {
+    Utility::construct<Slot>(m_slots + i);
+    m_slots[i].value.store(0, MemoryOrder::k_relaxed);
+  }
+}
+
+PerCoreCounter::~PerCoreCounter() {
+  for (Size i = 0; i < k_slots; i++) {
+    Utility::destruct<Slot>(m_slots + i);
+  }
+  allocator().deallocate(m_data);
+}
+
+Size PerCoreCounter::load() const {
+  Size sum = 0;
+  for (Size i = 0; i < k_slots; i++) {
+    sum += m_slots[i].value.load(MemoryOrder::k_relaxed);
+  }
+  return sum;
+}
+
+Size PerCoreCounter::reset() {
+  Size sum = 0;
+  for (Size i = 0; i < k_slots; i++) {
+    sum += m_slots[i].value.exchange(0, MemoryOrder::k_relaxed);
+  }
+  return sum;
+}
+
+Size PerCoreCounter::slot_index() {
+  const Size slot = t_slot;
+  if (RX_HINT_LIKELY(slot)) {
+    return slot - 1;
+  }
+
+  const Size index = g_next_slot.fetch_add(1, MemoryOrder::k_relaxed) % k_slots;
+  t_slot = index + 1;
+  return index;
+}
+
+} // namespace rx::concurrency
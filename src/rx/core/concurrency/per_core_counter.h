@@ -0,0 +1,88 @@
+#ifndef RX_CORE_CONCURRENCY_PER_CORE_COUNTER_H
+#define RX_CORE_CONCURRENCY_PER_CORE_COUNTER_H
+#include "rx/core/markers.h"
+
+#include "rx/core/concurrency/atomic.h"
+#include "rx/core/concurrency/cache_line.h"
+
+#include "rx/core/memory/system_allocator.h"
+
+namespace Rx::Concurrency {
+
+// # Per-Core Counter
+//
+// A counter many threads add to at once, like statistics bumped from every
+// thread recording work. A single atomic would have every thread contend on
+// the same cache line, instead the counter is split into slots on cache lines
+// of their own and every thread adds to the slot it was assigned.
+//
+// Threads are assigned slots round-robin the first time they add to any
+// counter, so as long as there are no more threads than slots no two threads
+// share one. Reading sums every slot and is much slower than adding.
+//
+// The sum is exact for additions which happen before it's read. Additions
+// racing with a read are either counted or not, reset never loses one.
+struct PerCoreCounter {
+  RX_MARK_NO_COPY(PerCoreCounter);
+  RX_MARK_NO_MOVE(PerCoreCounter);
+
+  static inline constexpr const Size k_slots = 32;
+
+  PerCoreCounter(Memory::Allocator& _allocator);
+  PerCoreCounter();
+  ~PerCoreCounter();
+
+  void add(Size _delta);
+
+  PerCoreCounter& operator+=(Size _delta);
+  PerCoreCounter& operator++();
+
+  // Sum of every slot.
+  Size load() const;
+
+  // Sum of every slot, zeroing them.
+  Size reset();
+
+  constexpr Memory::Allocator& allocator() const;
+
+  // Index of the slot for the calling thread. Shared by everything which
+  // splits state per thread, so a thread uses the same index everywhere.
+  static Size slot_index();
+
+private:
+  struct Slot {
+    Atomic<Size> value;
+    Byte padding[k_cache_line - sizeof(Atomic<Size>)];
+  };
+
+  Memory::Allocator& m_allocator;
+  Byte* m_data;
+  Slot* m_slots;
+};
+
+inline PerCoreCounter::PerCoreCounter()
+  : PerCoreCounter{Memory::SystemAllocator::instance()}
+{
+}
+
+inline void PerCoreCounter::add(Size _delta) {
+  m_slots[slot_index()].value.fetch_add(_delta, MemoryOrder::k_relaxed);
+}
+
+inline PerCoreCounter& PerCoreCounter::operator+=(Size _delta) {
+  add(_delta);
+  return *this;
+}
+
+inline PerCoreCounter& PerCoreCounter::operator++() {
+  add(1);
+  return *this;
+}
+
+RX_HINT_FORCE_INLINE constexpr Memory::Allocator& PerCoreCounter::allocator() const {
+  return m_allocator;
+}
+
+} // namespace rx::concurrency
+
+#endif // RX_CORE_CONCURRENCY_PER_CORE_COUNTER_H
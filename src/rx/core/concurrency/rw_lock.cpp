@@ -0,0 +1,281 @@
+#include "rx/core/concurrency/rw_lock.h"
+#include "rx/core/config.h" // RX_PLATFORM_{LINUX,WINDOWS}
+#include "rx/core/abort.h"
+
+#if defined(RX_PLATFORM_LINUX)
+#include "rx/core/concurrency/futex.h"
+#include "rx/core/concurrency/yield.h" // relax
+#include "rx/core/hints/likely.h"
+#elif defined(RX_PLATFORM_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h> // SRWLOCK, {Acquire,Release}SRWLock{Shared,Exclusive}
+#else
+#error "missing RWLock implementation"
+#endif
+
+namespace Rx::Concurrency {
+
+#if defined(RX_PLATFORM_LINUX)
+// The low bits of the state count the readers holding the lock, all of them
+// set means it's write locked. The top two bits flag sleeping readers and
+// writers.
+static constexpr const Uint32 k_mask = (1_u32 << 30) - 1;
+static constexpr const Uint32 k_read_locked = 1;
+static constexpr const Uint32 k_write_locked = k_mask;
+static constexpr const Uint32 k_max_readers = k_mask - 1;
+static constexpr const Uint32 k_readers_waiting = 1_u32 << 30;
+static constexpr const Uint32 k_writers_waiting = 1_u32 << 31;
+
+// Upper bound on the pause instructions spent spinning, about a microsecond.
+static constexpr const Size k_max_spin = 256;
+
+static inline bool is_unlocked(Uint32 _state) {
+  return (_state & k_mask) == 0;
+}
+
+static inline bool is_write_locked(Uint32 _state) {
+  return (_state & k_mask) == k_write_locked;
+}
+
+static inline bool has_readers_waiting(Uint32 _state) {
+  return _state & k_readers_waiting;
+}
+
+static inline bool has_writers_waiting(Uint32 _state) {
+  return _state & k_writers_waiting;
+}
+
+// Readers are only let in while nobody waits, this is what prefers writers.
+static inline bool is_read_lockable(Uint32 _state) {
+  return (_state & k_mask) < k_max_readers
+    && !has_readers_waiting(_state)
+    && !has_writers_waiting(_state);
+}
+#endif
+
+RWLock::~RWLock() {
+#if defined(RX_PLATFORM_LINUX)
+  if (m_state.load(MemoryOrder::k_relaxed) != 0) {
+    abort("RWLock destruction failed");
+  }
+#elif defined(RX_PLATFORM_WINDOWS)
+  static_assert(sizeof(SRWLOCK) <= sizeof m_lock,
+    "too small storage for SRWLOCK");
+#endif
+}
+
+void RWLock::read_lock() {
+#if defined(RX_PLATFORM_LINUX)
+  Uint32 state = m_state.load(MemoryOrder::k_relaxed);
+  if (RX_HINT_LIKELY(is_read_lockable(state)
+    && m_state.compare_exchange_weak(state, state + k_read_locked,
+      MemoryOrder::k_acquire, MemoryOrder::k_relaxed)))
+  {
+    return;
+  }
+  read_lock_contended();
+#elif defined(RX_PLATFORM_WINDOWS)
+  auto handle = reinterpret_cast<SRWLOCK*>(m_lock);
+  AcquireSRWLockShared(handle);
+#endif
+}
+
+void RWLock::read_unlock() {
+#if defined(RX_PLATFORM_LINUX)
+  const Uint32 state = m_state.fetch_sub(k_read_locked, MemoryOrder::k_release)
+    - k_read_locked;
+
+  // Readers never sleep while only other readers hold the lock, so the last
+  // reader out only has writers to wake up.
+  if (is_unlocked(state) && has_writers_waiting(state)) {
+    wake_writer_or_readers(state);
+  }
+#elif defined(RX_PLATFORM_WINDOWS)
+  auto handle = reinterpret_cast<SRWLOCK*>(m_lock);
+  ReleaseSRWLockShared(handle);
+#endif
+}
+
+void RWLock::lock() {
+#if defined(RX_PLATFORM_LINUX)
+  Uint32 state = 0;
+  if (RX_HINT_LIKELY(m_state.compare_exchange_strong(state, k_write_locked,
+    MemoryOrder::k_acquire, MemoryOrder::k_relaxed)))
+  {
+    return;
+  }
+  lock_contended();
+#elif defined(RX_PLATFORM_WINDOWS)
+  auto handle = reinterpret_cast<SRWLOCK*>(m_lock);
+  AcquireSRWLockExclusive(handle);
+#endif
+}
+
+void RWLock::unlock() {
+#if defined(RX_PLATFORM_LINUX)
+  const Uint32 state = m_state.fetch_sub(k_write_locked, MemoryOrder::k_release)
+    - k_write_locked;
+  if (has_readers_waiting(state) || has_writers_waiting(state)) {
+    wake_writer_or_readers(state);
+  }
+#elif defined(RX_PLATFORM_WINDOWS)
+  auto handle = reinterpret_cast<SRWLOCK*>(m_lock);
+  ReleaseSRWLockExclusive(handle);
+#endif
+}
+
+#if defined(RX_PLATFORM_LINUX)
+void RWLock::read_lock_contended() {
+  Uint32 state = spin_read();
+  for (;;) {
+    if (is_read_lockable(state)) {
+      if (m_state.compare_exchange_weak(state, state + k_read_locked,
+        MemoryOrder::k_acquire, MemoryOrder::k_relaxed))
+      {
+        return;
+      }
+      continue;
+    }
+
+    if ((state & k_mask) == k_max_readers) {
+      abort("too many readers");
+    }
+
+    // Flag that a reader is about to sleep so the unlock wakes it.
+    if (!has_readers_waiting(state)) {
+      if (!m_state.compare_exchange_weak(state, state | k_readers_waiting,
+        MemoryOrder::k_relaxed, MemoryOrder::k_relaxed))
+      {
+        continue;
+      }
+    }
+
+    futex_wait(m_state, state | k_readers_waiting);
+
+    state = spin_read();
+  }
+}
+
+void RWLock::lock_contended() {
+  Uint32 state = spin_write();
+
+  // Once this writer has slept there's no telling if other writers still
+  // sleep, so it keeps the flag when it takes the lock.
+  Uint32 other_writers_waiting = 0;
+
+  for (;;) {
+    if (is_unlocked(state)) {
+      if (m_state.compare_exchange_weak(state,
+        state | k_write_locked | other_writers_waiting,
+        MemoryOrder::k_acquire, MemoryOrder::k_relaxed))
+      {
+        return;
+      }
+      continue;
+    }
+
+    // Flag that a writer is about to sleep, this also stops new readers.
+    if (!has_writers_waiting(state)) {
+      if (!m_state.compare_exchange_weak(state, state | k_writers_waiting,
+        MemoryOrder::k_relaxed, MemoryOrder::k_relaxed))
+      {
+        continue;
+      }
+    }
+
+    other_writers_waiting = k_writers_waiting;
+
+    // Read the notification counter before checking the state again, any
+    // unlock after this point changes the counter and the wait returns.
+    const Uint32 seq = m_writer_notify.load(MemoryOrder::k_acquire);
+
+    state = m_state.load(MemoryOrder::k_relaxed);
+    if (is_unlocked(state) || !has_writers_waiting(state)) {
+      continue;
+    }
+
+    futex_wait(m_writer_notify, seq);
+
+    state = spin_write();
+  }
+}
+
+void RWLock::wake_writer_or_readers(Uint32 _state) {
+  // Only writers wait, try waking one. When none was actually asleep fall
+  // through since readers may have started waiting in the meantime.
+  if (_state == k_writers_waiting) {
+    if (m_state.compare_exchange_strong(_state, 0,
+      MemoryOrder::k_relaxed, MemoryOrder::k_relaxed))
+    {
+      if (wake_writer()) {
+        return;
+      }
+      _state = 0;
+    }
+  }
+
+  // Both wait, writers go first. The readers flag is kept for the unlock by
+  // the writer, or cleared below when no writer was actually asleep.
+  if (_state == (k_readers_waiting | k_writers_waiting)) {
+    if (!m_state.compare_exchange_strong(_state, k_readers_waiting,
+      MemoryOrder::k_relaxed, MemoryOrder::k_relaxed))
+    {
+      // Something else changed the state, whoever did is responsible now.
+      return;
+    }
+    if (wake_writer()) {
+      return;
+    }
+    _state = k_readers_waiting;
+  }
+
+  // Only readers wait, wake all of them.
+  if (_state == k_readers_waiting) {
+    if (m_state.compare_exchange_strong(_state, 0,
+      MemoryOrder::k_relaxed, MemoryOrder::k_relaxed))
+    {
+      futex_wake(m_state, 0x7fffffff);
+    }
+  }
+}
+
+bool RWLock::wake_writer() {
+  m_writer_notify.fetch_add(1, MemoryOrder::k_release);
+  return futex_wake(m_writer_notify, 1) != 0;
+}
+
+Uint32 RWLock::spin_read() {
+  // Spin while a writer holds the lock and nobody sleeps on it.
+  Uint32 state = m_state.load(MemoryOrder::k_relaxed);
+  for (Size spin = 1; spin <= k_max_spin; spin *= 2) {
+    if (!is_write_locked(state) || has_readers_waiting(state)
+      || has_writers_waiting(state))
+    {
+      break;
+    }
+    for (Size i = 0; i < spin; i++) {
+      relax();
+    }
+    state = m_state.load(MemoryOrder::k_relaxed);
+  }
+  return state;
+}
+
+Uint32 RWLock::spin_write() {
+  // Spin while the lock is held and no other writer sleeps on it.
+  Uint32 state = m_state.load(MemoryOrder::k_relaxed);
+  for (Size spin = 1; spin <= k_max_spin; spin *= 2) {
+    if (is_unlocked(state) || has_writers_waiting(state)) {
+      break;
+    }
+    for (Size i = 0; i < spin; i++) {
+      relax();
+    }
+    state = m_state.load(MemoryOrder::k_relaxed);
+  }
+  return state;
+}
+#endif
+
+} // namespace rx::concurrency
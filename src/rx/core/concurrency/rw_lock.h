@@ -0,0 +1,103 @@
+#ifndef RX_CORE_CONCURRENCY_RW_LOCK_H
+#define RX_CORE_CONCURRENCY_RW_LOCK_H
+#include "rx/core/types.h" // Byte
+#include "rx/core/config.h" // RX_PLATFORM_LINUX
+#include "rx/core/markers.h"
+#include "rx/core/hints/thread.h"
+
+#if defined(RX_PLATFORM_LINUX)
+#include "rx/core/concurrency/atomic.h"
+#endif
+
+namespace Rx::Concurrency {
+
+// # Reader-Writer Lock
+//
+// The idea behind a reader-writer lock is to let any number of readers hold
+// the lock at the same time while a writer holds it alone. Data which is read
+// far more often than it's changed, such as caches and lookup tables, no
+// longer serializes every reader.
+//
+// The lock is writer-preferring: once a writer waits for the lock, new readers
+// wait behind it so a steady stream of readers cannot starve writers.
+//
+// On Linux the lock is a single futex word holding the reader count, a write
+// locked state and flags for waiting readers and writers, plus a second futex
+// word writers sleep on. Uncontended read and write locking is a single atomic
+// operation and never enters the kernel.
+//
+// Other platforms use the OS reader-writer lock.
+//
+// The lock is constant initialized so it can guard globals which are used
+// during static initialization.
+//
+// The lock is not recursive. Taking a read lock while holding the lock, even
+// for reading, can deadlock when a writer is waiting.
+struct RX_HINT_LOCKABLE RWLock {
+  RX_MARK_NO_COPY(RWLock);
+  RX_MARK_NO_MOVE(RWLock);
+
+  constexpr RWLock();
+  ~RWLock();
+
+  void read_lock() RX_HINT_ACQUIRE_SHARED();
+  void read_unlock() RX_HINT_RELEASE();
+
+  // Exclusive locking is spelled lock and unlock so ScopeLock works with it.
+  void lock() RX_HINT_ACQUIRE();
+  void unlock() RX_HINT_RELEASE();
+
+private:
+#if defined(RX_PLATFORM_LINUX)
+  void read_lock_contended();
+  void lock_contended();
+  void wake_writer_or_readers(Uint32 _state);
+  bool wake_writer();
+
+  Uint32 spin_read();
+  Uint32 spin_write();
+
+  Atomic<Uint32> m_state;
+  Atomic<Uint32> m_writer_notify;
+#else
+  // Fixed-capacity storage for any OS reader-writer lock Type, adjust if
+  // necessary.
+  alignas(16) Byte m_lock[16];
+#endif
+};
+
+inline constexpr RWLock::RWLock()
+#if defined(RX_PLATFORM_LINUX)
+  : m_state{0}
+  , m_writer_notify{0}
+#else
+  // An all zero SRWLOCK is unlocked, same as SRWLOCK_INIT.
+  : m_lock{}
+#endif
+{
+}
+
+// generic scoped read lock
+template<typename T>
+struct ScopeReadLock {
+  explicit constexpr ScopeReadLock(T& lock_);
+  ~ScopeReadLock();
+private:
+  T& m_lock;
+};
+
+template<typename T>
+inline constexpr ScopeReadLock<T>::ScopeReadLock(T& lock_)
+  : m_lock{lock_}
+{
+  m_lock.read_lock();
+}
+
+template<typename T>
+inline ScopeReadLock<T>::~ScopeReadLock() {
+  m_lock.read_unlock();
+}
+
+} // namespace rx::concurrency
+
+#endif // RX_CORE_CONCURRENCY_RW_LOCK_H
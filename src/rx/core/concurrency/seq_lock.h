@@ -0,0 +1,123 @@
+#ifndef RX_CORE_CONCURRENCY_SEQ_LOCK_H
+#define RX_CORE_CONCURRENCY_SEQ_LOCK_H
+#include <string.h> // memcpy
+
+#include "rx/core/markers.h"
+
+#include "rx/core/concurrency/atomic.h"
+#include "rx/core/concurrency/yield.h" // relax
+
+#include "rx/core/traits/is_trivially_copyable.h"
+
+namespace Rx::Concurrency {
+
+// # Sequence Lock
+//
+// The idea behind a sequence lock is to publish a small value to many readers
+// without readers ever writing to shared memory. A reader copies the value
+// and checks a sequence number that every store increments twice, once before
+// and once after writing. When the sequence changed or was odd the copy may
+// be torn and the reader tries again.
+//
+// Readers never block writers and never contend with each other, which makes
+// this a good fit for small snapshots that are read often and written rarely,
+// like per frame statistics. Readers spin while a store is in progress, so
+// the value should be small and stores short.
+//
+// Stores may come from any number of threads, they're serialized on the
+// sequence number.
+//
+// The value is kept as relaxed atomic words so that the racing copies are well
+// defined, which requires |T| to be trivially copyable.
+template<typename T>
+struct SeqLock {
+  RX_MARK_NO_COPY(SeqLock);
+  RX_MARK_NO_MOVE(SeqLock);
+
+  static_assert(traits::is_trivially_copyable<T>,
+    "SeqLock requires a trivially copyable type");
+
+  SeqLock();
+  SeqLock(const T& _value);
+
+  T load() const;
+  void store(const T& _value);
+
+private:
+  static constexpr const Size k_words = (sizeof(T) + sizeof(Size) - 1) / sizeof(Size);
+
+  void write(const T& _value);
+
+  Atomic<Size> m_sequence;
+  Atomic<Size> m_data[k_words];
+};
+
+template<typename T>
+inline SeqLock<T>::SeqLock()
+  : SeqLock{T{}}
+{
+}
+
+template<typename T>
+inline SeqLock<T>::SeqLock(const T& _value)
+  : m_sequence{0}
+{
+  write(_value);
+}
+
+template<typename T>
+inline T SeqLock<T>::load() const {
+  Size words[k_words];
+  for (;;) {
+    const Size sequence = m_sequence.load(MemoryOrder::k_acquire);
+    if (sequence & 1) {
+      relax();
+      continue;
+    }
+
+    // The acquire loads keep the second read of the sequence after the copy.
+    // When the copy sees part of a store it also sees the store's odd sequence.
+    for (Size i = 0; i < k_words; i++) {
+      words[i] = m_data[i].load(MemoryOrder::k_acquire);
+    }
+
+    if (m_sequence.load(MemoryOrder::k_relaxed) == sequence) {
+      break;
+    }
+  }
+
+  T result;
+  memcpy(&result, words, sizeof result);
+  return result;
+}
+
+template<typename T>
+inline void SeqLock<T>::store(const T& _value) {
+  // Take the sequence from even to odd, waiting out any other store.
+  Size sequence = m_sequence.load(MemoryOrder::k_relaxed);
+  while ((sequence & 1) || !m_sequence.compare_exchange_weak(sequence,
+    sequence + 1, MemoryOrder::k_acquire, MemoryOrder::k_relaxed))
+  {
+    relax();
+    sequence = m_sequence.load(MemoryOrder::k_relaxed);
+  }
+
+  write(_value);
+
+  m_sequence.store(sequence + 2, MemoryOrder::k_release);
+}
+
+template<typename T>
+inline void SeqLock<T>::write(const T& _value) {
+  Size words[k_words] = {};
+  memcpy(words, &_value, sizeof _value);
+
+  // The release stores keep the odd sequence before the copy.
+  for (Size i = 0; i < k_words; i++) {
+    m_data[i].store(words[i], MemoryOrder::k_release);
+  }
+}
+
+} // namespace rx::concurrency
+
+#endif // RX_CORE_CONCURRENCY_SEQ_LOCK_H
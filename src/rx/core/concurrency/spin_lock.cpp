@@ -1,5 +1,5 @@
 #include "rx/core/concurrency/spin_lock.h" // SpinLock
-#include "rx/core/concurrency/yield.h" // yield
+#include "rx/core/concurrency/yield.h" // yield, relax
 
 // ThreadSanitizer annotations
 #if defined(RX_TSAN)
@@ -17,6 +17,10 @@ extern "C"
 
 namespace Rx::Concurrency {
 
+// Upper bound on the pause instructions between attempts, after which the
+// thread yields instead.
+static constexpr const Size k_max_backoff = 1024;
+
 void SpinLock::lock() {
   tsan_acquire(&m_lock);
 
@@ -25,18 +29,33 @@ void SpinLock::lock() {
     return;
   }
 
-  // fixed busy loop
-  int count{100};
-  while (count--) {
+  // Wait for the lock to look free before trying to take it again, reading
+  // doesn't take the cache line away from the owner like test_and_set does.
+  // The wait between reads grows exponentially to reduce contention.
+  for (Size backoff = 1; ; ) {
+    while (m_lock.test(MemoryOrder::k_relaxed)) {
+      if (backoff < k_max_backoff) {
+        for (Size i = 0; i < backoff; i++) {
+          relax();
+        }
+        backoff *= 2;
+      } else {
+        yield();
+      }
+    }
+
     if (!m_lock.test_and_set(MemoryOrder::k_acquire)) {
       return;
     }
   }
+}
 
-  // blocking loop
-  while (m_lock.test_and_set(MemoryOrder::k_acquire)) {
-    yield();
+bool SpinLock::try_lock() {
+  if (m_lock.test_and_set(MemoryOrder::k_acquire)) {
+    return false;
   }
+  tsan_acquire(&m_lock);
+  return true;
 }
 
 void SpinLock::unlock() {
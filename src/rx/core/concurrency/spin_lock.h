@@ -9,6 +9,7 @@ struct RX_HINT_LOCKABLE SpinLock {
   constexpr SpinLock();
   ~SpinLock() = default;
   void lock() RX_HINT_ACQUIRE();
+  bool try_lock();
   void unlock() RX_HINT_RELEASE();
 private:
   AtomicFlag m_lock;
@@ -0,0 +1,238 @@
+#ifndef RX_CORE_CONCURRENCY_SPSC_QUEUE_H
+#define RX_CORE_CONCURRENCY_SPSC_QUEUE_H
+#include "rx/core/assert.h"
+#include "rx/core/markers.h"
+
+#include "rx/core/concurrency/atomic.h"
+#include "rx/core/concurrency/cache_line.h"
+
+#include "rx/core/algorithm/min.h"
+
+#include "rx/core/utility/construct.h"
+#include "rx/core/utility/destruct.h"
+#include "rx/core/utility/forward.h"
+#include "rx/core/utility/move.h"
+
+#include "rx/core/memory/system_allocator.h"
+
+#include "rx/core/hints/force_inline.h"
+
+namespace Rx::Concurrency {
+
+// # Single-Producer Single-Consumer Queue
+//
+// Bounded lock-free FIFO queue for handing values from exactly one producer
+// thread to exactly one consumer thread.
+//
+// The values are stored in a ring buffer with a power of two capacity. The
+// producer only writes the tail and the consumer only writes the head, each
+// on their own cache line. Both sides keep a cached copy of the other side's
+// index and only read the shared one when the cached copy says the queue is
+// full or empty, so in the steady state neither side touches the other's
+// cache line.
+//
+// Batch push and pop publish any number of values with a single store.
+//
+// The indices are padded by a cache line rather than aligned to one so the
+// queue can be stored anywhere, including in a Global.
+template<typename T>
+struct SPSCQueue {
+  RX_MARK_NO_COPY(SPSCQueue);
+  RX_MARK_NO_MOVE(SPSCQueue);
+
+  // The capacity is |_capacity| rounded up to a power of two.
+  SPSCQueue(Memory::Allocator& _allocator, Size _capacity);
+  SPSCQueue(Size _capacity);
+  ~SPSCQueue();
+
+  // Producer. Returns false when the queue is full.
+  template<typename... Ts>
+  bool emplace(Ts&&... _arguments);
+  bool push(const T& _value);
+  bool push(T&& value_);
+
+  // Producer. Moves as many of the |_count| values of |values_| in as fit and
+  // returns how many that was.
+  Size push(T* values_, Size _count);
+
+  // Consumer. Returns false when the queue is empty.
+  bool pop(T& value_);
+
+  // Consumer. Moves up to |_count| values out into |values_| and returns how
+  // many that was.
+  Size pop(T* values_, Size _count);
+
+  // Approximate when called concurrently with a push or pop.
+  Size size() const;
+  bool is_empty() const;
+
+  Size capacity() const;
+
+  constexpr Memory::Allocator& allocator() const;
+
+private:
+  Memory::Allocator& m_allocator;
+  T* m_data;
+  Size m_mask;
+  Byte m_padding0[k_cache_line];
+
+  // Written by the consumer.
+  Atomic<Size> m_head;
+  Size m_tail_cache;
+  Byte m_padding1[k_cache_line];
+
+  // Written by the producer.
+  Atomic<Size> m_tail;
+  Size m_head_cache;
+  Byte m_padding2[k_cache_line];
+};
+
+template<typename T>
+inline SPSCQueue<T>::SPSCQueue(Memory::Allocator& _allocator, Size _capacity)
+  : m_allocator{_allocator}
+  , m_data{nullptr}
+  , m_mask{0}
+  , m_head{0}
+  , m_tail_cache{0}
+  , m_tail{0}
+  , m_head_cache{0}
+{
+  Size capacity = 1;
+  while (capacity < _capacity) {
+    capacity *= 2;
+  }
+
+  m_data = reinterpret_cast<T*>(allocator().allocate(sizeof(T), capacity));
+  RX_ASSERT(m_data, "out of memory");
+
+  m_mask = capacity - 1;
+}
+
+template<typename T>
+inline SPSCQueue<T>::SPSCQueue(Size _capacity)
+  : SPSCQueue{Memory::SystemAllocator::instance(), _capacity}
+{
+}
+
+template<typename T>
+inline SPSCQueue<T>::~SPSCQueue() {
+  const Size tail = m_tail.load(MemoryOrder::k_relaxed);
+  for (Size head = m_head.load(MemoryOrder::k_relaxed); head != tail; head++) {
+    Utility::destruct<T>(m_data + (head & m_mask));
+  }
+  allocator().deallocate(m_data);
+}
+
+template<typename T>
+template<typename... Ts>
+inline bool SPSCQueue<T>::emplace(Ts&&... _arguments) {
+  const Size tail = m_tail.load(MemoryOrder::k_relaxed);
+  if (tail - m_head_cache > m_mask) {
+    m_head_cache = m_head.load(MemoryOrder::k_acquire);
+    if (tail - m_head_cache > m_mask) {
+      return false;
+    }
+  }
+
+  Utility::construct<T>(m_data + (tail & m_mask),
+    Utility::forward<Ts>(_arguments)...);
+
+  m_tail.store(tail + 1, MemoryOrder::k_release);
+  return true;
+}
+
+template<typename T>
+inline bool SPSCQueue<T>::push(const T& _value) {
+  return emplace(_value);
+}
+
+template<typename T>
+inline bool SPSCQueue<T>::push(T&& value_) {
+  return emplace(Utility::move(value_));
+}
+
+template<typename T>
+inline Size SPSCQueue<T>::push(T* values_, Size _count) {
+  const Size tail = m_tail.load(MemoryOrder::k_relaxed);
+  if (m_mask + 1 - (tail - m_head_cache) < _count) {
+    m_head_cache = m_head.load(MemoryOrder::k_acquire);
+  }
+
+  const Size count = Algorithm::min(_count, m_mask + 1 - (tail - m_head_cache));
+  for (Size i = 0; i < count; i++) {
+    Utility::construct<T>(m_data + ((tail + i) & m_mask),
+      Utility::move(values_[i]));
+  }
+
+  if (count) {
+    m_tail.store(tail + count, MemoryOrder::k_release);
+  }
+
+  return count;
+}
+
+template<typename T>
+inline bool SPSCQueue<T>::pop(T& value_) {
+  const Size head = m_head.load(MemoryOrder::k_relaxed);
+  if (head == m_tail_cache) {
+    m_tail_cache = m_tail.load(MemoryOrder::k_acquire);
+    if (head == m_tail_cache) {
+      return false;
+    }
+  }
+
+  T* slot = m_data + (head & m_mask);
+  value_ = Utility::move(*slot);
+  Utility::destruct<T>(slot);
+
+  m_head.store(head + 1, MemoryOrder::k_release);
+  return true;
+}
+
+template<typename T>
+inline Size SPSCQueue<T>::pop(T* values_, Size _count) {
+  const Size head = m_head.load(MemoryOrder::k_relaxed);
+  if (m_tail_cache - head < _count) {
+    m_tail_cache = m_tail.load(MemoryOrder::k_acquire);
+  }
+
+  const Size count = Algorithm::min(_count, m_tail_cache - head);
+  for (Size i = 0; i < count; i++) {
+    T* slot = m_data + ((head + i) & m_mask);
+    values_[i] = Utility::move(*slot);
+    Utility::destruct<T>(slot);
+  }
+
+  if (count) {
+    m_head.store(head + count, MemoryOrder::k_release);
+  }
+
+  return count;
+}
+
+template<typename T>
+inline Size SPSCQueue<T>::size() const {
+  const Size head = m_head.load(MemoryOrder::k_relaxed);
+  const Size tail = m_tail.load(MemoryOrder::k_relaxed);
+  // Pushes and pops between the two reads can make it look over capacity.
+  return Algorithm::min(tail - head, m_mask + 1);
+}
+
+template<typename T>
+inline bool SPSCQueue<T>::is_empty() const {
+  return size() == 0;
+}
+
+template<typename T>
+inline Size SPSCQueue<T>::capacity() const {
+  return m_mask + 1;
+}
+
+template<typename T>
+RX_HINT_FORCE_INLINE constexpr Memory::Allocator& SPSCQueue<T>::allocator() const {
+  return m_allocator;
+}
+
+} // namespace rx::concurrency
+
+#endif // RX_CORE_CONCURRENCY_SPSC_QUEUE_H
@@ -5,6 +5,7 @@
 #include "rx/core/time/delay.h"
 
 #include "rx/core/log.h"
+#include "rx/core/assert.h"
 
 namespace Rx::Concurrency {
 
@@ -12,24 +13,15 @@ RX_LOG("ThreadPool", logger);
 
 Global<ThreadPool> ThreadPool::s_instance{"system", "thread_pool", 4_z, 4096_z};
 
-struct Work {
-  RX_MARK_NO_COPY(Work);
-  RX_MARK_NO_MOVE(Work);
-
-  Work(Function<void(int)>&& callback_)
-    : callback{Utility::move(callback_)}
-  {
-  }
-
-  IntrusiveList::Node link;
-  Function<void(int)> callback;
-};
-
-ThreadPool::ThreadPool(Memory::Allocator& _allocator, Size _threads, Size _static_pool_size)
+ThreadPool::ThreadPool(Memory::Allocator& _allocator, Size _threads, Size _queue_size)
   : m_allocator{_allocator}
+  , m_queue{allocator(), _queue_size}
+  , m_overflow{allocator()}
+  , m_overflow_size{0}
+  , m_sleeping{0}
   , m_threads{allocator()}
-  , m_job_memory{allocator(), sizeof(Work), _static_pool_size}
   , m_stop{false}
+  , m_size{_threads}
 {
   Time::StopWatch timer;
   timer.start();
@@ -46,20 +38,22 @@ ThreadPool::ThreadPool(Memory::Allocator& _allocator, Size _threads, Size _stati
 
       for (;;) {
         Function<void(int)> task;
-        {
+        if (!pop(task)) {
           ScopeLock lock{m_mutex};
-          m_task_cond.wait(lock, [this] { return m_stop || !m_queue.is_empty(); });
-          if (m_stop && m_queue.is_empty()) {
-            logger->info("stopping thread %d", _thread_id);
-            return;
-          }
 
-          auto node = m_queue.pop_back();
-          auto item = node->data<Work>(&Work::link);
+          // Announce the sleep before looking at the queue again. Either this
+          // sees a task added since, or |add| sees this thread sleeping.
+          m_sleeping.fetch_add(1, MemoryOrder::k_seq_cst);
+          atomic_thread_fence(MemoryOrder::k_seq_cst);
 
-          task = Utility::move(item->callback);
+          m_task_cond.wait(lock, [&] { return pop(task) || m_stop; });
+          m_sleeping.fetch_sub(1, MemoryOrder::k_relaxed);
 
-          m_job_memory.destroy(item);
+          // Stopped with nothing left to do.
+          if (!task) {
+            logger->info("stopping thread %d", _thread_id);
+            return;
+          }
         }
 
         logger->verbose("starting task on thread %d", _thread_id);
@@ -102,12 +96,38 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::add(Function<void(int)>&& task_) {
-  {
+  // The task is only moved from when there's room for it.
+  if (!m_queue.push(Utility::move(task_))) {
+    const bool pushed = m_overflow.push(Utility::move(task_));
+    RX_ASSERT(pushed, "out of memory");
+    m_overflow_size.fetch_add(1, MemoryOrder::k_release);
+  }
+
+  // Only wake a thread when one may be sleeping. Taking the lock makes sure
+  // it's either waiting already or yet to look at the queue.
+  atomic_thread_fence(MemoryOrder::k_seq_cst);
+  if (m_sleeping.load(MemoryOrder::k_relaxed) != 0) {
     ScopeLock lock{m_mutex};
-    auto item = m_job_memory.create<Work>(Utility::move(task_));
-    m_queue.push_back(&item->link);
+    m_task_cond.signal();
+  }
+}
+
+bool ThreadPool::pop(Function<void(int)>& task_) {
+  if (m_queue.pop(task_)) {
+    return true;
+  }
+
+  // The overflow queue is almost always empty, don't touch the lock then.
+  if (m_overflow_size.load(MemoryOrder::k_acquire) == 0) {
+    return false;
+  }
+
+  ScopeLock lock{m_overflow_lock};
+  if (!m_overflow.pop(task_)) {
+    return false;
   }
-  m_task_cond.signal();
+  m_overflow_size.fetch_sub(1, MemoryOrder::k_relaxed);
+  return true;
 }
 
 } // namespace rx::concurrency
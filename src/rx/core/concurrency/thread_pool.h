@@ -1,51 +1,82 @@
 #ifndef RX_CORE_CONCURRENCY_THREAD_POOL_H
 #define RX_CORE_CONCURRENCY_THREAD_POOL_H
-#include "rx/core/intrusive_list.h"
 #include "rx/core/function.h"
-#include "rx/core/dynamic_pool.h"
+#include "rx/core/vector.h"
 
 #include "rx/core/concurrency/thread.h"
 #include "rx/core/concurrency/mutex.h"
 #include "rx/core/concurrency/condition_variable.h"
+#include "rx/core/concurrency/atomic.h"
+#include "rx/core/concurrency/spin_lock.h"
+#include "rx/core/concurrency/mpmc_queue.h"
+#include "rx/core/concurrency/mpsc_queue.h"
 
 namespace Rx::Concurrency {
 
+// Tasks are handed to the threads through a lock-free queue holding up to
+// |_queue_size| tasks. Threads only take the lock to go to sleep when the queue
+// is empty and adding a task only takes it to wake a sleeping thread.
+//
+// Tasks added while the queue is full go to an unbounded overflow queue which
+// the threads drain under a spin lock, so adding never waits. This matters for
+// tasks which add more tasks, waiting for room from inside the pool could
+// deadlock it.
 struct ThreadPool {
   RX_MARK_NO_COPY(ThreadPool);
   RX_MARK_NO_MOVE(ThreadPool);
 
-  ThreadPool(Memory::Allocator& _allocator, Size _threads, Size _static_pool_size);
-  ThreadPool(Size _threads, Size _job_pool_size);
+  ThreadPool(Memory::Allocator& _allocator, Size _threads, Size _queue_size);
+  ThreadPool(Size _threads, Size _queue_size);
   ~ThreadPool();
 
   // insert |_task| into the thread pool to be executed, the integer passed
   // to |_task| is the thread id of the calling thread in the pool
+  //
+  // when the queue is full the task is allocated into the overflow queue
   void add(Function<void(int)>&& task_);
 
+  // number of threads in the pool
+  Size size() const;
+
   constexpr Memory::Allocator& allocator() const;
 
   static constexpr ThreadPool& instance();
 
 private:
+  bool pop(Function<void(int)>& task_);
+
   Memory::Allocator& m_allocator;
 
+  MPMCQueue<Function<void(int)>> m_queue;
+
+  // Tasks which didn't fit in |m_queue|, popped under |m_overflow_lock|.
+  MPSCQueue<Function<void(int)>> m_overflow;
+  SpinLock m_overflow_lock;
+  Atomic<Size> m_overflow_size;
+
   Mutex m_mutex;
   ConditionVariable m_task_cond;
   ConditionVariable m_ready_cond;
 
-  IntrusiveList m_queue     RX_HINT_GUARDED_BY(m_mutex);
+  // Number of threads about to sleep or sleeping on |m_task_cond|.
+  Atomic<Size> m_sleeping;
+
   Vector<Thread> m_threads  RX_HINT_GUARDED_BY(m_mutex);
-  DynamicPool m_job_memory  RX_HINT_GUARDED_BY(m_mutex);
   bool m_stop               RX_HINT_GUARDED_BY(m_mutex);
+  Size m_size;
 
   static Global<ThreadPool> s_instance;
 };
 
-inline ThreadPool::ThreadPool(Size _threads, Size _static_pool_size)
-  : ThreadPool{Memory::SystemAllocator::instance(), _threads, _static_pool_size}
+inline ThreadPool::ThreadPool(Size _threads, Size _queue_size)
+  : ThreadPool{Memory::SystemAllocator::instance(), _threads, _queue_size}
 {
 }
 
+RX_HINT_FORCE_INLINE Size ThreadPool::size() const {
+  return m_size;
+}
+
 RX_HINT_FORCE_INLINE constexpr Memory::Allocator& ThreadPool::allocator() const {
   return m_allocator;
 }
@@ -1,17 +1,37 @@
 #include "rx/core/concurrency/wait_group.h"
 #include "rx/core/concurrency/scope_lock.h"
 
+#include "rx/core/assert.h"
+
 namespace Rx::Concurrency {
 
 void WaitGroup::signal() {
+  // Every signal but the last is a single atomic decrement and doesn't touch
+  // the group afterwards.
+  Size count = m_count.load(MemoryOrder::k_relaxed);
+  while (count > 1) {
+    if (m_count.compare_exchange_weak(count, count - 1,
+      MemoryOrder::k_acq_rel, MemoryOrder::k_relaxed))
+    {
+      return;
+    }
+  }
+
+  RX_ASSERT(count == 1, "too many signals");
+
+  // The final decrement happens under the lock. The waiter only observes a
+  // count of zero while holding the lock, so it cannot return and destroy the
+  // group until this signal is done with it.
   ScopeLock lock{m_mutex};
-  m_signaled_count++;
-  m_condition_variable.signal();
+  m_count.store(0, MemoryOrder::k_release);
+  m_condition_variable.broadcast();
 }
 
 void WaitGroup::wait() {
   ScopeLock lock{m_mutex};
-  m_condition_variable.wait(lock, [&]{ return m_signaled_count == m_count; });
+  m_condition_variable.wait(lock, [&]{
+    return m_count.load(MemoryOrder::k_acquire) == 0;
+  });
 }
 
 } // namespace rx::concurrency
@@ -2,11 +2,18 @@
 #define RX_CORE_CONCURRENCY_WAIT_GROUP_H
 #include "rx/core/types.h"
 
+#include "rx/core/concurrency/atomic.h"
 #include "rx/core/concurrency/mutex.h"
 #include "rx/core/concurrency/condition_variable.h"
 
 namespace Rx::Concurrency {
 
+// # Wait Group
+//
+// Waits for |_count| signals. Signalling is a single atomic decrement, only
+// the final signal takes the lock and decrements under it to wake up the
+// waiter. This makes it safe for the waiter to destroy the group as soon as
+// wait returns.
 struct WaitGroup {
   WaitGroup(Size _count);
   WaitGroup();
@@ -15,15 +22,13 @@ struct WaitGroup {
   void wait();
 
 private:
-  Size m_signaled_count RX_HINT_GUARDED_BY(m_mutex);
-  Size m_count          RX_HINT_GUARDED_BY(m_mutex);
+  Atomic<Size> m_count;
   Mutex m_mutex;
   ConditionVariable m_condition_variable;
 };
 
 inline WaitGroup::WaitGroup(Size _count)
-  : m_signaled_count{0}
-  , m_count{_count}
+  : m_count{_count}
 {
 }
 
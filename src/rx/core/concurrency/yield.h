@@ -1,10 +1,28 @@
 #ifndef RX_CORE_CONCURRENCY_YIELD_H
 #define RX_CORE_CONCURRENCY_YIELD_H
+#include "rx/core/config.h" // RX_COMPILER_*
+
+#if defined(RX_COMPILER_MSVC)
+#include <intrin.h> // _mm_pause
+#endif
 
 namespace Rx::Concurrency {
 
+// Give up the rest of the time slice of the calling thread.
 void yield();
 
+// Tell the processor the calling thread is spinning. This is a pause on x86,
+// which saves power and avoids the memory order violation when the spin ends.
+inline void relax() {
+#if defined(RX_COMPILER_MSVC)
+  _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
 } // namespace rx::concurrency
 
-#endif // RX_CORE_CONCURRENCY_YIELD_H
\ No newline at end of file
+#endif // RX_CORE_CONCURRENCY_YIELD_H
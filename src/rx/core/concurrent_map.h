@@ -0,0 +1,386 @@
+#ifndef RX_CORE_CONCURRENT_MAP_H
+#define RX_CORE_CONCURRENT_MAP_H
+#include "rx/core/flat_map.h"
+#include "rx/core/optional.h"
+#include "rx/core/markers.h"
+
+#include "rx/core/concurrency/rw_lock.h"
+#include "rx/core/concurrency/scope_lock.h"
+#include "rx/core/concurrency/cache_line.h"
+
+#include "rx/core/traits/return_type.h"
+
+#include "rx/core/utility/construct.h"
+#include "rx/core/utility/destruct.h"
+
+namespace Rx {
+
+// # Concurrent Map
+//
+// An unordered map any number of threads can use at the same time. The keys
+// are split across a fixed number of shards by hash, each shard is a FlatMap
+// with it's own reader-writer lock on it's own cache line. Threads only ever
+// wait for each other when they use keys of the same shard, and lookups only
+// wait for writers.
+//
+// Values can be moved when a shard grows and be erased by another thread, so
+// lookups never hand out pointers into the map. Either the value is copied
+// out or a function is called with it while the shard is locked.
+//
+// find_or_insert_with is how caches shared between threads are filled, the
+// value is created exactly once no matter how many threads ask for a key at
+// the same time. The shard stays locked for writing while the value is
+// created, keep that cheap or expect other keys of the shard to wait.
+//
+// Functions called with the shard locked must not use the map themselves.
+//
+// Like FlatMap, inserting a key which already exists replaces the value.
+template<typename K, typename V>
+struct ConcurrentMap {
+  RX_MARK_NO_COPY(ConcurrentMap);
+  RX_MARK_NO_MOVE(ConcurrentMap);
+
+  static inline constexpr const Size k_shard_bits = 6;
+  static inline constexpr const Size k_shards = 1_z << k_shard_bits;
+
+  ConcurrentMap();
+  ConcurrentMap(Memory::Allocator& _allocator);
+  ~ConcurrentMap();
+
+  // Returns false when out of memory.
+  bool insert(const K& _key, V&& value_);
+  bool insert(const K& _key, const V& _value);
+
+  // Copy of the value of |_key|. The key may also be of another type, see
+  // is_heterogeneous_key.
+  template<typename U>
+  Optional<V> find(const U& _key) const;
+
+  // Calls |_function| with the value of |_key| while it cannot be changed or
+  // erased. Returns false when |_key| isn't in the map.
+  template<typename U, typename F>
+  bool find(const U& _key, F&& _function) const;
+
+  // Copy of the value of |_key|, inserting the value returned by |_create|
+  // first when |_key| isn't in the map.
+  template<typename F>
+  V find_or_insert_with(const K& _key, F&& _create);
+
+  template<typename U>
+  bool erase(const U& _key);
+
+  // Erases every pair |_predicate| returns true for and returns how many.
+  template<typename F>
+  Size erase_if(F&& _predicate);
+
+  // Approximate when called concurrently with an insert or erase.
+  Size size() const;
+  bool is_empty() const;
+
+  void clear();
+
+  // Iteration locks one shard at a time, pairs inserted or erased during the
+  // iteration may or may not be visited.
+  template<typename F>
+  bool each_key(F&& _function) const;
+
+  template<typename F>
+  bool each_value(F&& _function);
+  template<typename F>
+  bool each_value(F&& _function) const;
+
+  template<typename F>
+  bool each_pair(F&& _function);
+  template<typename F>
+  bool each_pair(F&& _function) const;
+
+  constexpr Memory::Allocator& allocator() const;
+
+private:
+  struct Shard {
+    Shard(Memory::Allocator& _allocator);
+
+    mutable Concurrency::RWLock lock;
+    FlatMap<K, V> map RX_HINT_GUARDED_BY(lock);
+
+    // Keep every shard on it's own cache lines.
+    Byte padding[Concurrency::k_cache_line -
+      (sizeof(Concurrency::RWLock) + sizeof(FlatMap<K, V>)) % Concurrency::k_cache_line];
+  };
+
+  template<typename U>
+  static Size hash_of(const U& _key);
+
+  Shard& shard_of(Size _hash);
+  const Shard& shard_of(Size _hash) const;
+
+  template<typename F, typename... Ts>
+  static bool call(F& _function, Ts&&... _arguments);
+
+  Memory::Allocator& m_allocator;
+  Byte* m_data;
+  Shard* m_shards;
+};
+
+template<typename K, typename V>
+inline ConcurrentMap<K, V>::Shard::Shard(Memory::Allocator& _allocator)
+  : map{_allocator}
+{
+}
+
+template<typename K, typename V>
+inline ConcurrentMap<K, V>::ConcurrentMap()
+  : ConcurrentMap{Memory::SystemAllocator::instance()}
+{
+}
+
+template<typename K, typename V>
+inline ConcurrentMap<K, V>::ConcurrentMap(Memory::Allocator& _allocator)
+  : m_allocator{_allocator}
+  , m_data{nullptr}
+  , m_shards{nullptr}
+{
+  // Over allocate by a cache line so the shards can be aligned to one.
+  m_data = allocator().allocate(sizeof(Shard) * k_shards + Concurrency::k_cache_line);
+  RX_ASSERT(m_data, "out of memory");
+
+  const auto address = reinterpret_cast<UintPtr>(m_data);
+  const auto aligned = (address + Concurrency::k_cache_line - 1) & ~(Concurrency::k_cache_line - 1);
+  m_shards = reinterpret_cast<Shard*>(aligned);
+
+  for (Size i = 0; i < k_shards; i++) {
+    Utility::construct<Shard>(m_shards + i, allocator());
+  }
+}
+
+template<typename K, typename V>
+inline ConcurrentMap<K, V>::~ConcurrentMap() {
+  for (Size i = 0; i < k_shards; i++) {
+    Utility::destruct<Shard>(m_shards + i);
+  }
+  allocator().deallocate(m_data);
+}
+
+template<typename K, typename V>
+inline bool ConcurrentMap<K, V>::insert(const K& _key, V&& value_) {
+  const Size hash = hash_of(_key);
+  Shard& shard = shard_of(hash);
+  Concurrency::ScopeLock lock{shard.lock};
+  return shard.map.insert(_key, hash, Utility::move(value_)) != nullptr;
+}
+
+template<typename K, typename V>
+inline bool ConcurrentMap<K, V>::insert(const K& _key, const V& _value) {
+  const Size hash = hash_of(_key);
+  Shard& shard = shard_of(hash);
+  Concurrency::ScopeLock lock{shard.lock};
+  return shard.map.insert(_key, hash, _value) != nullptr;
+}
+
+template<typename K, typename V>
+template<typename U>
+inline Optional<V> ConcurrentMap<K, V>::find(const U& _key) const {
+  const Size hash = hash_of(_key);
+  const Shard& shard = shard_of(hash);
+  Concurrency::ScopeReadLock lock{shard.lock};
+  if (const V* value = shard.map.find(_key, hash)) {
+    return *value;
+  }
+  return nullopt;
+}
+
+template<typename K, typename V>
+template<typename U, typename F>
+inline bool ConcurrentMap<K, V>::find(const U& _key, F&& _function) const {
+  const Size hash = hash_of(_key);
+  const Shard& shard = shard_of(hash);
+  Concurrency::ScopeReadLock lock{shard.lock};
+  if (const V* value = shard.map.find(_key, hash)) {
+    _function(*value);
+    return true;
+  }
+  return false;
+}
+
+template<typename K, typename V>
+template<typename F>
+inline V ConcurrentMap<K, V>::find_or_insert_with(const K& _key, F&& _create) {
+  const Size hash = hash_of(_key);
+  Shard& shard = shard_of(hash);
+
+  {
+    Concurrency::ScopeReadLock lock{shard.lock};
+    if (const V* value = shard.map.find(_key, hash)) {
+      return *value;
+    }
+  }
+
+  Concurrency::ScopeLock lock{shard.lock};
+
+  // Another thread may have inserted it between the locks.
+  if (const V* value = shard.map.find(_key, hash)) {
+    return *value;
+  }
+
+  const V* value = shard.map.insert(_key, hash, _create());
+  RX_ASSERT(value, "out of memory");
+  return *value;
+}
+
+template<typename K, typename V>
+template<typename U>
+inline bool ConcurrentMap<K, V>::erase(const U& _key) {
+  const Size hash = hash_of(_key);
+  Shard& shard = shard_of(hash);
+  Concurrency::ScopeLock lock{shard.lock};
+  return shard.map.erase(_key, hash);
+}
+
+template<typename K, typename V>
+template<typename F>
+inline Size ConcurrentMap<K, V>::erase_if(F&& _predicate) {
+  Size erased = 0;
+  for (Size i = 0; i < k_shards; i++) {
+    Shard& shard = m_shards[i];
+    Concurrency::ScopeLock lock{shard.lock};
+    // Erasing invalidates the iteration, start over after every erase.
+    for (bool found = true; found; ) {
+      found = !shard.map.each_pair([&](const K& _key, V& _value) {
+        if (!_predicate(_key, _value)) {
+          return true;
+        }
+        shard.map.erase(_key);
+        return false;
+      });
+      erased += found;
+    }
+  }
+  return erased;
+}
+
+template<typename K, typename V>
+inline Size ConcurrentMap<K, V>::size() const {
+  Size size = 0;
+  for (Size i = 0; i < k_shards; i++) {
+    const Shard& shard = m_shards[i];
+    Concurrency::ScopeReadLock lock{shard.lock};
+    size += shard.map.size();
+  }
+  return size;
+}
+
+template<typename K, typename V>
+inline bool ConcurrentMap<K, V>::is_empty() const {
+  return size() == 0;
+}
+
+template<typename K, typename V>
+inline void ConcurrentMap<K, V>::clear() {
+  for (Size i = 0; i < k_shards; i++) {
+    Shard& shard = m_shards[i];
+    Concurrency::ScopeLock lock{shard.lock};
+    shard.map.clear();
+  }
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool ConcurrentMap<K, V>::each_key(F&& _function) const {
+  return each_pair([&](const K& _key, const V&) {
+    return call(_function, _key);
+  });
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool ConcurrentMap<K, V>::each_value(F&& _function) {
+  return each_pair([&](const K&, V& _value) {
+    return call(_function, _value);
+  });
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool ConcurrentMap<K, V>::each_value(F&& _function) const {
+  return each_pair([&](const K&, const V& _value) {
+    return call(_function, _value);
+  });
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool ConcurrentMap<K, V>::each_pair(F&& _function) {
+  for (Size i = 0; i < k_shards; i++) {
+    Shard& shard = m_shards[i];
+    Concurrency::ScopeLock lock{shard.lock};
+    const bool more = shard.map.each_pair([&](const K& _key, V& _value) {
+      return call(_function, _key, _value);
+    });
+    if (!more) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool ConcurrentMap<K, V>::each_pair(F&& _function) const {
+  for (Size i = 0; i < k_shards; i++) {
+    const Shard& shard = m_shards[i];
+    Concurrency::ScopeReadLock lock{shard.lock};
+    const bool more = shard.map.each_pair([&](const K& _key, const V& _value) {
+      return call(_function, _key, _value);
+    });
+    if (!more) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template<typename K, typename V>
+template<typename U>
+inline Size ConcurrentMap<K, V>::hash_of(const U& _key) {
+  if constexpr (is_heterogeneous_key<K, U>) {
+    return _key.hash();
+  } else {
+    return Hash<K>{}(_key);
+  }
+}
+
+template<typename K, typename V>
+inline typename ConcurrentMap<K, V>::Shard& ConcurrentMap<K, V>::shard_of(Size _hash) {
+  // The shard is picked with the top bits of a multiplicative hash, FlatMap
+  // already uses the low bits of |_hash| within the shard.
+  if constexpr (sizeof(Size) == 8) {
+    return m_shards[(_hash * 0x9e3779b97f4a7c15_z) >> (64 - k_shard_bits)];
+  } else {
+    return m_shards[(_hash * 0x9e3779b9_z) >> (32 - k_shard_bits)];
+  }
+}
+
+template<typename K, typename V>
+inline const typename ConcurrentMap<K, V>::Shard& ConcurrentMap<K, V>::shard_of(Size _hash) const {
+  return const_cast<ConcurrentMap*>(this)->shard_of(_hash);
+}
+
+template<typename K, typename V>
+template<typename F, typename... Ts>
+inline bool ConcurrentMap<K, V>::call(F& _function, Ts&&... _arguments) {
+  if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+    return _function(Utility::forward<Ts>(_arguments)...);
+  } else {
+    _function(Utility::forward<Ts>(_arguments)...);
+    return true;
+  }
+}
+
+template<typename K, typename V>
+RX_HINT_FORCE_INLINE constexpr Memory::Allocator& ConcurrentMap<K, V>::allocator() const {
+  return m_allocator;
+}
+
+} // namespace rx
+
+#endif // RX_CORE_CONCURRENT_MAP_H
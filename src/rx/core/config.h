@@ -103,6 +103,15 @@
 # endif
 #endif // !defined(RX_BYTE_ORDER_LITTLE_ENDIAN) && !defined(RX_BYTE_ORDER_BIG_ENDIAN)
 
+// determine SIMD instruction sets
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define RX_HAS_SSE2
+#endif
+
+#if defined(__AVX2__)
+# define RX_HAS_AVX2
+#endif
+
 // disable some compiler warnings we don't care about
 #if defined(RX_COMPILER_MSVC)
 # pragma warning(disable: 4146) // unary minus operator applied to unsigned Type, result still unsigned
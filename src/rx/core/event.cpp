@@ -0,0 +1,26 @@
+#include "rx/core/event.h"
+
+namespace Rx::detail {
+
+static thread_local const EventSignal* t_signals;
+
+void enter_event_signal(EventSignal* signal_, const void* _event) {
+  signal_->event = _event;
+  signal_->next = t_signals;
+  t_signals = signal_;
+}
+
+void leave_event_signal(const EventSignal* _signal) {
+  t_signals = _signal->next;
+}
+
+bool is_event_signalling(const void* _event) {
+  for (const EventSignal* signal = t_signals; signal; signal = signal->next) {
+    if (signal->event == _event) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace rx::detail
@@ -1,17 +1,58 @@
 #ifndef RX_CORE_EVENT_H
 #define RX_CORE_EVENT_H
 #include "rx/core/function.h"
-#include "rx/core/vector.h"
 #include "rx/core/markers.h"
-#include "rx/core/hints/thread.h"
+#include "rx/core/assert.h"
 
+#include "rx/core/concurrency/atomic.h"
 #include "rx/core/concurrency/spin_lock.h"
 #include "rx/core/concurrency/scope_lock.h"
+#include "rx/core/concurrency/yield.h"
+#include "rx/core/concurrency/cache_line.h"
+#include "rx/core/concurrency/per_core_counter.h"
 
+#include "rx/core/utility/construct.h"
 #include "rx/core/utility/exchange.h"
 
 namespace Rx {
 
+namespace detail {
+  // The events being signalled by the calling thread, innermost first.
+  struct EventSignal {
+    const void* event;
+    const EventSignal* next;
+  };
+
+  void enter_event_signal(EventSignal* signal_, const void* _event);
+  void leave_event_signal(const EventSignal* _signal);
+  bool is_event_signalling(const void* _event);
+} // namespace detail
+
+// # Event
+//
+// Signalling never locks. The connected delegates are published as an
+// immutable snapshot which signal reads and calls, so any number of threads
+// can signal at once. Each signal counts itself in one of two counters for as
+// long as it's calling delegates, which is the only shared memory it writes.
+//
+// The counters are split into |k_slots| slots on cache lines of their own and
+// threads count themselves in the slot PerCoreCounter assigned them, so
+// threads signalling the same event at once don't contend on a cache line.
+// This costs every event |k_slots| cache lines and makes a grace period scan
+// every slot.
+//
+// Connecting and disconnecting delegates serialize on a lock and publish a new
+// snapshot. Destroying a Handle waits for every signal which could still call
+// it's delegate to finish, so once the Handle is gone the delegate never runs
+// again and whatever it captures may be destroyed. It's called a grace period.
+// Signals which begin during a grace period enter the other counter, so a
+// grace period only ever waits for signals which were already in progress,
+// it's not held up by new ones.
+//
+// A delegate may connect delegates to the event it's called from, a signal
+// already in progress calls the delegates of the snapshot it started with. A
+// delegate must not destroy a Handle of the event it's called from though,
+// since that would wait for itself.
 template<typename T>
 struct Event;
 
@@ -25,22 +66,23 @@ struct Event<R(Ts...)> {
   struct Handle {
     RX_MARK_NO_COPY(Handle);
 
-    constexpr Handle(Event* _event, Size _index);
+    constexpr Handle(Event* _event, Delegate* _delegate);
 
     // NOTE(dweiler): This is done inside this struct, rather than outside to avoid an ICE in MSVC
     Handle(Handle&& handle_)
         : m_event{Utility::exchange(handle_.m_event, nullptr)}
-        , m_index{Utility::exchange(handle_.m_index, 0)}
+        , m_delegate{Utility::exchange(handle_.m_delegate, nullptr)}
     {
     }
     ~Handle();
   private:
     Event* m_event;
-    Size m_index;
+    Delegate* m_delegate;
   };
 
   constexpr Event(Memory::Allocator& _allocator);
   constexpr Event();
+  ~Event();
 
   void signal(Ts... _arguments);
   Handle connect(Delegate&& function_);
@@ -52,31 +94,86 @@ struct Event<R(Ts...)> {
 
 private:
   friend struct Handle;
-  mutable Concurrency::SpinLock m_lock;
 
-  Vector<Delegate> m_delegates RX_HINT_GUARDED_BY(m_lock);
+  // The delegate pointers follow the snapshot in the same allocation.
+  struct Snapshot {
+    Delegate** delegates();
+    Size size;
+    Snapshot* next;
+  };
+
+  static inline constexpr const Size k_slots = 8;
+
+  // The reader counters of a slot, padded to a cache line.
+  struct Slot {
+    Concurrency::Atomic<Size> readers[2];
+    Byte padding[Concurrency::k_cache_line - sizeof(Concurrency::Atomic<Size>) * 2];
+  };
+
+  // Counts the calling thread as reading the snapshot until |leave|. Returns
+  // the counter to pass to |leave|.
+  Size enter() const;
+  void leave(Size _counter) const;
+
+  // Slot of the calling thread.
+  Slot& slot() const;
+
+  // If no reader is counted in either counter of any slot.
+  bool is_quiescent() const;
+
+  // Waits for every reader counted when called to leave.
+  void synchronize() const;
+  void wait(Size _counter) const;
+
+  // Copies |_snapshot| with |_insert| added and |_remove| removed, either
+  // may be nullptr. Returns nullptr when no delegates are left.
+  Snapshot* copy(Snapshot* _snapshot, Delegate* _insert, Delegate* _remove);
+  void disconnect(Delegate* _delegate);
+  void release(Snapshot* _snapshot);
+
+  Memory::Allocator& m_allocator;
+
+  // Serializes connecting and disconnecting, signals never take it.
+  Concurrency::SpinLock m_lock;
+
+  Concurrency::Atomic<Snapshot*> m_snapshot;
+
+  // Snapshots replaced by connect while a signal could still be reading them,
+  // linked by |Snapshot::next|. Freed by the next grace period.
+  Snapshot* m_retired RX_HINT_GUARDED_BY(m_lock);
+
+  // The counter signals enter and the number of readers in each counter of
+  // every slot.
+  mutable Concurrency::Atomic<Size> m_phase;
+  mutable Slot m_slots[k_slots];
 };
 
 template<typename R, typename... Ts>
-inline constexpr Event<R(Ts...)>::Handle::Handle(Event<R(Ts...)>* _event, Size _index)
+inline constexpr Event<R(Ts...)>::Handle::Handle(Event<R(Ts...)>* _event, Delegate* _delegate)
   : m_event{_event}
-  , m_index{_index}
+  , m_delegate{_delegate}
 {
 }
 
-
-
 template<typename R, typename... Ts>
 inline Event<R(Ts...)>::Handle::~Handle() {
   if (m_event) {
-    Concurrency::ScopeLock lock{m_event->m_lock};
-    m_event->m_delegates[m_index] = nullptr;
+    m_event->disconnect(m_delegate);
   }
 }
 
+template<typename R, typename... Ts>
+inline typename Event<R(Ts...)>::Delegate** Event<R(Ts...)>::Snapshot::delegates() {
+  return reinterpret_cast<Delegate**>(this + 1);
+}
+
 template<typename R, typename... Ts>
 inline constexpr Event<R(Ts...)>::Event(Memory::Allocator& _allocator)
-  : m_delegates{_allocator}
+  : m_allocator{_allocator}
+  , m_snapshot{nullptr}
+  , m_retired{nullptr}
+  , m_phase{0}
+  , m_slots{}
 {
 }
 
@@ -86,28 +183,186 @@ inline constexpr Event<R(Ts...)>::Event()
 {
 }
 
+template<typename R, typename... Ts>
+inline Event<R(Ts...)>::~Event() {
+  // Nothing can signal an event being destroyed, free it all right away.
+  if (Snapshot* snapshot = m_snapshot.load(Concurrency::MemoryOrder::k_relaxed)) {
+    for (Size i = 0; i < snapshot->size; i++) {
+      Utility::destruct<Delegate>(snapshot->delegates()[i]);
+      allocator().deallocate(snapshot->delegates()[i]);
+    }
+    allocator().deallocate(snapshot);
+  }
+  release(m_retired);
+}
+
 template<typename R, typename... Ts>
 inline void Event<R(Ts...)>::signal(Ts... _arguments) {
-  Concurrency::ScopeLock lock{m_lock};
-  m_delegates.each_fwd([&](Delegate& _delegate) {
-    if (_delegate) {
-      _delegate(_arguments...);
+  detail::EventSignal signal;
+  detail::enter_event_signal(&signal, this);
+
+  const Size counter = enter();
+  if (Snapshot* snapshot = m_snapshot.load(Concurrency::MemoryOrder::k_seq_cst)) {
+    Delegate** delegates = snapshot->delegates();
+    for (Size i = 0; i < snapshot->size; i++) {
+      (*delegates[i])(_arguments...);
     }
-  });
+  }
+  leave(counter);
+
+  detail::leave_event_signal(&signal);
 }
 
 template<typename R, typename... Ts>
 inline typename Event<R(Ts...)>::Handle Event<R(Ts...)>::connect(Delegate&& delegate_) {
+  Byte* data = allocator().allocate(sizeof(Delegate));
+  RX_ASSERT(data, "out of memory");
+  Delegate* delegate = Utility::construct<Delegate>(data, Utility::move(delegate_));
+
   Concurrency::ScopeLock lock{m_lock};
-  const Size delegates = m_delegates.size();
-  for (Size i = 0; i < delegates; i++) {
-    if (!m_delegates[i]) {
-      m_delegates[i] = Utility::move(delegate_);
-      return {this, i};
+  Snapshot* snapshot = m_snapshot.load(Concurrency::MemoryOrder::k_relaxed);
+  m_snapshot.store(copy(snapshot, delegate, nullptr),
+    Concurrency::MemoryOrder::k_seq_cst);
+
+  if (snapshot) {
+    // Connecting doesn't wait for a grace period, it may be called from a
+    // delegate of this event. When no signal is counted after publishing the
+    // new snapshot none can still be reading the old one, any signal counted
+    // later reads the new one. Otherwise leave it for a grace period.
+    if (is_quiescent()) {
+      allocator().deallocate(snapshot);
+    } else {
+      snapshot->next = m_retired;
+      m_retired = snapshot;
     }
   }
-  m_delegates.emplace_back(Utility::move(delegate_));
-  return {this, delegates};
+
+  return {this, delegate};
+}
+
+template<typename R, typename... Ts>
+inline void Event<R(Ts...)>::disconnect(Delegate* _delegate) {
+  RX_ASSERT(!detail::is_event_signalling(this),
+    "delegate cannot be disconnected while it's event is signalled by this thread");
+
+  Snapshot* snapshot = nullptr;
+  Snapshot* retired = nullptr;
+  {
+    Concurrency::ScopeLock lock{m_lock};
+    snapshot = m_snapshot.load(Concurrency::MemoryOrder::k_relaxed);
+    m_snapshot.store(copy(snapshot, nullptr, _delegate),
+      Concurrency::MemoryOrder::k_seq_cst);
+    retired = Utility::exchange(m_retired, nullptr);
+  }
+
+  // Wait for every signal which could still be calling |_delegate| or reading
+  // a snapshot retired before this one. The lock isn't held so delegates can
+  // connect in the meantime.
+  synchronize();
+
+  snapshot->next = retired;
+  release(snapshot);
+
+  Utility::destruct<Delegate>(_delegate);
+  allocator().deallocate(_delegate);
+}
+
+template<typename R, typename... Ts>
+inline void Event<R(Ts...)>::release(Snapshot* _snapshot) {
+  while (_snapshot) {
+    Snapshot* next = _snapshot->next;
+    allocator().deallocate(_snapshot);
+    _snapshot = next;
+  }
+}
+
+template<typename R, typename... Ts>
+inline Size Event<R(Ts...)>::enter() const {
+  // Sequentially consistent so that a reader is either counted before a writer
+  // checks the counter, or reads the snapshot the writer published.
+  const Size counter = m_phase.load(Concurrency::MemoryOrder::k_seq_cst) & 1;
+  slot().readers[counter].fetch_add(1, Concurrency::MemoryOrder::k_seq_cst);
+  return counter;
+}
+
+template<typename R, typename... Ts>
+inline void Event<R(Ts...)>::leave(Size _counter) const {
+  // A thread always has the same slot, so this is the slot |enter| counted in.
+  slot().readers[_counter].fetch_sub(1, Concurrency::MemoryOrder::k_release);
+}
+
+template<typename R, typename... Ts>
+inline typename Event<R(Ts...)>::Slot& Event<R(Ts...)>::slot() const {
+  return m_slots[Concurrency::PerCoreCounter::slot_index() % k_slots];
+}
+
+template<typename R, typename... Ts>
+inline bool Event<R(Ts...)>::is_quiescent() const {
+  for (Size i = 0; i < k_slots; i++) {
+    if (m_slots[i].readers[0].load(Concurrency::MemoryOrder::k_seq_cst) != 0
+      || m_slots[i].readers[1].load(Concurrency::MemoryOrder::k_seq_cst) != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template<typename R, typename... Ts>
+inline void Event<R(Ts...)>::synchronize() const {
+  // Observing each counter at zero once is what makes the grace period, the
+  // phase only moves new readers to the other counter so waiting on this one
+  // isn't held up by them. The other counter only has readers left from an
+  // earlier phase, wait for those first.
+  const Size counter = m_phase.load(Concurrency::MemoryOrder::k_seq_cst) & 1;
+  wait(counter ^ 1);
+  m_phase.store(counter ^ 1, Concurrency::MemoryOrder::k_seq_cst);
+  wait(counter);
+}
+
+template<typename R, typename... Ts>
+inline void Event<R(Ts...)>::wait(Size _counter) const {
+  // Readers leave the slot they entered, so every slot can be waited on in
+  // turn. Readers entering a slot after it was seen at zero read the new
+  // snapshot.
+  for (Size i = 0; i < k_slots; i++) {
+    while (m_slots[i].readers[_counter].load(Concurrency::MemoryOrder::k_seq_cst) != 0) {
+      Concurrency::yield();
+    }
+  }
+}
+
+template<typename R, typename... Ts>
+inline typename Event<R(Ts...)>::Snapshot* Event<R(Ts...)>::copy(Snapshot* _snapshot,
+  Delegate* _insert, Delegate* _remove)
+{
+  const Size size = _snapshot ? _snapshot->size : 0;
+  const Size new_size = size + (_insert ? 1 : 0) - (_remove ? 1 : 0);
+  if (new_size == 0) {
+    return nullptr;
+  }
+
+  Byte* data = allocator().allocate(sizeof(Snapshot) + sizeof(Delegate*) * new_size);
+  RX_ASSERT(data, "out of memory");
+
+  auto snapshot = reinterpret_cast<Snapshot*>(data);
+  snapshot->size = 0;
+  snapshot->next = nullptr;
+
+  Delegate** delegates = snapshot->delegates();
+  for (Size i = 0; i < size; i++) {
+    if (_snapshot->delegates()[i] != _remove) {
+      delegates[snapshot->size++] = _snapshot->delegates()[i];
+    }
+  }
+
+  if (_insert) {
+    delegates[snapshot->size++] = _insert;
+  }
+
+  RX_ASSERT(snapshot->size == new_size, "delegate not connected");
+
+  return snapshot;
 }
 
 template<typename R, typename... Ts>
@@ -117,20 +372,16 @@ inline bool Event<R(Ts...)>::is_empty() const {
 
 template<typename R, typename... Ts>
 inline Size Event<R(Ts...)>::size() const {
-  Concurrency::ScopeLock lock{m_lock};
-  // This is slightly annoying because |m_delegates| may have empty slots.
-  Size result = 0;
-  m_delegates.each_fwd([&](const Delegate& _delegate) {
-    if (_delegate) {
-      result++;
-    }
-  });
-  return result;
+  const Size counter = enter();
+  const Snapshot* snapshot = m_snapshot.load(Concurrency::MemoryOrder::k_seq_cst);
+  const Size size = snapshot ? snapshot->size : 0;
+  leave(counter);
+  return size;
 }
 
 template<typename R, typename... Ts>
 RX_HINT_FORCE_INLINE constexpr Memory::Allocator& Event<R(Ts...)>::allocator() const {
-  return m_delegates.allocator();
+  return m_allocator;
 }
 
 } // namespace rx
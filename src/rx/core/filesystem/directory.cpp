@@ -100,7 +100,7 @@ Directory::~Directory() {
 #endif
 }
 
-void Directory::each(Function<void(Item&&)>&& _function) {
+void Directory::each(FunctionRef<void(Item&&)> _function) {
   RX_ASSERT(m_impl, "directory not opened");
 
 #if defined(RX_PLATFORM_POSIX)
@@ -1,7 +1,7 @@
 #ifndef RX_CORE_FILESYSTEM_DIRECTORY_H
 #define RX_CORE_FILESYSTEM_DIRECTORY_H
 #include "rx/core/string.h"
-#include "rx/core/function.h"
+#include "rx/core/function_ref.h"
 #include "rx/core/optional.h"
 
 namespace Rx::Filesystem {
@@ -50,7 +50,7 @@ struct Directory {
 
   // enumerate directory with |_function| being called for each item
   // NOTE: does not consider hidden files, symbolic links, block devices, or ..
-  void each(Function<void(Item&&)>&& _function);
+  void each(FunctionRef<void(Item&&)> _function);
 
   const String& path() const &;
 
@@ -0,0 +1,759 @@
+#ifndef RX_CORE_FLAT_MAP_H
+#define RX_CORE_FLAT_MAP_H
+#include "rx/core/array.h"
+#include "rx/core/hash.h"
+#include "rx/core/config.h" // RX_HAS_SSE2
+
+#include "rx/core/traits/is_trivially_destructible.h"
+#include "rx/core/traits/return_type.h"
+#include "rx/core/traits/is_same.h"
+#include "rx/core/traits/enable_if.h"
+
+#include "rx/core/utility/pair.h"
+#include "rx/core/utility/bit.h"
+
+#include "rx/core/hints/likely.h"
+#include "rx/core/hints/unlikely.h"
+
+#include "rx/core/memory/system_allocator.h"
+#include "rx/core/memory/aggregate.h"
+
+#if defined(RX_HAS_SSE2)
+#include <emmintrin.h> // __m128i, _mm_*
+#endif
+
+namespace Rx {
+
+namespace detail {
+  // Control bytes. Full slots store the low seven bits of the hash, making the
+  // control byte of a full slot always positive.
+  inline constexpr const Sint8 k_flat_map_empty = -128;   // 0b10000000
+  inline constexpr const Sint8 k_flat_map_deleted = -2;   // 0b11111110
+  inline constexpr const Sint8 k_flat_map_sentinel = -1;  // 0b11111111
+
+  // Empty maps point their control bytes here so lookups need not check for
+  // an empty map.
+  alignas(16) inline constexpr const Sint8 k_flat_map_empty_group[16]{
+    k_flat_map_empty, k_flat_map_empty, k_flat_map_empty, k_flat_map_empty,
+    k_flat_map_empty, k_flat_map_empty, k_flat_map_empty, k_flat_map_empty,
+    k_flat_map_empty, k_flat_map_empty, k_flat_map_empty, k_flat_map_empty,
+    k_flat_map_empty, k_flat_map_empty, k_flat_map_empty, k_flat_map_empty
+  };
+
+  // A group of 16 control bytes. Each match function returns a mask with a
+  // bit set for each control byte in the group which matches.
+  struct FlatMapGroup {
+    static inline constexpr const Size k_width = 16;
+
+    explicit FlatMapGroup(const Sint8* _control);
+
+    Uint32 match(Sint8 _hash) const;
+    Uint32 match_empty() const;
+    Uint32 match_empty_or_deleted() const;
+
+  private:
+#if defined(RX_HAS_SSE2)
+    __m128i m_control;
+#else
+    const Sint8* m_control;
+#endif
+  };
+
+#if defined(RX_HAS_SSE2)
+  RX_HINT_FORCE_INLINE FlatMapGroup::FlatMapGroup(const Sint8* _control)
+    : m_control{_mm_loadu_si128(reinterpret_cast<const __m128i*>(_control))}
+  {
+  }
+
+  RX_HINT_FORCE_INLINE Uint32 FlatMapGroup::match(Sint8 _hash) const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(_hash), m_control));
+  }
+
+  RX_HINT_FORCE_INLINE Uint32 FlatMapGroup::match_empty() const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(k_flat_map_empty), m_control));
+  }
+
+  RX_HINT_FORCE_INLINE Uint32 FlatMapGroup::match_empty_or_deleted() const {
+    // Empty and deleted are the only control bytes less than the sentinel.
+    return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(k_flat_map_sentinel), m_control));
+  }
+#else
+  RX_HINT_FORCE_INLINE FlatMapGroup::FlatMapGroup(const Sint8* _control)
+    : m_control{_control}
+  {
+  }
+
+  RX_HINT_FORCE_INLINE Uint32 FlatMapGroup::match(Sint8 _hash) const {
+    Uint32 mask = 0;
+    for (Size i = 0; i < k_width; i++) {
+      mask |= Uint32{m_control[i] == _hash} << i;
+    }
+    return mask;
+  }
+
+  RX_HINT_FORCE_INLINE Uint32 FlatMapGroup::match_empty() const {
+    return match(k_flat_map_empty);
+  }
+
+  RX_HINT_FORCE_INLINE Uint32 FlatMapGroup::match_empty_or_deleted() const {
+    Uint32 mask = 0;
+    for (Size i = 0; i < k_width; i++) {
+      mask |= Uint32{m_control[i] < k_flat_map_sentinel} << i;
+    }
+    return mask;
+  }
+#endif
+} // namespace detail
+
+// # Flat Map
+//
+// An unordered flat map using open addressing with group probing, as in
+// Swiss tables. There is a control byte per slot, containing seven bits of
+// the hash for full slots. Lookups compare a group of 16 control bytes at a
+// time, with SSE2 when available, and only compare keys for control bytes that
+// match. Keys and values are stored together in the same slot.
+//
+// An empty map does not allocate. The load factor is 7/8.
+//
+// Unlike Map, inserting a key which already exists replaces the value.
+//
+// 32-bit: 24 bytes
+// 64-bit: 48 bytes
+template<typename K, typename V>
+struct FlatMap {
+  template<typename Kt, typename Vt, Size E>
+  using Initializers = Array<Pair<Kt, Vt>[E]>;
+
+  constexpr FlatMap();
+  constexpr FlatMap(Memory::Allocator& _allocator);
+  FlatMap(Memory::Allocator& _allocator, const FlatMap& _map);
+  FlatMap(FlatMap&& map_);
+  FlatMap(const FlatMap& _map);
+
+  template<typename Kt, typename Vt, Size E>
+  FlatMap(Memory::Allocator& _allocator, Initializers<Kt, Vt, E>&& initializers_);
+
+  template<typename Kt, typename Vt, Size E>
+  FlatMap(Initializers<Kt, Vt, E>&& initializers_);
+
+  ~FlatMap();
+
+  FlatMap& operator=(FlatMap&& map_);
+  FlatMap& operator=(const FlatMap& _map);
+
+  V* insert(const K& _key, V&& value_);
+  V* insert(const K& _key, const V& _value);
+
+  // Insert with |_hash| being the precomputed Hash<K> of |_key|.
+  V* insert(const K& _key, Size _hash, V&& value_);
+  V* insert(const K& _key, Size _hash, const V& _value);
+
+  V* find(const K& _key);
+  const V* find(const K& _key) const;
+
+  // Lookup with a key of another type, see is_heterogeneous_key.
+  template<typename U, typename = traits::enable_if<is_heterogeneous_key<K, U>>>
+  V* find(const U& _key);
+  template<typename U, typename = traits::enable_if<is_heterogeneous_key<K, U>>>
+  const V* find(const U& _key) const;
+
+  // Lookup with |_hash| being the precomputed Hash<K> of |_key|. The type of
+  // |_key| need only compare equal with |K|.
+  template<typename U>
+  V* find(const U& _key, Size _hash);
+  template<typename U>
+  const V* find(const U& _key, Size _hash) const;
+
+  bool erase(const K& _key);
+
+  template<typename U, typename = traits::enable_if<is_heterogeneous_key<K, U>>>
+  bool erase(const U& _key);
+  template<typename U>
+  bool erase(const U& _key, Size _hash);
+
+  Size size() const;
+  bool is_empty() const;
+
+  // Make room for |_size| elements without growing.
+  [[nodiscard]] bool reserve(Size _size);
+
+  void clear();
+
+  template<typename F>
+  bool each_key(F&& _function);
+  template<typename F>
+  bool each_key(F&& _function) const;
+
+  template<typename F>
+  bool each_value(F&& _function);
+  template<typename F>
+  bool each_value(F&& _function) const;
+
+  template<typename F>
+  bool each_pair(F&& _function);
+  template<typename F>
+  bool each_pair(F&& _function) const;
+
+  constexpr Memory::Allocator& allocator() const;
+
+private:
+  using Group = detail::FlatMapGroup;
+  using Slot = Pair<K, V>;
+
+  static Size hash_key(const K& _key);
+  static Size h1(Size _hash);
+  static Sint8 h2(Size _hash);
+  static bool is_full(Sint8 _control);
+  static Size capacity_to_growth(Size _capacity);
+
+  void clear_and_deallocate();
+
+  [[nodiscard]] bool resize(Size _capacity);
+  [[nodiscard]] bool grow();
+
+  void set_control(Size _index, Sint8 _control);
+  Size find_first_non_full(Size _hash) const;
+  template<typename U>
+  bool lookup_index(const U& _key, Size _hash, Size& index_) const;
+
+  void erase_index(Size _index);
+
+  template<typename Kt, typename Vt>
+  V* inserter(Size _hash, Kt&& key_, Vt&& value_);
+
+  template<typename F>
+  bool each_slot(F&& _function) const;
+
+  Memory::Allocator* m_allocator;
+  Sint8* m_control;
+  Slot* m_slots;
+
+  Size m_size;
+  Size m_capacity;
+  Size m_growth_left;
+};
+
+template<typename K, typename V>
+inline constexpr FlatMap<K, V>::FlatMap()
+  : FlatMap{Memory::SystemAllocator::instance()}
+{
+}
+
+template<typename K, typename V>
+inline constexpr FlatMap<K, V>::FlatMap(Memory::Allocator& _allocator)
+  : m_allocator{&_allocator}
+  , m_control{const_cast<Sint8*>(detail::k_flat_map_empty_group)}
+  , m_slots{nullptr}
+  , m_size{0}
+  , m_capacity{0}
+  , m_growth_left{0}
+{
+}
+
+template<typename K, typename V>
+inline FlatMap<K, V>::FlatMap(Memory::Allocator& _allocator, const FlatMap& _map)
+  : FlatMap{_allocator}
+{
+  RX_ASSERT(reserve(_map.m_size), "out of memory");
+  _map.each_pair([this](const K& _key, const V& _value) {
+    inserter(hash_key(_key), _key, _value);
+  });
+}
+
+template<typename K, typename V>
+inline FlatMap<K, V>::FlatMap(const FlatMap& _map)
+  : FlatMap{_map.allocator(), _map}
+{
+}
+
+template<typename K, typename V>
+inline FlatMap<K, V>::FlatMap(FlatMap&& map_)
+  : m_allocator{map_.m_allocator}
+  , m_control{Utility::exchange(map_.m_control, const_cast<Sint8*>(detail::k_flat_map_empty_group))}
+  , m_slots{Utility::exchange(map_.m_slots, nullptr)}
+  , m_size{Utility::exchange(map_.m_size, 0)}
+  , m_capacity{Utility::exchange(map_.m_capacity, 0)}
+  , m_growth_left{Utility::exchange(map_.m_growth_left, 0)}
+{
+}
+
+template<typename K, typename V>
+template<typename Kt, typename Vt, Size E>
+inline FlatMap<K, V>::FlatMap(Memory::Allocator& _allocator, Initializers<Kt, Vt, E>&& initializers_)
+  : FlatMap{_allocator}
+{
+  RX_ASSERT(reserve(E), "out of memory");
+  for (Size i = 0; i < E; i++) {
+    auto& item = initializers_[i];
+    inserter(hash_key(item.first), Utility::move(item.first), Utility::move(item.second));
+  }
+}
+
+template<typename K, typename V>
+template<typename Kt, typename Vt, Size E>
+inline FlatMap<K, V>::FlatMap(Initializers<Kt, Vt, E>&& initializers_)
+  : FlatMap{Memory::SystemAllocator::instance(), Utility::move(initializers_)}
+{
+}
+
+template<typename K, typename V>
+inline FlatMap<K, V>::~FlatMap() {
+  clear_and_deallocate();
+}
+
+template<typename K, typename V>
+inline FlatMap<K, V>& FlatMap<K, V>::operator=(FlatMap&& map_) {
+  RX_ASSERT(&map_ != this, "self assignment");
+
+  clear_and_deallocate();
+
+  m_allocator = map_.m_allocator;
+  m_control = Utility::exchange(map_.m_control, const_cast<Sint8*>(detail::k_flat_map_empty_group));
+  m_slots = Utility::exchange(map_.m_slots, nullptr);
+  m_size = Utility::exchange(map_.m_size, 0);
+  m_capacity = Utility::exchange(map_.m_capacity, 0);
+  m_growth_left = Utility::exchange(map_.m_growth_left, 0);
+
+  return *this;
+}
+
+template<typename K, typename V>
+inline FlatMap<K, V>& FlatMap<K, V>::operator=(const FlatMap& _map) {
+  RX_ASSERT(&_map != this, "self assignment");
+
+  clear();
+
+  RX_ASSERT(reserve(_map.m_size), "out of memory");
+  _map.each_pair([this](const K& _key, const V& _value) {
+    inserter(hash_key(_key), _key, _value);
+  });
+
+  return *this;
+}
+
+template<typename K, typename V>
+inline V* FlatMap<K, V>::insert(const K& _key, V&& value_) {
+  return inserter(hash_key(_key), _key, Utility::move(value_));
+}
+
+template<typename K, typename V>
+inline V* FlatMap<K, V>::insert(const K& _key, const V& _value) {
+  return inserter(hash_key(_key), _key, _value);
+}
+
+template<typename K, typename V>
+inline V* FlatMap<K, V>::insert(const K& _key, Size _hash, V&& value_) {
+  return inserter(_hash, _key, Utility::move(value_));
+}
+
+template<typename K, typename V>
+inline V* FlatMap<K, V>::insert(const K& _key, Size _hash, const V& _value) {
+  return inserter(_hash, _key, _value);
+}
+
+template<typename K, typename V>
+inline V* FlatMap<K, V>::find(const K& _key) {
+  return find(_key, hash_key(_key));
+}
+
+template<typename K, typename V>
+inline const V* FlatMap<K, V>::find(const K& _key) const {
+  return find(_key, hash_key(_key));
+}
+
+template<typename K, typename V>
+template<typename U, typename>
+inline V* FlatMap<K, V>::find(const U& _key) {
+  return find(_key, _key.hash());
+}
+
+template<typename K, typename V>
+template<typename U, typename>
+inline const V* FlatMap<K, V>::find(const U& _key) const {
+  return find(_key, _key.hash());
+}
+
+template<typename K, typename V>
+template<typename U>
+inline V* FlatMap<K, V>::find(const U& _key, Size _hash) {
+  if (Size index; lookup_index(_key, _hash, index)) {
+    return &m_slots[index].second;
+  }
+  return nullptr;
+}
+
+template<typename K, typename V>
+template<typename U>
+inline const V* FlatMap<K, V>::find(const U& _key, Size _hash) const {
+  if (Size index; lookup_index(_key, _hash, index)) {
+    return &m_slots[index].second;
+  }
+  return nullptr;
+}
+
+template<typename K, typename V>
+inline bool FlatMap<K, V>::erase(const K& _key) {
+  return erase(_key, hash_key(_key));
+}
+
+template<typename K, typename V>
+template<typename U, typename>
+inline bool FlatMap<K, V>::erase(const U& _key) {
+  return erase(_key, _key.hash());
+}
+
+template<typename K, typename V>
+template<typename U>
+inline bool FlatMap<K, V>::erase(const U& _key, Size _hash) {
+  if (Size index; lookup_index(_key, _hash, index)) {
+    erase_index(index);
+    return true;
+  }
+  return false;
+}
+
+template<typename K, typename V>
+inline void FlatMap<K, V>::erase_index(Size _index) {
+  if constexpr (!traits::is_trivially_destructible<Slot>) {
+    Utility::destruct<Slot>(m_slots + _index);
+  }
+
+  // When there was never a full group of slots around |_index| no probe has
+  // gone past it, so it can be marked empty rather than deleted.
+  const Size before_index = (_index - Group::k_width) & (m_capacity - 1);
+  const Uint32 empty_after = Group{m_control + _index}.match_empty();
+  const Uint32 empty_before = Group{m_control + before_index}.match_empty();
+  const Size full_after = bit_search_lsb(empty_after);
+  const Size full_before = empty_before ? 15 - bit_search_msb(empty_before) : 16;
+  const bool was_never_full = empty_after && empty_before
+    && full_after + full_before < Group::k_width;
+
+  if (was_never_full) {
+    set_control(_index, detail::k_flat_map_empty);
+    m_growth_left++;
+  } else {
+    set_control(_index, detail::k_flat_map_deleted);
+  }
+
+  m_size--;
+}
+
+template<typename K, typename V>
+RX_HINT_FORCE_INLINE Size FlatMap<K, V>::size() const {
+  return m_size;
+}
+
+template<typename K, typename V>
+RX_HINT_FORCE_INLINE bool FlatMap<K, V>::is_empty() const {
+  return m_size == 0;
+}
+
+template<typename K, typename V>
+inline bool FlatMap<K, V>::reserve(Size _size) {
+  if (_size <= m_size + m_growth_left) {
+    return true;
+  }
+
+  Size capacity = Group::k_width;
+  while (capacity_to_growth(capacity) < _size) {
+    capacity *= 2;
+  }
+
+  return resize(capacity);
+}
+
+template<typename K, typename V>
+inline void FlatMap<K, V>::clear() {
+  if (m_capacity == 0) {
+    return;
+  }
+
+  if constexpr (!traits::is_trivially_destructible<Slot>) {
+    for (Size i = 0; i < m_capacity; i++) {
+      if (is_full(m_control[i])) {
+        Utility::destruct<Slot>(m_slots + i);
+      }
+    }
+  }
+
+  for (Size i = 0; i < m_capacity + Group::k_width - 1; i++) {
+    m_control[i] = detail::k_flat_map_empty;
+  }
+
+  m_size = 0;
+  m_growth_left = capacity_to_growth(m_capacity);
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool FlatMap<K, V>::each_key(F&& _function) {
+  return each_slot([&](Slot& _slot) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      return _function(_slot.first);
+    } else {
+      _function(_slot.first);
+      return true;
+    }
+  });
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool FlatMap<K, V>::each_key(F&& _function) const {
+  return each_slot([&](const Slot& _slot) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      return _function(_slot.first);
+    } else {
+      _function(_slot.first);
+      return true;
+    }
+  });
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool FlatMap<K, V>::each_value(F&& _function) {
+  return each_slot([&](Slot& _slot) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      return _function(_slot.second);
+    } else {
+      _function(_slot.second);
+      return true;
+    }
+  });
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool FlatMap<K, V>::each_value(F&& _function) const {
+  return each_slot([&](const Slot& _slot) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      return _function(_slot.second);
+    } else {
+      _function(_slot.second);
+      return true;
+    }
+  });
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool FlatMap<K, V>::each_pair(F&& _function) {
+  return each_slot([&](Slot& _slot) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      return _function(_slot.first, _slot.second);
+    } else {
+      _function(_slot.first, _slot.second);
+      return true;
+    }
+  });
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool FlatMap<K, V>::each_pair(F&& _function) const {
+  return each_slot([&](const Slot& _slot) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      return _function(_slot.first, _slot.second);
+    } else {
+      _function(_slot.first, _slot.second);
+      return true;
+    }
+  });
+}
+
+template<typename K, typename V>
+RX_HINT_FORCE_INLINE constexpr Memory::Allocator& FlatMap<K, V>::allocator() const {
+  return *m_allocator;
+}
+
+template<typename K, typename V>
+inline Size FlatMap<K, V>::hash_key(const K& _key) {
+  return Hash<K>{}(_key);
+}
+
+template<typename K, typename V>
+RX_HINT_FORCE_INLINE Size FlatMap<K, V>::h1(Size _hash) {
+  return _hash >> 7;
+}
+
+template<typename K, typename V>
+RX_HINT_FORCE_INLINE Sint8 FlatMap<K, V>::h2(Size _hash) {
+  return static_cast<Sint8>(_hash & 0x7F);
+}
+
+template<typename K, typename V>
+RX_HINT_FORCE_INLINE bool FlatMap<K, V>::is_full(Sint8 _control) {
+  return _control >= 0;
+}
+
+template<typename K, typename V>
+RX_HINT_FORCE_INLINE Size FlatMap<K, V>::capacity_to_growth(Size _capacity) {
+  return _capacity - _capacity / 8;
+}
+
+template<typename K, typename V>
+inline void FlatMap<K, V>::clear_and_deallocate() {
+  clear();
+
+  if (m_capacity) {
+    allocator().deallocate(m_control);
+  }
+}
+
+template<typename K, typename V>
+inline bool FlatMap<K, V>::resize(Size _capacity) {
+  RX_ASSERT(_capacity >= Group::k_width, "too small");
+
+  // The control bytes of the first group are cloned after the last slot so
+  // that a group can be loaded from any slot without wrapping around.
+  Memory::Aggregate aggregate;
+  aggregate.add<Sint8>(_capacity + Group::k_width - 1);
+  aggregate.add<Slot>(_capacity);
+  aggregate.finalize();
+
+  Byte* data = allocator().allocate(aggregate.bytes());
+  if (RX_HINT_UNLIKELY(!data)) {
+    return false;
+  }
+
+  Sint8* old_control = m_control;
+  Slot* old_slots = m_slots;
+  const Size old_capacity = m_capacity;
+
+  m_control = reinterpret_cast<Sint8*>(data + aggregate[0]);
+  m_slots = reinterpret_cast<Slot*>(data + aggregate[1]);
+  m_capacity = _capacity;
+  m_growth_left = capacity_to_growth(_capacity) - m_size;
+
+  for (Size i = 0; i < _capacity + Group::k_width - 1; i++) {
+    m_control[i] = detail::k_flat_map_empty;
+  }
+
+  // Keys are unique so elements can be moved without comparing keys.
+  for (Size i = 0; i < old_capacity; i++) {
+    if (is_full(old_control[i])) {
+      Slot& slot = old_slots[i];
+      const Size hash = hash_key(slot.first);
+      const Size index = find_first_non_full(hash);
+      set_control(index, h2(hash));
+      Utility::construct<Slot>(m_slots + index, Utility::move(slot));
+      if constexpr (!traits::is_trivially_destructible<Slot>) {
+        Utility::destruct<Slot>(&slot);
+      }
+    }
+  }
+
+  if (old_capacity) {
+    allocator().deallocate(old_control);
+  }
+
+  return true;
+}
+
+template<typename K, typename V>
+inline bool FlatMap<K, V>::grow() {
+  if (m_capacity == 0) {
+    return resize(Group::k_width);
+  }
+
+  // When most of the growth was taken by deleted slots, rehash in place to
+  // drop them rather than growing.
+  if (m_size <= capacity_to_growth(m_capacity) / 2) {
+    return resize(m_capacity);
+  }
+
+  return resize(m_capacity * 2);
+}
+
+template<typename K, typename V>
+RX_HINT_FORCE_INLINE void FlatMap<K, V>::set_control(Size _index, Sint8 _control) {
+  m_control[_index] = _control;
+  // Mirror the control bytes of the first group into the clone.
+  m_control[((_index - (Group::k_width - 1)) & (m_capacity - 1)) + (Group::k_width - 1)] = _control;
+}
+
+// Probing visits groups at triangular offsets from |h1|, with a power of two
+// capacity this visits every group.
+template<typename K, typename V>
+inline Size FlatMap<K, V>::find_first_non_full(Size _hash) const {
+  const Size mask = m_capacity - 1;
+  Size position = h1(_hash) & mask;
+  for (Size stride = Group::k_width; ; stride += Group::k_width) {
+    if (const Uint32 match = Group{m_control + position}.match_empty_or_deleted()) {
+      return (position + bit_search_lsb(match)) & mask;
+    }
+    position = (position + stride) & mask;
+  }
+}
+
+template<typename K, typename V>
+template<typename U>
+inline bool FlatMap<K, V>::lookup_index(const U& _key, Size _hash, Size& index_) const {
+  const Sint8 control = h2(_hash);
+
+  // An empty map has a capacity of zero, making the mask zero, which always
+  // loads the static empty group.
+  const Size mask = m_capacity - (m_capacity != 0);
+  Size position = h1(_hash) & mask;
+  for (Size stride = Group::k_width; ; stride += Group::k_width) {
+    const Group group{m_control + position};
+    for (Uint32 match = group.match(control); match; match &= match - 1) {
+      const Size index = (position + bit_search_lsb(match)) & mask;
+      if (RX_HINT_LIKELY(m_slots[index].first == _key)) {
+        index_ = index;
+        return true;
+      }
+    }
+    if (RX_HINT_LIKELY(group.match_empty())) {
+      return false;
+    }
+    position = (position + stride) & mask;
+  }
+}
+
+template<typename K, typename V>
+template<typename Kt, typename Vt>
+inline V* FlatMap<K, V>::inserter(Size _hash, Kt&& key_, Vt&& value_) {
+  if (Size index; lookup_index(key_, _hash, index)) {
+    V& value = m_slots[index].second;
+    value = Utility::forward<Vt>(value_);
+    return &value;
+  }
+
+  if (RX_HINT_UNLIKELY(m_capacity == 0) && !grow()) {
+    return nullptr;
+  }
+
+  Size index = find_first_non_full(_hash);
+
+  // Reusing a deleted slot does not take any growth.
+  if (RX_HINT_UNLIKELY(m_growth_left == 0 && m_control[index] != detail::k_flat_map_deleted)) {
+    if (!grow()) {
+      return nullptr;
+    }
+    index = find_first_non_full(_hash);
+  }
+
+  m_growth_left -= m_control[index] == detail::k_flat_map_empty;
+  set_control(index, h2(_hash));
+  Utility::construct<Slot>(m_slots + index, Utility::forward<Kt>(key_), Utility::forward<Vt>(value_));
+  m_size++;
+
+  return &m_slots[index].second;
+}
+
+template<typename K, typename V>
+template<typename F>
+inline bool FlatMap<K, V>::each_slot(F&& _function) const {
+  for (Size i = 0; i < m_capacity; i++) {
+    if (is_full(m_control[i]) && !_function(m_slots[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace rx
+
+#endif // RX_CORE_FLAT_MAP_H
@@ -2,6 +2,9 @@
 #define RX_CORE_FUNCTION_H
 #include "rx/core/traits/is_callable.h"
 #include "rx/core/traits/enable_if.h"
+#include "rx/core/traits/remove_cvref.h"
+#include "rx/core/traits/is_trivially_copyable.h"
+#include "rx/core/traits/is_trivially_destructible.h"
 
 #include "rx/core/utility/exchange.h"
 
@@ -9,20 +12,29 @@
 
 namespace Rx {
 
-// 32-bit: 12 bytes
-// 64-bit: 24 bytes
+// Callables that fit in |k_inline_size| bytes are stored inline in the
+// function, larger callables are stored on the allocator. Inline callables
+// which are trivially copyable, and every callable stored on the allocator,
+// are moved with a plain copy of the storage.
+//
+// 32-bit: 64 bytes
+// 64-bit: 64 bytes
 template<typename T>
 struct Function;
 
 template<typename R, typename... Ts>
 struct Function<R(Ts...)> {
+  static inline constexpr const Size k_inline_size = 48;
+
   constexpr Function(Memory::Allocator& _allocator);
   constexpr Function();
 
-  template<typename F, typename = traits::enable_if<traits::is_callable<F, Ts...>>>
+  template<typename F, typename = traits::enable_if<traits::is_callable<traits::remove_cvref<F>, Ts...>
+    && !traits::is_same<traits::remove_cvref<F>, Function>>>
   Function(Memory::Allocator& _allocator, F&& _function);
 
-  template<typename F, typename = traits::enable_if<traits::is_callable<F, Ts...>>>
+  template<typename F, typename = traits::enable_if<traits::is_callable<traits::remove_cvref<F>, Ts...>
+    && !traits::is_same<traits::remove_cvref<F>, Function>>>
   Function(F&& _function);
 
   Function(Memory::Allocator& _allocator, const Function& _function);
@@ -43,65 +55,103 @@ struct Function<R(Ts...)> {
   constexpr Memory::Allocator& allocator() const;
 
 private:
-  enum class Lifetime {
-    k_construct,
-    k_destruct
+  union Storage {
+    constexpr Storage() : heap{nullptr} {}
+    alignas(Memory::Allocator::k_alignment) Byte data[k_inline_size];
+    Byte* heap;
   };
 
-  using InvokeFn = R (*)(const Byte*, Ts&&...);
-  using ModifyLifetimeFn = void (*)(Lifetime, Byte*, const Byte*);
+  using InvokeFn = R (*)(const Storage&, Ts&&...);
+  using CopyFn = void (*)(Memory::Allocator&, Storage&, const Storage&);
+  using MoveFn = void (*)(Storage&, Storage&);
+  using DestroyFn = void (*)(Memory::Allocator&, Storage&);
+
+  // When |move| is nullptr the storage is moved with a plain copy. When
+  // |destroy| is nullptr there's nothing to destroy.
+  struct VTable {
+    InvokeFn invoke;
+    CopyFn copy;
+    MoveFn move;
+    DestroyFn destroy;
+  };
 
   template<typename F>
-  static R invoke(const Byte* _function, Ts&&... _arguments) {
-    if constexpr(traits::is_same<R, void>) {
-      (*reinterpret_cast<const F*>(_function))(Utility::forward<Ts>(_arguments)...);
+  static inline constexpr const bool k_is_inline =
+    sizeof(F) <= k_inline_size && alignof(F) <= Memory::Allocator::k_alignment;
+
+  template<typename F>
+  static F* target(Storage& _storage) {
+    if constexpr (k_is_inline<F>) {
+      return reinterpret_cast<F*>(_storage.data);
     } else {
-      return (*reinterpret_cast<const F*>(_function))(Utility::forward<Ts>(_arguments)...);
+      return reinterpret_cast<F*>(_storage.heap);
     }
   }
 
   template<typename F>
-  static void modify_lifetime(Lifetime _lifetime, Byte* _dst, const Byte* _src) {
-    switch (_lifetime) {
-    case Lifetime::k_construct:
-      Utility::construct<F>(_dst, *reinterpret_cast<const F*>(_src));
-      break;
-    case Lifetime::k_destruct:
-      Utility::destruct<F>(_dst);
-      break;
+  static const F* target(const Storage& _storage) {
+    return target<F>(const_cast<Storage&>(_storage));
+  }
+
+  template<typename F>
+  static R invoke(const Storage& _storage, Ts&&... _arguments) {
+    if constexpr(traits::is_same<R, void>) {
+      (*target<F>(_storage))(Utility::forward<Ts>(_arguments)...);
+    } else {
+      return (*target<F>(_storage))(Utility::forward<Ts>(_arguments)...);
     }
   }
 
-  // Keep control block aligned so the function proceeding it in |m_data| is
-  // always aligned by |k_alignment| too.
-  struct alignas(Memory::Allocator::k_alignment) ControlBlock {
-    constexpr ControlBlock(ModifyLifetimeFn _modify_lifetime, InvokeFn _invoke)
-      : modify_lifetime{_modify_lifetime}
-      , invoke{_invoke}
-    {
+  template<typename F, typename U>
+  static void construct(Memory::Allocator& _allocator, Storage& storage_, U&& _function) {
+    if constexpr (k_is_inline<F>) {
+      Utility::construct<F>(storage_.data, Utility::forward<U>(_function));
+    } else {
+      storage_.heap = reinterpret_cast<Byte*>(_allocator.create<F>(Utility::forward<U>(_function)));
+      RX_ASSERT(storage_.heap, "out of memory");
     }
-    ModifyLifetimeFn modify_lifetime;
-    InvokeFn invoke;
-  };
+  }
+
+  template<typename F>
+  static void copy(Memory::Allocator& _allocator, Storage& dst_, const Storage& _src) {
+    construct<F>(_allocator, dst_, *target<F>(_src));
+  }
+
+  template<typename F>
+  static void move(Storage& dst_, Storage& src_) {
+    Utility::construct<F>(dst_.data, Utility::move(*target<F>(src_)));
+    Utility::destruct<F>(src_.data);
+  }
 
-  void destroy();
+  template<typename F>
+  static void destroy(Memory::Allocator& _allocator, Storage& storage_) {
+    if constexpr (k_is_inline<F>) {
+      Utility::destruct<F>(storage_.data);
+    } else {
+      _allocator.destroy<F>(storage_.heap);
+    }
+  }
 
-  ControlBlock* control();
-  const ControlBlock* control() const;
+  template<typename F>
+  static inline constexpr const VTable k_vtable{
+    &invoke<F>,
+    &copy<F>,
+    k_is_inline<F> && !traits::is_trivially_copyable<F> ? &move<F> : nullptr,
+    k_is_inline<F> && traits::is_trivially_destructible<F> ? nullptr : &destroy<F>
+  };
 
-  Byte* storage();
-  const Byte* storage() const;
+  void release();
+  void relocate(Function& function_);
 
   Memory::Allocator* m_allocator;
-  Byte* m_data;
-  Size m_size;
+  const VTable* m_vtable;
+  Storage m_storage;
 };
 
 template<typename R, typename... Ts>
 inline constexpr Function<R(Ts...)>::Function(Memory::Allocator& _allocator)
   : m_allocator{&_allocator}
-  , m_data{nullptr}
-  , m_size{0}
+  , m_vtable{nullptr}
 {
 }
 
@@ -123,26 +173,18 @@ template<typename F, typename>
 inline Function<R(Ts...)>::Function(Memory::Allocator& _allocator, F&& _function)
   : Function{_allocator}
 {
-  m_size = sizeof(ControlBlock) + sizeof _function;
-  m_data = allocator().allocate(m_size);
-  RX_ASSERT(m_data, "out of memory");
-
-  Utility::construct<ControlBlock>(m_data, &modify_lifetime<F>, &invoke<F>);
-  Utility::construct<F>(storage(), Utility::forward<F>(_function));
+  using Type = traits::remove_cvref<F>;
+  construct<Type>(allocator(), m_storage, Utility::forward<F>(_function));
+  m_vtable = &k_vtable<Type>;
 }
 
 template<typename R, typename... Ts>
 inline Function<R(Ts...)>::Function(Memory::Allocator& _allocator, const Function& _function)
   : Function{_allocator}
 {
-  if (_function.m_data) {
-    m_size = _function.m_size;
-    m_data = allocator().allocate(m_size);
-    RX_ASSERT(m_data, "out of memory");
-
-    // Copy construct the control block and the function.
-    Utility::construct<ControlBlock>(m_data, *_function.control());
-    control()->modify_lifetime(Lifetime::k_construct, storage(), _function.storage());
+  if (_function.m_vtable) {
+    _function.m_vtable->copy(allocator(), m_storage, _function.m_storage);
+    m_vtable = _function.m_vtable;
   }
 }
 
@@ -154,32 +196,20 @@ inline Function<R(Ts...)>::Function(const Function& _function)
 
 template<typename R, typename... Ts>
 inline Function<R(Ts...)>::Function(Function&& function_)
-  : m_allocator{function_.m_allocator}
-  , m_data{Utility::exchange(function_.m_data, nullptr)}
-  , m_size{Utility::exchange(function_.m_size, 0)}
+  : Function{function_.allocator()}
 {
+  relocate(function_);
 }
 
 template<typename R, typename... Ts>
 inline Function<R(Ts...)>& Function<R(Ts...)>::operator=(const Function& _function) {
   RX_ASSERT(&_function != this, "self assignment");
 
-  if (m_data) {
-    control()->modify_lifetime(Lifetime::k_destruct, storage(), nullptr);
-  }
+  release();
 
-  if (_function.m_data) {
-    // Reallocate storage to make function fit.
-    if (_function.m_size > m_size) {
-      m_size = _function.m_size;
-      m_data = allocator().reallocate(m_data, m_size);
-      RX_ASSERT(m_data, "out of memory");
-    }
-    // Copy construct the control block and the function.
-    Utility::construct<ControlBlock>(m_data, *_function.control());
-    control()->modify_lifetime(Lifetime::k_construct, storage(), _function.storage());
-  } else {
-    destroy();
+  if (_function.m_vtable) {
+    _function.m_vtable->copy(allocator(), m_storage, _function.m_storage);
+    m_vtable = _function.m_vtable;
   }
 
   return *this;
@@ -189,46 +219,38 @@ template<typename R, typename... Ts>
 inline Function<R(Ts...)>& Function<R(Ts...)>::operator=(Function&& function_) {
   RX_ASSERT(&function_ != this, "self assignment");
 
-  if (m_data) {
-    control()->modify_lifetime(Lifetime::k_destruct, storage(), nullptr);
-  }
+  release();
 
   m_allocator = function_.m_allocator;
-  m_size = Utility::exchange(function_.m_size, 0);
-  m_data = Utility::exchange(function_.m_data, nullptr);
+  relocate(function_);
 
   return *this;
 }
 
 template<typename R, typename... Ts>
 inline Function<R(Ts...)>& Function<R(Ts...)>::operator=(NullPointer) {
-  if (m_data) {
-    control()->modify_lifetime(Lifetime::k_destruct, storage(), nullptr);
-    destroy();
-  }
+  release();
   return *this;
 }
 
 template<typename R, typename... Ts>
 inline Function<R(Ts...)>::~Function() {
-  if (m_data) {
-    control()->modify_lifetime(Lifetime::k_destruct, storage(), nullptr);
-    destroy();
-  }
+  release();
 }
 
 template<typename R, typename... Ts>
 inline R Function<R(Ts...)>::operator()(Ts... _arguments) const {
+  RX_ASSERT(m_vtable, "empty function");
   if constexpr(traits::is_same<R, void>) {
-    control()->invoke(storage(), Utility::forward<Ts>(_arguments)...);
+    m_vtable->invoke(m_storage, Utility::forward<Ts>(_arguments)...);
   } else {
-    return control()->invoke(storage(), Utility::forward<Ts>(_arguments)...);
+    return m_vtable->invoke(m_storage, Utility::forward<Ts>(_arguments)...);
   }
 }
 
 template<typename R, typename... Ts>
 Function<R(Ts...)>::operator bool() const {
-  return m_size != 0;
+  return m_vtable != nullptr;
 }
 
 template<typename R, typename... Ts>
@@ -237,30 +259,24 @@ RX_HINT_FORCE_INLINE constexpr Memory::Allocator& Function<R(Ts...)>::allocator(
 }
 
 template<typename R, typename... Ts>
-inline void Function<R(Ts...)>::destroy() {
-  allocator().deallocate(m_data);
-  m_data = nullptr;
-  m_size = 0;
-}
-
-template<typename R, typename... Ts>
-RX_HINT_FORCE_INLINE typename Function<R(Ts...)>::ControlBlock* Function<R(Ts...)>::control() {
-  return reinterpret_cast<ControlBlock*>(m_data);
-}
-
-template<typename R, typename... Ts>
-RX_HINT_FORCE_INLINE const typename Function<R(Ts...)>::ControlBlock* Function<R(Ts...)>::control() const {
-  return reinterpret_cast<const ControlBlock*>(m_data);
-}
-
-template<typename R, typename... Ts>
-RX_HINT_FORCE_INLINE Byte* Function<R(Ts...)>::storage() {
-  return m_data + sizeof(ControlBlock);
+inline void Function<R(Ts...)>::release() {
+  if (m_vtable) {
+    if (m_vtable->destroy) {
+      m_vtable->destroy(allocator(), m_storage);
+    }
+    m_vtable = nullptr;
+  }
 }
 
 template<typename R, typename... Ts>
-RX_HINT_FORCE_INLINE const Byte* Function<R(Ts...)>::storage() const {
-  return m_data + sizeof(ControlBlock);
+inline void Function<R(Ts...)>::relocate(Function& function_) {
+  // |function_| is left empty, it's storage does not need to be destroyed.
+  m_vtable = Utility::exchange(function_.m_vtable, nullptr);
+  if (m_vtable && m_vtable->move) {
+    m_vtable->move(m_storage, function_.m_storage);
+  } else {
+    m_storage = function_.m_storage;
+  }
 }
 
 } // namespace rx::core
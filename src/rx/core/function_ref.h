@@ -0,0 +1,69 @@
+#ifndef RX_CORE_FUNCTION_REF_H
+#define RX_CORE_FUNCTION_REF_H
+#include "rx/core/traits/is_callable.h"
+#include "rx/core/traits/is_same.h"
+#include "rx/core/traits/enable_if.h"
+#include "rx/core/traits/remove_cvref.h"
+#include "rx/core/traits/remove_reference.h"
+
+#include "rx/core/utility/forward.h"
+
+#include "rx/core/hints/force_inline.h"
+
+namespace Rx {
+
+// Non-owning reference to a callable. Never allocates and never copies the
+// callable, so it's only valid for as long as the referenced callable is.
+//
+// Use for synchronous callbacks which are not stored, e.g:
+//  void each(FunctionRef<void(Item&&)> _function);
+//
+// 32-bit: 8 bytes
+// 64-bit: 16 bytes
+template<typename T>
+struct FunctionRef;
+
+template<typename R, typename... Ts>
+struct FunctionRef<R(Ts...)> {
+  template<typename F, typename = traits::enable_if<traits::is_callable<traits::remove_cvref<F>, Ts...>
+    && !traits::is_same<traits::remove_cvref<F>, FunctionRef>>>
+  constexpr FunctionRef(F&& _function);
+
+  R operator()(Ts... _arguments) const;
+
+private:
+  using InvokeFn = R (*)(void*, Ts&&...);
+
+  template<typename F>
+  static R invoke(void* _function, Ts&&... _arguments) {
+    if constexpr(traits::is_same<R, void>) {
+      (*reinterpret_cast<F*>(_function))(Utility::forward<Ts>(_arguments)...);
+    } else {
+      return (*reinterpret_cast<F*>(_function))(Utility::forward<Ts>(_arguments)...);
+    }
+  }
+
+  void* m_function;
+  InvokeFn m_invoke;
+};
+
+template<typename R, typename... Ts>
+template<typename F, typename>
+inline constexpr FunctionRef<R(Ts...)>::FunctionRef(F&& _function)
+  : m_function{const_cast<void*>(reinterpret_cast<const void*>(&_function))}
+  , m_invoke{&invoke<traits::remove_reference<F>>}
+{
+}
+
+template<typename R, typename... Ts>
+RX_HINT_FORCE_INLINE R FunctionRef<R(Ts...)>::operator()(Ts... _arguments) const {
+  if constexpr(traits::is_same<R, void>) {
+    m_invoke(m_function, Utility::forward<Ts>(_arguments)...);
+  } else {
+    return m_invoke(m_function, Utility::forward<Ts>(_arguments)...);
+  }
+}
+
+} // namespace rx
+
+#endif // RX_CORE_FUNCTION_REF_H
@@ -1,9 +1,11 @@
-#include <string.h> // strcmp
+#include <string.h> // strcmp, strlen
 #include <stdlib.h> // malloc, free
 
 #include "rx/core/global.h"
 #include "rx/core/log.h"
 
+#include "rx/core/hash/wyhash.h"
+
 #include "rx/core/concurrency/scope_lock.h"
 #include "rx/core/concurrency/spin_lock.h"
 
@@ -13,6 +15,10 @@ RX_LOG("global", logger);
 
 static Concurrency::SpinLock g_lock;
 
+static Size hash_name(const char* _name) {
+  return static_cast<Size>(Hash::wyhash(reinterpret_cast<const Byte*>(_name), strlen(_name)));
+}
+
 // GlobalNode
 void GlobalNode::init_global() {
   const auto flags = m_argument_store.as_tag();
@@ -81,12 +87,8 @@ Byte* GlobalNode::reallocate_arguments(Byte* _existing, Size _size) {
 
 // GlobalGroup
 GlobalNode* GlobalGroup::find(const char* _name) {
-  for (auto node = m_list.enumerate_head(&GlobalNode::m_grouped); node; node.next()) {
-    if (!strcmp(node->name(), _name)) {
-      return node.data();
-    }
-  }
-  return nullptr;
+  return m_table.find(hash_name(_name), &GlobalNode::m_hashed,
+    [_name](const GlobalNode& _node) { return !strcmp(_node.name(), _name); });
 }
 
 void GlobalGroup::init() {
@@ -115,12 +117,8 @@ void GlobalGroup::fini_global() {
 
 // globals
 GlobalGroup* Globals::find(const char* _name) {
-  for (auto group = s_group_list.enumerate_head(&GlobalGroup::m_link); group; group.next()) {
-    if (!strcmp(group->name(), _name)) {
-      return group.data();
-    }
-  }
-  return nullptr;
+  return s_group_table.find(hash_name(_name), &GlobalGroup::m_hashed,
+    [_name](const GlobalGroup& _group) { return !strcmp(_group.name(), _name); });
 }
 
 void Globals::link() {
@@ -130,16 +128,10 @@ void Globals::link() {
   // name as the group.
   Concurrency::ScopeLock lock{g_lock};
   for (auto node = s_node_list.enumerate_head(&GlobalNode::m_ungrouped); node; node.next()) {
-    bool unlinked = true;
-    for (auto group = s_group_list.enumerate_head(&GlobalGroup::m_link); group; group.next()) {
-      if (!strcmp(node->m_group, group->name())) {
-        group->m_list.push(&node->m_grouped);
-        unlinked = false;
-        break;
-      }
-    }
-
-    if (unlinked) {
+    if (GlobalGroup* group = find(node->m_group)) {
+      group->m_list.push(&node->m_grouped);
+      group->m_table.insert(&node->m_hashed, hash_name(node->name()));
+    } else {
       // NOTE(dweiler): If you've hit this code-enforced crash it means there
       // exists an rx::Global<T> that is associated with a group by name which
       // doesn't exist. This can be caused by misnaming the group in the
@@ -170,6 +162,7 @@ void Globals::link(GlobalNode* _node) {
 void Globals::link(GlobalGroup* _group) {
   Concurrency::ScopeLock lock{g_lock};
   s_group_list.push(&_group->m_link);
+  s_group_table.insert(&_group->m_hashed, hash_name(_group->name()));
 }
 
 static GlobalGroup g_group_system{"system"};
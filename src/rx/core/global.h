@@ -2,12 +2,13 @@
 #define RX_CORE_GLOBAL_H
 #include "rx/core/tagged_ptr.h"
 #include "rx/core/intrusive_xor_list.h"
+#include "rx/core/intrusive_hash_table.h"
 #include "rx/core/uninitialized.h"
 
 namespace Rx {
 
-// 32-bit: 24 bytes
-// 64-bit: 48 bytes
+// 32-bit: 32 bytes
+// 64-bit: 64 bytes
 struct alignas(Memory::Allocator::k_alignment) GlobalNode {
   template<typename T, typename... Ts>
   GlobalNode(const char* _group, const char* _name,
@@ -60,7 +61,7 @@ private:
 
   template<Size I, typename F, typename... Rs>
   struct ReadArgument {
-    static auto value(const Arguments<F, Rs...>* _arguments) {
+    static decltype(auto) value(const Arguments<F, Rs...>* _arguments) {
       return ReadArgument<I - 1, Rs...>::value(_arguments);
     }
   };
@@ -71,7 +72,7 @@ private:
     }
   };
   template<Size I, typename F, typename... Rs>
-  static auto argument(const Arguments<F, Rs...>* _arguments) {
+  static decltype(auto) argument(const Arguments<F, Rs...>* _arguments) {
     return ReadArgument<I, F, Rs...>::value(_arguments);
   }
 
@@ -147,6 +148,9 @@ private:
   intrusive_xor_list::Node m_grouped;
   intrusive_xor_list::Node m_ungrouped;
 
+  // Link for the group's table of nodes by name.
+  IntrusiveHashTable::Node m_hashed;
+
   const char* m_group;
   const char* m_name;
 
@@ -154,8 +158,8 @@ private:
     Byte* _argument_store);
 };
 
-// 32-bit: 24 + sizeof(T) bytes
-// 64-bit: 48 + sizeof(T) bytes
+// 32-bit: 32 + sizeof(T) bytes
+// 64-bit: 64 + sizeof(T) bytes
 template<typename T>
 struct Global {
   template<typename... Ts>
@@ -186,8 +190,8 @@ private:
   Uninitialized<T> m_global_store;
 };
 
-// 32-bit: 20 bytes
-// 64-bit: 40 bytes
+// 32-bit: 296 bytes
+// 64-bit: 584 bytes
 struct GlobalGroup {
   GlobalGroup(const char* _name);
 
@@ -213,8 +217,17 @@ private:
   // Nodes for this group. This is constructed after a call to |globals::link|.
   intrusive_xor_list m_list;
 
+  // The same nodes by name. The buckets are part of the group since globals
+  // are linked before any allocator exists.
+  static inline constexpr const Size k_buckets = 64;
+  IntrusiveHashTable::Node* m_buckets[k_buckets];
+  IntrusiveHashTable m_table;
+
   // Link for global linked-list of groups in |globals|.
   intrusive_xor_list::Node m_link;
+
+  // Link for the table of groups by name in |globals|.
+  IntrusiveHashTable::Node m_hashed;
 };
 
 struct Globals {
@@ -237,6 +250,11 @@ private:
   // Global linked-list of groups.
   static inline intrusive_xor_list s_group_list;
 
+  // The same groups by name.
+  static inline constexpr const Size k_group_buckets = 32;
+  static inline IntrusiveHashTable::Node* s_group_buckets[k_group_buckets];
+  static inline IntrusiveHashTable s_group_table{s_group_buckets, k_group_buckets};
+
   // Global linked-list of ungrouped nodes.
   static inline intrusive_xor_list s_node_list;
 };
@@ -255,7 +273,9 @@ inline GlobalNode::GlobalNode(const char* _group, const char* _name,
   if constexpr (sizeof...(Ts) != 0) {
     Byte* argument_store = reallocate_arguments(nullptr, sizeof(Arguments<Ts...>));
     m_argument_store = {argument_store, k_enabled | k_arguments};
-    construct_arguments(m_argument_store.as_ptr(), Utility::forward<Ts>(_arguments)...);
+    // Arguments are stored with the types they were given with so that lvalue
+    // references, such as allocators, are stored as references.
+    construct_arguments<Ts...>(m_argument_store.as_ptr(), Utility::forward<Ts>(_arguments)...);
   } else {
     m_argument_store = {nullptr, k_enabled};
   }
@@ -314,6 +334,8 @@ void GlobalNode::validate_cast_for() const {
 // global_group
 inline GlobalGroup::GlobalGroup(const char* _name)
   : m_name{_name}
+  , m_buckets{}
+  , m_table{m_buckets, k_buckets}
 {
   Globals::link(this);
 }
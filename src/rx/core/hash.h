@@ -3,6 +3,7 @@
 #include "rx/core/types.h"
 
 #include "rx/core/traits/detect.h"
+#include "rx/core/traits/is_same.h"
 #include "rx/core/traits/underlying_type.h"
 
 #include "rx/core/utility/declval.h"
@@ -11,13 +12,15 @@
 
 namespace Rx {
 
-template<typename T>
-struct Hash {
+namespace detail {
   template<typename U>
   using HasHash = decltype(Utility::declval<U>().hash());
+} // namespace detail
 
+template<typename T>
+struct Hash {
   Size operator()(const T& _value) const {
-    if constexpr (traits::detect<T, HasHash>) {
+    if constexpr (traits::detect<T, detail::HasHash>) {
       // The Type has a hash member function we can use.
       return _value.hash();
     } else if constexpr (traits::is_enum<T>) {
@@ -39,14 +42,16 @@ struct Hash<bool> {
   }
 };
 
+// The integer hashes are the finalizers of MurmurHash3, every bit of the input
+// affects every bit of the output.
 template<>
 struct Hash<Uint32> {
   constexpr Size operator()(Uint32 _value) const {
-    _value = (_value ^ 61) ^ (_value >> 16);
-    _value = _value + (_value << 3);
-    _value = _value ^ (_value >> 4);
-    _value = _value * 0x27D4EB2D;
-    _value = _value ^ (_value >> 15);
+    _value ^= _value >> 16;
+    _value *= 0x85ebca6b_u32;
+    _value ^= _value >> 13;
+    _value *= 0xc2b2ae35_u32;
+    _value ^= _value >> 16;
     return static_cast<Size>(_value);
   }
 };
@@ -61,13 +66,11 @@ struct Hash<Sint32> {
 template<>
 struct Hash<Uint64> {
   constexpr Size operator()(Uint64 _value) const {
-    _value = (~_value) + (_value << 21);
-    _value = _value ^ (_value >> 24);
-    _value = (_value + (_value << 3)) + (_value << 8);
-    _value = _value ^ (_value >> 14);
-    _value = (_value + (_value << 2)) + (_value << 4);
-    _value = _value ^ (_value << 28);
-    _value = _value + (_value << 31);
+    _value ^= _value >> 33;
+    _value *= 0xff51afd7ed558ccd_u64;
+    _value ^= _value >> 33;
+    _value *= 0xc4ceb9fe1a85ec53_u64;
+    _value ^= _value >> 33;
     return static_cast<Size>(_value);
   }
 };
@@ -106,8 +109,27 @@ struct Hash<T*> {
   }
 };
 
+// Containers accept heterogeneous keys, types other than the key type |K|
+// which have a hash member function, for lookup. Such a |U| must hash and
+// compare equal the same as |K|.
+template<typename K, typename U>
+inline constexpr const bool is_heterogeneous_key =
+  !traits::is_same<K, U> && traits::detect<U, detail::HasHash>;
+
+// Combine hashes of the members of a composite key. The order of the hashes
+// matters, the result is mixed so that keys which only differ in a single
+// member do not produce nearby hashes.
 inline constexpr Size hash_combine(Size _hash1, Size _hash2) {
-  return _hash1 ^ (_hash2 + 0x9E3779B9 + (_hash1 << 6) + (_hash1 >> 2));
+  if constexpr (sizeof(Size) == 8) {
+    return Hash<Uint64>{}(_hash1 ^ (_hash2 + 0x9e3779b97f4a7c15_u64 + (_hash1 << 6) + (_hash1 >> 2)));
+  } else {
+    return Hash<Uint32>{}(_hash1 ^ (_hash2 + 0x9e3779b9_u32 + (_hash1 << 6) + (_hash1 >> 2)));
+  }
+}
+
+template<typename... Ts>
+inline constexpr Size hash_combine(Size _hash1, Size _hash2, Ts... _hashes) {
+  return hash_combine(hash_combine(_hash1, _hash2), _hashes...);
 }
 
 } // namespace rx
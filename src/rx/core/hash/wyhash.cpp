@@ -0,0 +1,247 @@
+#include <string.h> // memcpy
+
+#include "rx/core/hash/wyhash.h"
+#include "rx/core/config.h" // RX_COMPILER_*, RX_HAS_SSE2
+
+// Without a native 64x64 -> 128-bit multiply the multiply in wyhash is made
+// of four 32-bit multiplies, long keys are faster with the striped path.
+#if defined(__SIZEOF_INT128__) || (defined(RX_COMPILER_MSVC) && defined(_M_X64))
+#define RX_HASH_WIDE_MULTIPLY
+#endif
+
+#if defined(RX_COMPILER_MSVC) && defined(_M_X64)
+#include <intrin.h> // _umul128
+#endif
+
+#if !defined(RX_HASH_WIDE_MULTIPLY) && defined(RX_HAS_SSE2)
+#include <emmintrin.h> // __m128i, _mm_*
+#endif
+
+namespace Rx::Hash {
+
+static constexpr const Uint64 k_primes[]{
+  0xa0761d6478bd642f_u64,
+  0xe7037ed1a0b428db_u64,
+  0x8ebc6af09c88c6e3_u64,
+  0x589965cc75374cc3_u64
+};
+
+static inline void multiply(Uint64& lo_, Uint64& hi_) {
+#if defined(RX_HASH_WIDE_MULTIPLY) && defined(__SIZEOF_INT128__)
+  const unsigned __int128 product =
+    static_cast<unsigned __int128>(lo_) * hi_;
+  lo_ = static_cast<Uint64>(product);
+  hi_ = static_cast<Uint64>(product >> 64);
+#elif defined(RX_HASH_WIDE_MULTIPLY)
+  lo_ = _umul128(lo_, hi_, &hi_);
+#else
+  const Uint64 ha = lo_ >> 32, hb = hi_ >> 32;
+  const Uint64 la = static_cast<Uint32>(lo_), lb = static_cast<Uint32>(hi_);
+  const Uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  const Uint64 t = rl + (rm0 << 32);
+  const Uint64 lo = t + (rm1 << 32);
+  const Uint64 c = (t < rl) + (lo < t);
+  lo_ = lo;
+  hi_ = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline Uint64 mix(Uint64 _a, Uint64 _b) {
+  multiply(_a, _b);
+  return _a ^ _b;
+}
+
+static inline Uint64 read64(const Byte* _data) {
+  Uint64 value;
+  memcpy(&value, _data, sizeof value);
+  return value;
+}
+
+static inline Uint64 read32(const Byte* _data) {
+  Uint32 value;
+  memcpy(&value, _data, sizeof value);
+  return value;
+}
+
+static inline Uint64 read_small(const Byte* _data, Size _size) {
+  return (Uint64{_data[0]} << 16) | (Uint64{_data[_size >> 1]} << 8) | _data[_size - 1];
+}
+
+#if !defined(RX_HASH_WIDE_MULTIPLY)
+// Stripes of 64 bytes are accumulated into eight 64-bit lanes. Each stripe in
+// a block of k_block_stripes uses the key at a different offset into the
+// secret so that the position of a stripe in the block matters.
+static constexpr const Size k_stripe_size = 64;
+static constexpr const Size k_stripe_lanes = k_stripe_size / sizeof(Uint64);
+static constexpr const Size k_block_stripes = 16;
+static constexpr const Size k_secret_lanes = k_block_stripes + k_stripe_lanes;
+static constexpr const Uint64 k_scramble_prime = 0x9e3779b1_u64;
+
+struct Secret {
+  alignas(16) Uint64 lanes[k_secret_lanes];
+};
+
+static constexpr Secret secret() {
+  // Deterministic constants from splitmix64.
+  Secret result{};
+  Uint64 state = 0x9e3779b97f4a7c15_u64;
+  for (Size i = 0; i < k_secret_lanes; i++) {
+    Uint64 z = (state += 0x9e3779b97f4a7c15_u64);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9_u64;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb_u64;
+    result.lanes[i] = z ^ (z >> 31);
+  }
+  return result;
+}
+
+static constexpr const Secret k_secret = secret();
+
+static inline void accumulate(Uint64* acc_, const Byte* _data, const Uint64* _key) {
+#if defined(RX_HAS_SSE2)
+  __m128i* acc = reinterpret_cast<__m128i*>(acc_);
+  for (Size i = 0; i < k_stripe_lanes / 2; i++) {
+    const __m128i data =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(_data) + i);
+    const __m128i key =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(_key) + i);
+    const __m128i data_key = _mm_xor_si128(data, key);
+    // Low 32 bits of each lane times the high 32 bits of the same lane.
+    const __m128i product =
+      _mm_mul_epu32(data_key, _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+    // Adding the data to the neighbouring lane keeps it in the accumulator
+    // when the product is zero.
+    const __m128i swap = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+    acc[i] = _mm_add_epi64(acc[i], _mm_add_epi64(product, swap));
+  }
+#else
+  for (Size i = 0; i < k_stripe_lanes; i++) {
+    const Uint64 data = read64(_data + i * sizeof(Uint64));
+    const Uint64 data_key = data ^ _key[i];
+    acc_[i ^ 1] += data;
+    acc_[i] += (data_key & 0xffffffff_u64) * (data_key >> 32);
+  }
+#endif
+}
+
+static inline void scramble(Uint64* acc_, const Uint64* _key) {
+#if defined(RX_HAS_SSE2)
+  __m128i* acc = reinterpret_cast<__m128i*>(acc_);
+  const __m128i prime = _mm_set1_epi32(static_cast<int>(k_scramble_prime));
+  for (Size i = 0; i < k_stripe_lanes / 2; i++) {
+    const __m128i key =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(_key) + i);
+    __m128i value = _mm_xor_si128(acc[i], _mm_srli_epi64(acc[i], 47));
+    value = _mm_xor_si128(value, key);
+    // 64-bit by 32-bit multiply out of two 32-bit by 32-bit multiplies.
+    const __m128i lo = _mm_mul_epu32(value, prime);
+    const __m128i hi = _mm_mul_epu32(_mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+    acc[i] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+  }
+#else
+  for (Size i = 0; i < k_stripe_lanes; i++) {
+    Uint64 value = acc_[i] ^ (acc_[i] >> 47);
+    value ^= _key[i];
+    acc_[i] = value * k_scramble_prime;
+  }
+#endif
+}
+
+static Uint64 hash_long(const Byte* _data, Size _size, Uint64 _seed) {
+  // Seeding perturbs the secret rather than the accumulators so that the
+  // seed affects every stripe.
+  Secret seeded;
+  const Uint64* key = k_secret.lanes;
+  if (_seed) {
+    for (Size i = 0; i < k_secret_lanes; i++) {
+      seeded.lanes[i] = k_secret.lanes[i] + ((i & 1) ? -_seed : _seed);
+    }
+    key = seeded.lanes;
+  }
+
+  alignas(16) Uint64 acc[k_stripe_lanes]{
+    k_primes[0], k_primes[1], k_primes[2], k_primes[3],
+    k_primes[3], k_primes[2], k_primes[1], k_primes[0]
+  };
+
+  static constexpr const Size k_block_size = k_stripe_size * k_block_stripes;
+  const Size blocks = (_size - 1) / k_block_size;
+  const Byte* data = _data;
+  for (Size i = 0; i < blocks; i++, data += k_block_size) {
+    for (Size j = 0; j < k_block_stripes; j++) {
+      accumulate(acc, data + j * k_stripe_size, key + j);
+    }
+    scramble(acc, key + k_block_stripes);
+  }
+
+  // The remaining full stripes, then the last 64 bytes of the key which may
+  // overlap the previous stripe.
+  const Size stripes = (_size - 1 - blocks * k_block_size) / k_stripe_size;
+  for (Size j = 0; j < stripes; j++) {
+    accumulate(acc, data + j * k_stripe_size, key + j);
+  }
+  accumulate(acc, _data + _size - k_stripe_size, key + k_block_stripes - 1);
+
+  Uint64 result = _size * k_primes[0];
+  for (Size i = 0; i < k_stripe_lanes; i += 2) {
+    result += mix(acc[i] ^ key[i + 1], acc[i + 1] ^ key[i + 2]);
+  }
+
+  return mix(result ^ k_primes[0], _seed ^ k_primes[1]);
+}
+#endif
+
+Uint64 wyhash(const Byte* _data, Size _size, Uint64 _seed) {
+#if !defined(RX_HASH_WIDE_MULTIPLY)
+  if (_size > k_wyhash_long_size) {
+    return hash_long(_data, _size, _seed);
+  }
+#endif
+
+  const Byte* data = _data;
+  Uint64 seed = _seed ^ mix(_seed ^ k_primes[0], k_primes[1]);
+  Uint64 a;
+  Uint64 b;
+  if (_size <= 16) {
+    if (_size >= 4) {
+      const Size middle = (_size >> 3) << 2;
+      a = (read32(data) << 32) | read32(data + middle);
+      b = (read32(data + _size - 4) << 32) | read32(data + _size - 4 - middle);
+    } else if (_size > 0) {
+      a = read_small(data, _size);
+      b = 0;
+    } else {
+      a = 0;
+      b = 0;
+    }
+  } else {
+    Size size = _size;
+    if (size > 48) {
+      Uint64 seed1 = seed;
+      Uint64 seed2 = seed;
+      do {
+        seed = mix(read64(data) ^ k_primes[1], read64(data + 8) ^ seed);
+        seed1 = mix(read64(data + 16) ^ k_primes[2], read64(data + 24) ^ seed1);
+        seed2 = mix(read64(data + 32) ^ k_primes[3], read64(data + 40) ^ seed2);
+        data += 48;
+        size -= 48;
+      } while (size > 48);
+      seed ^= seed1 ^ seed2;
+    }
+
+    while (size > 16) {
+      seed = mix(read64(data) ^ k_primes[1], read64(data + 8) ^ seed);
+      data += 16;
+      size -= 16;
+    }
+
+    a = read64(data + size - 16);
+    b = read64(data + size - 8);
+  }
+
+  a ^= k_primes[1];
+  b ^= seed;
+  multiply(a, b);
+  return mix(a ^ k_primes[0] ^ _size, b ^ k_primes[1]);
+}
+
+} // namespace rx::hash
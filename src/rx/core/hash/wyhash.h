@@ -0,0 +1,29 @@
+#ifndef RX_CORE_HASH_WYHASH_H
+#define RX_CORE_HASH_WYHASH_H
+#include "rx/core/types.h"
+
+// # wyhash
+//
+// A fast 64-bit hash function by Wang Yi built around a 64x64 -> 128-bit
+// multiply, keys longer than 48 bytes are hashed in three independent lanes.
+//
+// On targets without a native 128-bit multiply, keys longer than
+// k_wyhash_long_size bytes are instead reduced in 64-byte stripes by an
+// XXH3-style accumulator which is vectorized with SSE2 when available and
+// produces the same result as it's scalar path.
+//
+// The output does not match the reference implementation of either hash. It
+// does depend on the byte order of the machine, hashes should not be stored.
+//
+// The |_seed| randomizes the hash, keys cannot be chosen to collide without
+// knowing it.
+
+namespace Rx::Hash {
+
+inline constexpr const Size k_wyhash_long_size = 256;
+
+Uint64 wyhash(const Byte* _data, Size _size, Uint64 _seed = 0);
+
+} // namespace rx::hash
+
+#endif // RX_CORE_HASH_WYHASH_H
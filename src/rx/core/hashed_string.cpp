@@ -0,0 +1,46 @@
+#include <string.h> // strlen, memcmp
+
+#include "rx/core/hashed_string.h"
+
+namespace Rx {
+
+HashedString::HashedString(const char* _contents)
+  : HashedString{_contents, strlen(_contents)}
+{
+}
+
+static inline bool compare(const HashedString& _lhs, const String& _rhs) {
+  if (_lhs.size() != _rhs.size()) {
+    return false;
+  }
+  return !memcmp(_lhs.data(), _rhs.data(), _lhs.size());
+}
+
+bool operator==(const HashedString& _lhs, const HashedString& _rhs) {
+  if (_lhs.hash() != _rhs.hash() || _lhs.size() != _rhs.size()) {
+    return false;
+  }
+  return !memcmp(_lhs.data(), _rhs.data(), _lhs.size());
+}
+
+bool operator==(const HashedString& _lhs, const String& _rhs) {
+  return compare(_lhs, _rhs);
+}
+
+bool operator==(const String& _lhs, const HashedString& _rhs) {
+  return compare(_rhs, _lhs);
+}
+
+bool operator!=(const HashedString& _lhs, const HashedString& _rhs) {
+  return !(_lhs == _rhs);
+}
+
+bool operator!=(const HashedString& _lhs, const String& _rhs) {
+  return !compare(_lhs, _rhs);
+}
+
+bool operator!=(const String& _lhs, const HashedString& _rhs) {
+  return !compare(_rhs, _lhs);
+}
+
+} // namespace rx
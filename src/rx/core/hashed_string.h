@@ -0,0 +1,70 @@
+#ifndef RX_CORE_HASHED_STRING_H
+#define RX_CORE_HASHED_STRING_H
+#include "rx/core/string.h"
+
+namespace Rx {
+
+// # Hashed String
+//
+// The idea behind a hashed string is to compute the hash of a string once and
+// carry it along with the string, so that repeated lookups in a Map, Set or
+// FlatMap keyed by String never hash the same contents twice.
+//
+// A hashed string does not own the contents, it's only valid for as long as
+// the contents are. It's hash is the same as String::hash, which makes it a
+// heterogeneous key for containers keyed by String, finding a String key
+// without constructing a String.
+//
+// 32-bit: 12 bytes
+// 64-bit: 24 bytes
+struct HashedString {
+  HashedString(const char* _contents);
+  HashedString(const char* _contents, Size _size);
+  HashedString(const String& _contents);
+
+  constexpr const char* data() const;
+  constexpr Size size() const;
+  constexpr Size hash() const;
+
+private:
+  const char* m_data;
+  Size m_size;
+  Size m_hash;
+};
+
+inline HashedString::HashedString(const char* _contents, Size _size)
+  : m_data{_contents}
+  , m_size{_size}
+  , m_hash{String::hash_of(_contents, _size)}
+{
+}
+
+inline HashedString::HashedString(const String& _contents)
+  : HashedString{_contents.data(), _contents.size()}
+{
+}
+
+inline constexpr const char* HashedString::data() const {
+  return m_data;
+}
+
+inline constexpr Size HashedString::size() const {
+  return m_size;
+}
+
+inline constexpr Size HashedString::hash() const {
+  return m_hash;
+}
+
+// not inlined since it would explode code size
+bool operator==(const HashedString& _lhs, const HashedString& _rhs);
+bool operator==(const HashedString& _lhs, const String& _rhs);
+bool operator==(const String& _lhs, const HashedString& _rhs);
+
+bool operator!=(const HashedString& _lhs, const HashedString& _rhs);
+bool operator!=(const HashedString& _lhs, const String& _rhs);
+bool operator!=(const String& _lhs, const HashedString& _rhs);
+
+} // namespace rx
+
+#endif // RX_CORE_HASHED_STRING_H
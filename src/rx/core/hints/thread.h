@@ -18,6 +18,9 @@
 #define RX_HINT_RELEASE(...) \
   RX_HINT_THREAD_ATTRIBUTE(unlock_function(__VA_ARGS__))
 
+#define RX_HINT_ACQUIRE_SHARED(...) \
+  RX_HINT_THREAD_ATTRIBUTE(shared_lock_function(__VA_ARGS__))
+
 #define RX_HINT_LOCKABLE \
   RX_HINT_THREAD_ATTRIBUTE(lockable)
 
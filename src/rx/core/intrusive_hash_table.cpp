@@ -0,0 +1,43 @@
+#include "rx/core/intrusive_hash_table.h"
+
+namespace Rx {
+
+void IntrusiveHashTable::insert(Node* _node, Size _hash) {
+  Node*& bucket = m_buckets[_hash & (m_capacity - 1)];
+  _node->m_hash = _hash;
+  _node->m_next = bucket;
+  bucket = _node;
+  m_size++;
+}
+
+void IntrusiveHashTable::erase(Node* _node) {
+  for (Node** link = &m_buckets[_node->m_hash & (m_capacity - 1)]; *link; link = &(*link)->m_next) {
+    if (*link == _node) {
+      *link = _node->m_next;
+      _node->m_next = nullptr;
+      m_size--;
+      return;
+    }
+  }
+  RX_ASSERT(false, "node not in table");
+}
+
+void IntrusiveHashTable::rehash(Node** _buckets, Size _capacity) {
+  RX_ASSERT((_capacity & (_capacity - 1)) == 0, "capacity not a power of two");
+
+  for (Size i = 0; i < m_capacity; i++) {
+    for (Node* node = m_buckets[i]; node; ) {
+      Node* next = node->m_next;
+      Node*& bucket = _buckets[node->m_hash & (_capacity - 1)];
+      node->m_next = bucket;
+      bucket = node;
+      node = next;
+    }
+    m_buckets[i] = nullptr;
+  }
+
+  m_buckets = _buckets;
+  m_capacity = _capacity;
+}
+
+} // namespace rx
@@ -0,0 +1,156 @@
+#ifndef RX_CORE_INTRUSIVE_HASH_TABLE_H
+#define RX_CORE_INTRUSIVE_HASH_TABLE_H
+#include "rx/core/types.h"
+#include "rx/core/markers.h"
+#include "rx/core/assert.h"
+
+namespace Rx {
+
+// # Intrusive Hash Table
+//
+// An intrusive hash table with separate chaining.
+//
+// Like all intrusive containers, you must embed the node in your own structure
+// which is called a "link". The node stores the hash of the object and the
+// next node in it's bucket, inserting and erasing never allocates. Lookups
+// compare the hash first and only call the given comparison on a match.
+//
+// The table doesn't own the bucket array either, it's given one at
+// construction and can be moved to a larger one with |rehash|. This makes it
+// usable during static initialization, before any allocator exists, with
+// bucket arrays of static storage. The bucket array must be zero initialized
+// and it's size a power of two.
+//
+// 32-bit: 12 bytes
+// 64-bit: 24 bytes
+struct IntrusiveHashTable {
+  RX_MARK_NO_COPY(IntrusiveHashTable);
+  RX_MARK_NO_MOVE(IntrusiveHashTable);
+
+  struct Node;
+
+  constexpr IntrusiveHashTable(Node** _buckets, Size _capacity);
+
+  void insert(Node* _node, Size _hash);
+  void erase(Node* _node);
+
+  // Finds the object with hash |_hash| which |_compare| returns true for.
+  template<typename T, typename F>
+  T* find(Size _hash, Node T::*_link, F&& _compare) const;
+
+  // Moves every node to |_buckets| of |_capacity|, which then replaces the
+  // current bucket array.
+  void rehash(Node** _buckets, Size _capacity);
+
+  // Calls |_function| with every object, in no particular order.
+  template<typename T, typename F>
+  void each(Node T::*_link, F&& _function) const;
+
+  Size size() const;
+  Size capacity() const;
+  bool is_empty() const;
+
+  // 32-bit: 8 bytes
+  // 64-bit: 16 bytes
+  struct Node {
+    RX_MARK_NO_COPY(Node);
+    RX_MARK_NO_MOVE(Node);
+
+    constexpr Node();
+
+    Size hash() const;
+
+    template<typename T>
+    const T* data(Node T::*_link) const;
+
+    template<typename T>
+    T* data(Node T::*_link);
+
+  private:
+    friend struct IntrusiveHashTable;
+
+    Node* m_next;
+    Size m_hash;
+  };
+
+private:
+  Node** m_buckets;
+  Size m_capacity;
+  Size m_size;
+};
+
+// IntrusiveHashTable
+inline constexpr IntrusiveHashTable::IntrusiveHashTable(Node** _buckets, Size _capacity)
+  : m_buckets{_buckets}
+  , m_capacity{_capacity}
+  , m_size{0}
+{
+}
+
+template<typename T, typename F>
+inline T* IntrusiveHashTable::find(Size _hash, Node T::*_link, F&& _compare) const {
+  for (Node* node = m_buckets[_hash & (m_capacity - 1)]; node; node = node->m_next) {
+    if (node->m_hash == _hash) {
+      T* data = node->data<T>(_link);
+      if (_compare(*data)) {
+        return data;
+      }
+    }
+  }
+  return nullptr;
+}
+
+template<typename T, typename F>
+inline void IntrusiveHashTable::each(Node T::*_link, F&& _function) const {
+  for (Size i = 0; i < m_capacity; i++) {
+    for (Node* node = m_buckets[i]; node; ) {
+      // Read ahead so |_function| may erase the node.
+      Node* next = node->m_next;
+      _function(node->data<T>(_link));
+      node = next;
+    }
+  }
+}
+
+inline Size IntrusiveHashTable::size() const {
+  return m_size;
+}
+
+inline Size IntrusiveHashTable::capacity() const {
+  return m_capacity;
+}
+
+inline bool IntrusiveHashTable::is_empty() const {
+  return m_size == 0;
+}
+
+// IntrusiveHashTable::Node
+inline constexpr IntrusiveHashTable::Node::Node()
+  : m_next{nullptr}
+  , m_hash{0}
+{
+}
+
+inline Size IntrusiveHashTable::Node::hash() const {
+  return m_hash;
+}
+
+template<typename T>
+inline const T* IntrusiveHashTable::Node::data(Node T::*_link) const {
+  const auto this_address = reinterpret_cast<UintPtr>(this);
+  const auto link_offset = &(reinterpret_cast<const volatile T*>(0)->*_link);
+  const auto link_address = reinterpret_cast<UintPtr>(link_offset);
+  return reinterpret_cast<const T*>(this_address - link_address);
+}
+
+template<typename T>
+inline T* IntrusiveHashTable::Node::data(Node T::*_link) {
+  const auto this_address = reinterpret_cast<UintPtr>(this);
+  const auto link_offset = &(reinterpret_cast<const volatile T*>(0)->*_link);
+  const auto link_address = reinterpret_cast<UintPtr>(link_offset);
+  return reinterpret_cast<T*>(this_address - link_address);
+}
+
+} // namespace rx
+
+#endif // RX_CORE_INTRUSIVE_HASH_TABLE_H
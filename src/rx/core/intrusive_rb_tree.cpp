@@ -0,0 +1,280 @@
+#include "rx/core/intrusive_rb_tree.h"
+
+namespace Rx {
+
+// IntrusiveRBTree
+void IntrusiveRBTree::insert_at(Node* _node, Node* _parent, Node** _link) {
+  _node->m_parent = _parent;
+  _node->m_left = nullptr;
+  _node->m_right = nullptr;
+  _node->m_red = true;
+  *_link = _node;
+  m_size++;
+
+  // Restore the invariant that a red node has no red children.
+  for (Node* node = _node; ; ) {
+    Node* parent = node->m_parent;
+    if (!parent) {
+      // The root is always black.
+      node->m_red = false;
+      return;
+    }
+
+    if (!parent->m_red) {
+      return;
+    }
+
+    // The parent is red so it cannot be the root.
+    Node* grandparent = parent->m_parent;
+    Node* uncle = parent == grandparent->m_left
+      ? grandparent->m_right : grandparent->m_left;
+
+    if (uncle && uncle->m_red) {
+      // Push the red up to the grandparent and continue from there.
+      parent->m_red = false;
+      uncle->m_red = false;
+      grandparent->m_red = true;
+      node = grandparent;
+      continue;
+    }
+
+    // Rotate so the red child and parent are on the same side, then rotate
+    // the parent up in place of the grandparent.
+    if (parent == grandparent->m_left) {
+      if (node == parent->m_right) {
+        rotate_left(parent);
+        parent = node;
+      }
+      rotate_right(grandparent);
+    } else {
+      if (node == parent->m_left) {
+        rotate_right(parent);
+        parent = node;
+      }
+      rotate_left(grandparent);
+    }
+
+    parent->m_red = false;
+    grandparent->m_red = true;
+    return;
+  }
+}
+
+void IntrusiveRBTree::erase(Node* _node) {
+  Node* child = nullptr;
+  Node* parent = nullptr;
+  bool red = false;
+
+  if (!_node->m_left || !_node->m_right) {
+    // Splice the node out, it has at most one child to take it's place.
+    child = _node->m_left ? _node->m_left : _node->m_right;
+    parent = _node->m_parent;
+    red = _node->m_red;
+    if (child) {
+      child->m_parent = parent;
+    }
+    replace_child(parent, _node, child);
+  } else {
+    // Replace the node with it's successor, which has no left child, and
+    // splice the successor out of it's old position instead.
+    Node* successor = _node->m_right;
+    while (successor->m_left) {
+      successor = successor->m_left;
+    }
+
+    child = successor->m_right;
+    red = successor->m_red;
+
+    if (successor->m_parent == _node) {
+      parent = successor;
+    } else {
+      parent = successor->m_parent;
+      if (child) {
+        child->m_parent = parent;
+      }
+      parent->m_left = child;
+      successor->m_right = _node->m_right;
+      _node->m_right->m_parent = successor;
+    }
+
+    successor->m_left = _node->m_left;
+    _node->m_left->m_parent = successor;
+    successor->m_parent = _node->m_parent;
+    successor->m_red = _node->m_red;
+    replace_child(_node->m_parent, _node, successor);
+  }
+
+  _node->m_parent = nullptr;
+  _node->m_left = nullptr;
+  _node->m_right = nullptr;
+  m_size--;
+
+  // Removing a black node leaves one path short of a black node.
+  if (!red) {
+    erase_fixup(child, parent);
+  }
+}
+
+void IntrusiveRBTree::erase_fixup(Node* _node, Node* _parent) {
+  Node* node = _node;
+  Node* parent = _parent;
+
+  while (node != m_root && (!node || !node->m_red)) {
+    // The sibling cannot be nullptr since it's side of the parent has at least
+    // one more black node than the side of |node|.
+    if (node == parent->m_left) {
+      Node* sibling = parent->m_right;
+      if (sibling->m_red) {
+        sibling->m_red = false;
+        parent->m_red = true;
+        rotate_left(parent);
+        sibling = parent->m_right;
+      }
+
+      const bool left_red = sibling->m_left && sibling->m_left->m_red;
+      const bool right_red = sibling->m_right && sibling->m_right->m_red;
+      if (!left_red && !right_red) {
+        sibling->m_red = true;
+        node = parent;
+        parent = node->m_parent;
+        continue;
+      }
+
+      if (!right_red) {
+        sibling->m_left->m_red = false;
+        sibling->m_red = true;
+        rotate_right(sibling);
+        sibling = parent->m_right;
+      }
+
+      sibling->m_red = parent->m_red;
+      parent->m_red = false;
+      sibling->m_right->m_red = false;
+      rotate_left(parent);
+    } else {
+      Node* sibling = parent->m_left;
+      if (sibling->m_red) {
+        sibling->m_red = false;
+        parent->m_red = true;
+        rotate_right(parent);
+        sibling = parent->m_left;
+      }
+
+      const bool left_red = sibling->m_left && sibling->m_left->m_red;
+      const bool right_red = sibling->m_right && sibling->m_right->m_red;
+      if (!left_red && !right_red) {
+        sibling->m_red = true;
+        node = parent;
+        parent = node->m_parent;
+        continue;
+      }
+
+      if (!left_red) {
+        sibling->m_right->m_red = false;
+        sibling->m_red = true;
+        rotate_left(sibling);
+        sibling = parent->m_left;
+      }
+
+      sibling->m_red = parent->m_red;
+      parent->m_red = false;
+      sibling->m_left->m_red = false;
+      rotate_right(parent);
+    }
+
+    node = m_root;
+    break;
+  }
+
+  if (node) {
+    node->m_red = false;
+  }
+}
+
+void IntrusiveRBTree::rotate_left(Node* _node) {
+  Node* right = _node->m_right;
+  _node->m_right = right->m_left;
+  if (right->m_left) {
+    right->m_left->m_parent = _node;
+  }
+  right->m_parent = _node->m_parent;
+  replace_child(_node->m_parent, _node, right);
+  right->m_left = _node;
+  _node->m_parent = right;
+}
+
+void IntrusiveRBTree::rotate_right(Node* _node) {
+  Node* left = _node->m_left;
+  _node->m_left = left->m_right;
+  if (left->m_right) {
+    left->m_right->m_parent = _node;
+  }
+  left->m_parent = _node->m_parent;
+  replace_child(_node->m_parent, _node, left);
+  left->m_right = _node;
+  _node->m_parent = left;
+}
+
+void IntrusiveRBTree::replace_child(Node* _parent, Node* _child, Node* _replacement) {
+  if (!_parent) {
+    m_root = _replacement;
+  } else if (_parent->m_left == _child) {
+    _parent->m_left = _replacement;
+  } else {
+    _parent->m_right = _replacement;
+  }
+}
+
+IntrusiveRBTree::Node* IntrusiveRBTree::first() const {
+  Node* node = m_root;
+  while (node && node->m_left) {
+    node = node->m_left;
+  }
+  return node;
+}
+
+IntrusiveRBTree::Node* IntrusiveRBTree::last() const {
+  Node* node = m_root;
+  while (node && node->m_right) {
+    node = node->m_right;
+  }
+  return node;
+}
+
+// IntrusiveRBTree::Node
+IntrusiveRBTree::Node* IntrusiveRBTree::Node::next() const {
+  if (Node* node = m_right) {
+    while (node->m_left) {
+      node = node->m_left;
+    }
+    return node;
+  }
+
+  // Go up until coming from a left child.
+  const Node* node = this;
+  Node* parent = m_parent;
+  while (parent && node == parent->m_right) {
+    node = parent;
+    parent = parent->m_parent;
+  }
+  return parent;
+}
+
+IntrusiveRBTree::Node* IntrusiveRBTree::Node::prev() const {
+  if (Node* node = m_left) {
+    while (node->m_right) {
+      node = node->m_right;
+    }
+    return node;
+  }
+
+  const Node* node = this;
+  Node* parent = m_parent;
+  while (parent && node == parent->m_left) {
+    node = parent;
+    parent = parent->m_parent;
+  }
+  return parent;
+}
+
+} // namespace rx
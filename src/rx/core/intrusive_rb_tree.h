@@ -0,0 +1,234 @@
+#ifndef RX_CORE_INTRUSIVE_RB_TREE_H
+#define RX_CORE_INTRUSIVE_RB_TREE_H
+#include "rx/core/types.h"
+#include "rx/core/markers.h"
+
+#include "rx/core/traits/is_same.h"
+#include "rx/core/traits/return_type.h"
+
+namespace Rx {
+
+// # Intrusive Red-Black Tree
+//
+// An intrusive, ordered, self-balancing binary search tree.
+//
+// Like all intrusive containers, you must embed the node in your own structure
+// which is called a "link". Inserting and erasing never allocates and lookups
+// are O(log n).
+//
+// The tree doesn't know how objects are ordered, every insert and lookup is
+// given a comparison function which returns an integer less than, equal to or
+// greater than zero, like strcmp. Inserts compare two objects, lookups compare
+// a key with an object. Objects that order the same are not inserted twice.
+//
+// 32-bit: 8 bytes
+// 64-bit: 16 bytes
+struct IntrusiveRBTree {
+  RX_MARK_NO_COPY(IntrusiveRBTree);
+  RX_MARK_NO_MOVE(IntrusiveRBTree);
+
+  struct Node;
+
+  constexpr IntrusiveRBTree();
+
+  // Inserts |_node| and returns nullptr, or returns the object which orders
+  // the same as it, leaving the tree unchanged.
+  template<typename T, typename F>
+  T* insert(Node* _node, Node T::*_link, F&& _compare);
+
+  void erase(Node* _node);
+
+  // Finds the object which orders the same as |_key|.
+  template<typename T, typename K, typename F>
+  T* find(const K& _key, Node T::*_link, F&& _compare) const;
+
+  // Finds the first object which doesn't order before |_key|.
+  template<typename T, typename K, typename F>
+  T* lower_bound(const K& _key, Node T::*_link, F&& _compare) const;
+
+  Node* first() const;
+  Node* last() const;
+
+  // Calls |_function| with every object in order, or in reverse order.
+  template<typename T, typename F>
+  bool each_fwd(Node T::*_link, F&& _function) const;
+  template<typename T, typename F>
+  bool each_rev(Node T::*_link, F&& _function) const;
+
+  Size size() const;
+  bool is_empty() const;
+
+  // 32-bit: 16 bytes
+  // 64-bit: 32 bytes
+  struct Node {
+    RX_MARK_NO_COPY(Node);
+    RX_MARK_NO_MOVE(Node);
+
+    constexpr Node();
+
+    // The next or previous node in order, nullptr past either end.
+    Node* next() const;
+    Node* prev() const;
+
+    template<typename T>
+    const T* data(Node T::*_link) const;
+
+    template<typename T>
+    T* data(Node T::*_link);
+
+  private:
+    friend struct IntrusiveRBTree;
+
+    Node* m_parent;
+    Node* m_left;
+    Node* m_right;
+    bool m_red;
+  };
+
+private:
+  // Links |_node| in at |_link| of |_parent| and rebalances.
+  void insert_at(Node* _node, Node* _parent, Node** _link);
+  void erase_fixup(Node* _node, Node* _parent);
+
+  void rotate_left(Node* _node);
+  void rotate_right(Node* _node);
+  void replace_child(Node* _parent, Node* _child, Node* _replacement);
+
+  template<typename F, typename T>
+  static bool call(F& _function, T* _data);
+
+  Node* m_root;
+  Size m_size;
+};
+
+// IntrusiveRBTree
+inline constexpr IntrusiveRBTree::IntrusiveRBTree()
+  : m_root{nullptr}
+  , m_size{0}
+{
+}
+
+template<typename T, typename F>
+inline T* IntrusiveRBTree::insert(Node* _node, Node T::*_link, F&& _compare) {
+  const T* data = _node->data<T>(_link);
+
+  Node* parent = nullptr;
+  Node** link = &m_root;
+  while (*link) {
+    parent = *link;
+    const auto order = _compare(*data, *parent->data<T>(_link));
+    if (order < 0) {
+      link = &parent->m_left;
+    } else if (order > 0) {
+      link = &parent->m_right;
+    } else {
+      return parent->data<T>(_link);
+    }
+  }
+
+  insert_at(_node, parent, link);
+  return nullptr;
+}
+
+template<typename T, typename K, typename F>
+inline T* IntrusiveRBTree::find(const K& _key, Node T::*_link, F&& _compare) const {
+  for (Node* node = m_root; node; ) {
+    T* data = node->data<T>(_link);
+    const auto order = _compare(_key, *data);
+    if (order < 0) {
+      node = node->m_left;
+    } else if (order > 0) {
+      node = node->m_right;
+    } else {
+      return data;
+    }
+  }
+  return nullptr;
+}
+
+template<typename T, typename K, typename F>
+inline T* IntrusiveRBTree::lower_bound(const K& _key, Node T::*_link, F&& _compare) const {
+  T* result = nullptr;
+  for (Node* node = m_root; node; ) {
+    T* data = node->data<T>(_link);
+    if (_compare(_key, *data) <= 0) {
+      result = data;
+      node = node->m_left;
+    } else {
+      node = node->m_right;
+    }
+  }
+  return result;
+}
+
+template<typename T, typename F>
+inline bool IntrusiveRBTree::each_fwd(Node T::*_link, F&& _function) const {
+  for (Node* node = first(); node; ) {
+    // Read ahead so |_function| may erase the node.
+    Node* next = node->next();
+    if (!call(_function, node->data<T>(_link))) {
+      return false;
+    }
+    node = next;
+  }
+  return true;
+}
+
+template<typename T, typename F>
+inline bool IntrusiveRBTree::each_rev(Node T::*_link, F&& _function) const {
+  for (Node* node = last(); node; ) {
+    Node* prev = node->prev();
+    if (!call(_function, node->data<T>(_link))) {
+      return false;
+    }
+    node = prev;
+  }
+  return true;
+}
+
+template<typename F, typename T>
+inline bool IntrusiveRBTree::call(F& _function, T* _data) {
+  if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+    return _function(_data);
+  } else {
+    _function(_data);
+    return true;
+  }
+}
+
+inline Size IntrusiveRBTree::size() const {
+  return m_size;
+}
+
+inline bool IntrusiveRBTree::is_empty() const {
+  return m_size == 0;
+}
+
+// IntrusiveRBTree::Node
+inline constexpr IntrusiveRBTree::Node::Node()
+  : m_parent{nullptr}
+  , m_left{nullptr}
+  , m_right{nullptr}
+  , m_red{false}
+{
+}
+
+template<typename T>
+inline const T* IntrusiveRBTree::Node::data(Node T::*_link) const {
+  const auto this_address = reinterpret_cast<UintPtr>(this);
+  const auto link_offset = &(reinterpret_cast<const volatile T*>(0)->*_link);
+  const auto link_address = reinterpret_cast<UintPtr>(link_offset);
+  return reinterpret_cast<const T*>(this_address - link_address);
+}
+
+template<typename T>
+inline T* IntrusiveRBTree::Node::data(Node T::*_link) {
+  const auto this_address = reinterpret_cast<UintPtr>(this);
+  const auto link_offset = &(reinterpret_cast<const volatile T*>(0)->*_link);
+  const auto link_address = reinterpret_cast<UintPtr>(link_offset);
+  return reinterpret_cast<T*>(this_address - link_address);
+}
+
+} // namespace rx
+
+#endif // RX_CORE_INTRUSIVE_RB_TREE_H
@@ -6,8 +6,14 @@
 
 #include "rx/core/math/floor.h"
 
+#include "rx/core/memory/tagged_allocator.h"
+
 namespace Rx {
 
+// Used for JSON documents that aren't given an allocator.
+static Global<Memory::TaggedAllocator> s_allocator{"allocators", "json",
+  Memory::SystemAllocator::instance(), "json"};
+
 static const char* json_parse_error_to_string(enum json_parse_error_e _error) {
   switch (_error) {
   case json_parse_error_expected_comma_or_closing_bracket:
@@ -91,8 +97,18 @@ JSON::JSON(Memory::Allocator& _allocator, const char* _contents)
 {
 }
 
+JSON::JSON(const char* _contents, Size _length)
+  : JSON{*s_allocator, _contents, _length}
+{
+}
+
 JSON::JSON(const char* _contents)
-  : JSON{Memory::SystemAllocator::instance(), _contents, strlen(_contents)}
+  : JSON{*s_allocator, _contents, strlen(_contents)}
+{
+}
+
+JSON::JSON(const String& _contents)
+  : JSON{*s_allocator, _contents.data(), _contents.size()}
 {
 }
 
@@ -194,6 +210,12 @@ String JSON::as_string_with_allocator(Memory::Allocator& _allocator) const {
   return {_allocator, string->string, string->string_size};
 }
 
+StringView JSON::as_string_view() const {
+  RX_ASSERT(is_string(), "not a string");
+  auto string{reinterpret_cast<struct json_string_s*>(m_value->payload)};
+  return {string->string, string->string_size};
+}
+
 Size JSON::size() const {
   RX_ASSERT(is_array() || is_object(), "not an indexable Type");
   switch (m_value->type) {
@@ -10,6 +10,7 @@
 #include "rx/core/utility/exchange.h"
 
 #include "rx/core/string.h"
+#include "rx/core/string_view.h"
 #include "rx/core/optional.h"
 
 #include "lib/json.h"
@@ -67,6 +68,9 @@ struct JSON {
   String as_string() const;
   String as_string_with_allocator(Memory::Allocator& _allocator) const;
 
+  // View of the string in the document, valid while any JSON refers to it.
+  StringView as_string_view() const;
+
   template<typename T>
   T decode(const T& _default) const;
 
@@ -114,16 +118,6 @@ inline JSON::JSON(Memory::Allocator& _allocator, const String& _contents)
 {
 }
 
-inline JSON::JSON(const char* _contents, Size _length)
-  : JSON{Memory::SystemAllocator::instance(), _contents, _length}
-{
-}
-
-inline JSON::JSON(const String& _contents)
-  : JSON{Memory::SystemAllocator::instance(), _contents.data(), _contents.size()}
-{
-}
-
 inline JSON::JSON(const JSON& _json)
   : m_shared{_json.m_shared->acquire()}
   , m_value{_json.m_value}
@@ -2,14 +2,17 @@
 #include <string.h> // strlen
 
 #include "rx/core/log.h"
-#include "rx/core/ptr.h"
 #include "rx/core/stream.h"
-#include "rx/core/intrusive_list.h"
 
 #include "rx/core/algorithm/max.h"
 
+#include "rx/core/memory/tagged_allocator.h"
+#include "rx/core/memory/pool_allocator.h"
+
+#include "rx/core/concurrency/atomic.h"
 #include "rx/core/concurrency/mutex.h"
 #include "rx/core/concurrency/condition_variable.h"
+#include "rx/core/concurrency/mpsc_queue.h"
 #include "rx/core/concurrency/thread.h"
 
 namespace Rx {
@@ -33,9 +36,12 @@ private:
     k_ready   = 1 << 1
   };
 
+  // Wake up the logging thread every time this many messages are queued.
+  static constexpr const Size k_wakeup_count = 1000;
+
   struct Queue {
     Log* owner;
-    IntrusiveList messages;
+    bool written;
   };
 
   struct Message {
@@ -43,21 +49,29 @@ private:
     Log::Level level;
     time_t time;
     String contents;
-    IntrusiveList::Node link;
   };
 
+  using MessageQueue = Concurrency::MPSCQueue<Message>;
+
   void process(int _thread_id);
 
   void flush_unlocked();
-  void write(Ptr<Message>& message_);
+  void write(Message& message_);
 
   Concurrency::Mutex m_mutex;
   Concurrency::ConditionVariable m_ready_cond;
   Concurrency::ConditionVariable m_wakeup_cond;
 
+  // Messages are queued without taking |m_mutex|. Writing them out holds it,
+  // which keeps to a single thread popping messages at a time.
+  MessageQueue m_messages;
+  Concurrency::Atomic<Size> m_queued;
+
+  // Only changed by the constructor, so finding the queue of a log doesn't
+  // need |m_mutex|. The |written| flags are guarded by it.
+  Vector<Queue> m_queues;
+
   Vector<Stream*> m_streams       RX_HINT_GUARDED_BY(m_mutex);
-  Vector<Queue> m_queues          RX_HINT_GUARDED_BY(m_mutex);
-  Vector<Ptr<Message>> m_messages RX_HINT_GUARDED_BY(m_mutex);
   int m_status                    RX_HINT_GUARDED_BY(m_mutex);
   int m_padding                   RX_HINT_GUARDED_BY(m_mutex);
 
@@ -65,10 +79,19 @@ private:
   Concurrency::Thread m_thread;
 
   static Global<Logger> s_instance;
+
+  // Messages are short-lived, recycle them rather than hitting the heap.
+  static Global<Memory::PoolAllocator> s_message_allocator;
 };
 
 static GlobalGroup g_group_loggers{"loggers"};
 
+static Global<Memory::TaggedAllocator> s_allocator{"allocators", "log",
+  Memory::SystemAllocator::instance(), "log"};
+
+Global<Memory::PoolAllocator> Logger::s_message_allocator{"allocators", "log_messages",
+  *s_allocator, MessageQueue::k_node_size, 256_z};
+
 Global<Logger> Logger::s_instance{"system", "logger"};
 
 static inline const char* string_for_level(Log::Level _level) {
@@ -99,7 +122,11 @@ static inline String string_for_time(time_t _time) {
 }
 
 Logger::Logger()
-  : m_status{k_running}
+  : m_messages{*s_message_allocator}
+  , m_queued{0}
+  , m_queues{*s_allocator}
+  , m_streams{*s_allocator}
+  , m_status{k_running}
   , m_padding{0}
   , m_thread{"logger", [this](int _thread_id) { process(_thread_id); }}
 {
@@ -117,7 +144,7 @@ Logger::Logger()
 
     // Associate a message queue with the logger.
     auto this_log = _node->cast<Log>();
-    m_queues.emplace_back(this_log, IntrusiveList{});
+    m_queues.emplace_back(this_log, false);
 
     // Keep track of the largest logger name.
     const auto length = strlen(this_log->name());
@@ -165,7 +192,13 @@ bool Logger::subscribe(Stream* _stream) {
     return false;
   }
 
-  return m_streams.push_back(_stream);
+  if (!m_streams.push_back(_stream)) {
+    return false;
+  }
+
+  // Messages may have piled up waiting for a stream to write them to.
+  m_wakeup_cond.signal();
+  return true;
 }
 
 bool Logger::unsubscribe(Stream* _stream) {
@@ -178,36 +211,30 @@ bool Logger::unsubscribe(Stream* _stream) {
 }
 
 bool Logger::enqueue(Log* _owner, Log::Level _level, String&& message_) {
-  Concurrency::ScopeLock lock{m_mutex};
-
   const auto index = m_queues.find_if([_owner](const Queue& _queue) {
     return _queue.owner == _owner;
   });
 
-  if (index != -1_z) {
-    auto& this_queue = m_queues[index];
-
-    // Record the message.
-    auto this_message = make_ptr<Message>(Memory::SystemAllocator::instance(),
-                                          &this_queue, _level, time(nullptr), Utility::move(message_),
-                                          IntrusiveList::Node{});
-
-    if (!this_message || !m_messages.emplace_back(Utility::move(this_message))) {
-      return false;
-    }
-
-    // Record the link.
-    this_queue.messages.push_back(&m_messages.last()->link);
+  if (index == -1_z) {
+    return false;
+  }
 
-    // Wakeup logging thread when we have a few messages.
-    if (m_streams.size() && m_messages.size() >= 1000) {
-      m_wakeup_cond.signal();
-    }
+  // Record the message.
+  if (!m_messages.emplace(&m_queues[index], _level, time(nullptr),
+    Utility::move(message_)))
+  {
+    return false;
+  }
 
-    return true;
+  // Wakeup logging thread when we have a few messages. The signal is sent
+  // under the lock, otherwise it could arrive between the logging thread
+  // checking the count and going to sleep and be lost.
+  if (m_queued.fetch_add(1, Concurrency::MemoryOrder::k_relaxed) + 1 == k_wakeup_count) {
+    Concurrency::ScopeLock lock{m_mutex};
+    m_wakeup_cond.signal();
   }
 
-  return false;
+  return true;
 }
 
 void Logger::flush() {
@@ -222,26 +249,45 @@ void Logger::process([[maybe_unused]] int _thread_id) {
   m_ready_cond.wait(locked, [this] { return m_status & k_ready; });
 
   while (m_status & k_running) {
-    // Block until another we're woken up again to flush something.
-    m_wakeup_cond.wait(locked);
+    // Block until there's enough to flush somewhere or we're asked to stop.
+    m_wakeup_cond.wait(locked, [this] {
+      const auto queued = m_queued.load(Concurrency::MemoryOrder::k_relaxed);
+      return (queued >= k_wakeup_count && !m_streams.is_empty())
+        || !(m_status & k_running);
+    });
 
     // Flush the queued contents. Use the unlocked variant since |m_mutex| is
-    // held by |m_wakeup_cond|.
-    flush_unlocked();
+    // held by |m_wakeup_cond|. Keep the messages until there's a stream to
+    // write them to.
+    if (!m_streams.is_empty() || !(m_status & k_running)) {
+      flush_unlocked();
+    }
   }
 }
 
 void Logger::flush_unlocked() {
   // Flush all message entries.
-  m_messages.each_fwd([this](Ptr<Message>& message_) { write(message_); });
-  m_messages.clear();
+  for (Message message{}; m_messages.pop(message); ) {
+    m_queued.fetch_sub(1, Concurrency::MemoryOrder::k_relaxed);
+    write(message);
+  }
+
+  // The queues of the logs which had messages written are now empty. Signal
+  // the flush operation on those logs, to indicate any messages queued up on
+  // them are now all written out.
+  m_queues.each_fwd([](Queue& queue_) {
+    if (queue_.written) {
+      queue_.written = false;
+      queue_.owner->signal_flush();
+    }
+  });
 }
 
-void Logger::write(Ptr<Message>& message_) {
-  auto this_queue = message_->owner;
+void Logger::write(Message& message_) {
+  auto this_queue = message_.owner;
 
   const auto name = this_queue->owner->name();
-  const auto level = string_for_level(message_->level);
+  const auto level = string_for_level(message_.level);
   const auto padding = strlen(name) + strlen(level) + 1; // +1 for '/'
 
   // The streams written to are all binary streams. Handle platform differences
@@ -255,12 +301,12 @@ void Logger::write(Ptr<Message>& message_) {
 
   const auto contents = String::format(
     format,
-    string_for_time(message_->time),
+    string_for_time(message_.time),
     name,
     level,
     m_padding - padding,
     "",
-    message_->contents);
+    message_.contents);
 
   // Send formatted message to each stream.
   m_streams.each_fwd([&contents](Stream* _stream) {
@@ -277,18 +323,10 @@ void Logger::write(Ptr<Message>& message_) {
   RX_ASSERT(result, "failed to flush all streams");
 
   // Signal the write event for the log associated with this message.
-  this_queue->owner->signal_write(message_->level,
-                                  Utility::move(message_->contents));
+  this_queue->owner->signal_write(message_.level,
+                                  Utility::move(message_.contents));
 
-  // Remove the message from the log's queue associated with this message.
-  this_queue->messages.erase(&message_->link);
-
-  // The queue for the log associated with this message is now empty.
-  if (this_queue->messages.is_empty()) {
-    // Signal the flush operation on that log, to indicate any messages
-    // queued up on it are now all written out.
-    this_queue->owner->signal_flush();
-  }
+  this_queue->written = true;
 }
 
 } // anon-namespace
@@ -6,6 +6,7 @@
 #include "rx/core/traits/is_trivially_destructible.h"
 #include "rx/core/traits/return_type.h"
 #include "rx/core/traits/is_same.h"
+#include "rx/core/traits/enable_if.h"
 
 #include "rx/core/utility/swap.h"
 #include "rx/core/utility/pair.h"
@@ -47,10 +48,33 @@ struct Map {
   V* insert(const K& _key, V&& value_);
   V* insert(const K& _key, const V& _value);
 
+  // Insert with |_hash| being the precomputed Hash<K> of |_key|.
+  V* insert(const K& _key, Size _hash, V&& value_);
+  V* insert(const K& _key, Size _hash, const V& _value);
+
   V* find(const K& _key);
   const V* find(const K& _key) const;
 
+  // Lookup with a key of another type, see is_heterogeneous_key.
+  template<typename U, typename = traits::enable_if<is_heterogeneous_key<K, U>>>
+  V* find(const U& _key);
+  template<typename U, typename = traits::enable_if<is_heterogeneous_key<K, U>>>
+  const V* find(const U& _key) const;
+
+  // Lookup with |_hash| being the precomputed Hash<K> of |_key|. The type of
+  // |_key| need only compare equal with |K|.
+  template<typename U>
+  V* find(const U& _key, Size _hash);
+  template<typename U>
+  const V* find(const U& _key, Size _hash) const;
+
   bool erase(const K& _key);
+
+  template<typename U, typename = traits::enable_if<is_heterogeneous_key<K, U>>>
+  bool erase(const U& _key);
+  template<typename U>
+  bool erase(const U& _key, Size _hash);
+
   Size size() const;
   bool is_empty() const;
 
@@ -77,6 +101,7 @@ private:
   void clear_and_deallocate();
 
   static Size hash_key(const K& _key);
+  static Size normalize_hash(Size _hash);
   static bool is_deleted(Size _hash);
 
   Size desired_position(Size _hash) const;
@@ -95,7 +120,10 @@ private:
   V* inserter(Size _hash, const K& _key, const V& _value);
   V* inserter(Size _hash, const K& _key, V&& value_);
 
-  bool lookup_index(const K& _key, Size& _index) const;
+  template<typename U>
+  bool lookup_index(const U& _key, Size _hash, Size& _index) const;
+
+  void erase_index(Size _index);
 
   Memory::Allocator* m_allocator;
 
@@ -268,9 +296,25 @@ inline V* Map<K, V>::insert(const K& _key, const V& _value) {
   return inserter(hash_key(_key), _key, _value);
 }
 
+template<typename K, typename V>
+inline V* Map<K, V>::insert(const K& _key, Size _hash, V&& value_) {
+  if (++m_size >= m_resize_threshold && !grow()) {
+    return nullptr;
+  }
+  return inserter(normalize_hash(_hash), _key, Utility::forward<V>(value_));
+}
+
+template<typename K, typename V>
+inline V* Map<K, V>::insert(const K& _key, Size _hash, const V& _value) {
+  if (++m_size >= m_resize_threshold && !grow()) {
+    return nullptr;
+  }
+  return inserter(normalize_hash(_hash), _key, _value);
+}
+
 template<typename K, typename V>
 V* Map<K, V>::find(const K& _key) {
-  if (Size index; lookup_index(_key, index)) {
+  if (Size index; lookup_index(_key, hash_key(_key), index)) {
     return m_values + index;
   }
   return nullptr;
@@ -278,7 +322,37 @@ V* Map<K, V>::find(const K& _key) {
 
 template<typename K, typename V>
 const V* Map<K, V>::find(const K& _key) const {
-  if (Size index; lookup_index(_key, index)) {
+  if (Size index; lookup_index(_key, hash_key(_key), index)) {
+    return m_values + index;
+  }
+  return nullptr;
+}
+
+template<typename K, typename V>
+template<typename U, typename>
+inline V* Map<K, V>::find(const U& _key) {
+  return find(_key, _key.hash());
+}
+
+template<typename K, typename V>
+template<typename U, typename>
+inline const V* Map<K, V>::find(const U& _key) const {
+  return find(_key, _key.hash());
+}
+
+template<typename K, typename V>
+template<typename U>
+inline V* Map<K, V>::find(const U& _key, Size _hash) {
+  if (Size index; lookup_index(_key, normalize_hash(_hash), index)) {
+    return m_values + index;
+  }
+  return nullptr;
+}
+
+template<typename K, typename V>
+template<typename U>
+inline const V* Map<K, V>::find(const U& _key, Size _hash) const {
+  if (Size index; lookup_index(_key, normalize_hash(_hash), index)) {
     return m_values + index;
   }
   return nullptr;
@@ -286,26 +360,47 @@ const V* Map<K, V>::find(const K& _key) const {
 
 template<typename K, typename V>
 inline bool Map<K, V>::erase(const K& _key) {
-  if (Size index; lookup_index(_key, index)) {
-    if constexpr (!traits::is_trivially_destructible<K>) {
-      Utility::destruct<K>(m_keys + index);
-    }
-    if constexpr (!traits::is_trivially_destructible<V>) {
-      Utility::destruct<V>(m_values + index);
-    }
+  if (Size index; lookup_index(_key, hash_key(_key), index)) {
+    erase_index(index);
+    return true;
+  }
+  return false;
+}
 
-    if constexpr (sizeof index == 8) {
-      element_hash(index) |= 0x8000000000000000;
-    } else {
-      element_hash(index) |= 0x80000000;
-    }
+template<typename K, typename V>
+template<typename U, typename>
+inline bool Map<K, V>::erase(const U& _key) {
+  return erase(_key, _key.hash());
+}
 
-    m_size--;
+template<typename K, typename V>
+template<typename U>
+inline bool Map<K, V>::erase(const U& _key, Size _hash) {
+  if (Size index; lookup_index(_key, normalize_hash(_hash), index)) {
+    erase_index(index);
     return true;
   }
   return false;
 }
 
+template<typename K, typename V>
+inline void Map<K, V>::erase_index(Size _index) {
+  if constexpr (!traits::is_trivially_destructible<K>) {
+    Utility::destruct<K>(m_keys + _index);
+  }
+  if constexpr (!traits::is_trivially_destructible<V>) {
+    Utility::destruct<V>(m_values + _index);
+  }
+
+  if constexpr (sizeof _index == 8) {
+    element_hash(_index) |= 0x8000000000000000;
+  } else {
+    element_hash(_index) |= 0x80000000;
+  }
+
+  m_size--;
+}
+
 template<typename K, typename V>
 inline Size Map<K, V>::size() const {
   return m_size;
@@ -318,7 +413,12 @@ inline bool Map<K, V>::is_empty() const {
 
 template<typename K, typename V>
 inline Size Map<K, V>::hash_key(const K& _key) {
-  auto hash_value{Hash<K>{}(_key)};
+  return normalize_hash(Hash<K>{}(_key));
+}
+
+template<typename K, typename V>
+inline Size Map<K, V>::normalize_hash(Size _hash) {
+  auto hash_value{_hash};
 
   // MSB is used to indicate deleted elements
   if constexpr(sizeof hash_value == 8) {
@@ -478,8 +578,9 @@ inline V* Map<K, V>::inserter(Size _hash, const K& _key, const V& _value) {
 }
 
 template<typename K, typename V>
-inline bool Map<K, V>::lookup_index(const K& _key, Size& _index) const {
-  const Size hash{hash_key(_key)};
+template<typename U>
+inline bool Map<K, V>::lookup_index(const U& _key, Size _hash, Size& _index) const {
+  const Size hash{_hash};
   Size position{desired_position(hash)};
   Size distance{0};
   for (;;) {
@@ -1,7 +1,6 @@
-#include <string.h> // memmove
+#include <string.h> // memcpy
 
 #include "rx/core/memory/bump_point_allocator.h"
-#include "rx/core/concurrency/scope_lock.h"
 
 #include "rx/core/hints/likely.h"
 #include "rx/core/hints/unlikely.h"
@@ -13,8 +12,8 @@ namespace Rx::Memory {
 BumpPointAllocator::BumpPointAllocator(Byte* _data, Size _size)
   : m_size{_size}
   , m_data{_data}
-  , m_this_point{m_data}
-  , m_last_point{m_data}
+  , m_this_point{0}
+  , m_last_point{0}
 {
   RX_ASSERT(_data, "no memory supplied");
 
@@ -23,90 +22,111 @@ BumpPointAllocator::BumpPointAllocator(Byte* _data, Size _size)
     "_data not aligned on k_alignment boundary");
   RX_ASSERT(m_size % k_alignment == 0,
     "_size not a multiple of k_alignment");
-}
 
-Byte* BumpPointAllocator::allocate(Size _size) {
-  Concurrency::ScopeLock locked{m_lock};
-  return allocate_unlocked(_size);
+  // Offsets of the last allocation are packed into 32 bits each.
+  RX_ASSERT(m_size / k_alignment <= 0xFFFFFFFF_u64, "_size too large");
 }
 
-Byte* BumpPointAllocator::allocate_unlocked(Size _size) {
+Byte* BumpPointAllocator::allocate(Size _size) {
   // Round |_size| to a multiple of k_alignment to keep all pointers
   // aligned by k_alignment.
   _size = Allocator::round_to_alignment(_size);
 
-  // Check for available space for the allocation.
-  if (RX_HINT_UNLIKELY(m_this_point + _size >= m_data + m_size)) {
-    return nullptr;
-  }
-
-  // Backup the last point to make deallocation and reallocation possible.
-  m_last_point = m_this_point;
+  // Bump the point along by the rounded allocation size. The point is only
+  // moved when the allocation fits, an allocation that doesn't fit must not
+  // make concurrent ones that do fit fail.
+  Size offset = m_this_point.load(Concurrency::MemoryOrder::k_relaxed);
+  do {
+    // Check for available space for the allocation.
+    if (RX_HINT_UNLIKELY(_size > m_size - offset)) {
+      return nullptr;
+    }
+  } while (!m_this_point.compare_exchange_weak(offset, offset + _size,
+    Concurrency::MemoryOrder::k_relaxed, Concurrency::MemoryOrder::k_relaxed));
 
-  // Bump the point along by the rounded allocation size.
-  m_this_point += _size;
+  // Remember this allocation to make deallocation and reallocation possible.
+  // This is only a hint, when another thread allocates concurrently it may be
+  // stale, which is caught by the compare-and-swap in reallocate and
+  // deallocate.
+  m_last_point.store(pack(offset, offset + _size), Concurrency::MemoryOrder::k_relaxed);
 
-  return m_last_point;
+  return m_data + offset;
 }
 
 Byte* BumpPointAllocator::reallocate(void* _data, Size _size) {
-  if (RX_HINT_LIKELY(_data)) {
-    Concurrency::ScopeLock locked{m_lock};
-
-    // Round |_size| to a multiple of k_alignment to keep all pointers
-    // aligned by k_alignment.
-    _size = Allocator::round_to_alignment(_size);
+  if (RX_HINT_UNLIKELY(!_data)) {
+    return allocate(_size);
+  }
 
-    // Can only reallocate in-place provided |_data| is the address of |m_last_point|,
-    // i.e it's the most recently allocated.
-    if (RX_HINT_LIKELY(_data == m_last_point)) {
-      // Check for available space for the allocation.
-      if (RX_HINT_UNLIKELY(m_last_point + _size >= m_data + m_size)) {
-        // Out of memory.
-        return nullptr;
-      }
+  // Round |_size| to a multiple of k_alignment to keep all pointers
+  // aligned by k_alignment.
+  _size = Allocator::round_to_alignment(_size);
 
-      // Bump the pointer along by the last point and new size.
-      m_this_point = m_last_point + _size;
+  const Size offset = static_cast<Size>(reinterpret_cast<Byte*>(_data) - m_data);
 
-      return static_cast<Byte*>(_data);
-    } else if (Byte* data = allocate_unlocked(_size)) {
-      // This path is hit when resizing an allocation which isn't the last thing
-      // allocated.
-      //
-      // We cannot tell how many bytes the original allocation was exactly as
-      // there's no metadata describing it. Regardless, it's safe to copy past
-      // the original allocation, potentially into another one, or ourselves,
-      // as such copy represents uninitialized memory to the caller anyways.
-      //
-      // However, since it's possible for the copy to land into ourselves, we
-      // cannot use memcpy here, use memmove instead.
-      memmove(data, _data, _size);
-      return data;
-    } else {
+  // Can only reallocate in-place provided |_data| is the most recent allocation
+  // and nothing has been allocated since, i.e the bump point is still the end
+  // of it.
+  const Uint64 last = m_last_point.load(Concurrency::MemoryOrder::k_relaxed);
+  if (RX_HINT_LIKELY(unpack_begin(last) == offset)) {
+    // Check for available space for the allocation.
+    if (RX_HINT_UNLIKELY(_size > m_size - offset)) {
       // Out of memory.
       return nullptr;
     }
+
+    Size expected = unpack_end(last);
+    if (m_this_point.compare_exchange_strong(expected, offset + _size,
+      Concurrency::MemoryOrder::k_relaxed, Concurrency::MemoryOrder::k_relaxed))
+    {
+      m_last_point.store(pack(offset, offset + _size), Concurrency::MemoryOrder::k_relaxed);
+      return static_cast<Byte*>(_data);
+    }
+  }
+
+  // This path is hit when resizing an allocation which isn't the last thing
+  // allocated.
+  //
+  // We cannot tell how many bytes the original allocation was exactly as
+  // there's no metadata describing it. It cannot extend past the beginning of
+  // the new allocation though, since that was the bump point, so the copy is
+  // bounded by it. The copy never overlaps the new allocation either.
+  //
+  // Within that bound the copy may still read past the original allocation,
+  // into allocations made after it, possibly by other threads which are
+  // writing to them concurrently. This is harmless: those bytes represent
+  // uninitialized memory to the caller, whatever is read is never used, and
+  // the only memory written is the new allocation, which no other thread can
+  // have yet.
+  if (Byte* data = allocate(_size)) {
+    const Size owned = static_cast<Size>(data - static_cast<Byte*>(_data));
+    memcpy(data, _data, _size < owned ? _size : owned);
+    return data;
   }
 
-  return allocate(_size);
+  // Out of memory.
+  return nullptr;
 }
 
 void BumpPointAllocator::deallocate(void* _data) {
-  Concurrency::ScopeLock locked{m_lock};
+  if (RX_HINT_UNLIKELY(!_data)) {
+    return;
+  }
 
-  // Can only deallocate provided |_data| is the address of |m_last_point|,
-  // i.e it's the most recently allocated or reallocated.
-  if (RX_HINT_LIKELY(_data == m_last_point)) {
-    m_this_point = m_last_point;
+  // Can only deallocate provided |_data| is the most recent allocation or
+  // reallocation and nothing has been allocated since.
+  const Size offset = static_cast<Size>(reinterpret_cast<Byte*>(_data) - m_data);
+  const Uint64 last = m_last_point.load(Concurrency::MemoryOrder::k_relaxed);
+  if (RX_HINT_LIKELY(unpack_begin(last) == offset)) {
+    Size expected = unpack_end(last);
+    m_this_point.compare_exchange_strong(expected, offset,
+      Concurrency::MemoryOrder::k_relaxed, Concurrency::MemoryOrder::k_relaxed);
   }
 }
 
 void BumpPointAllocator::reset() {
-  Concurrency::ScopeLock locked{m_lock};
-
-  m_this_point = m_data;
-  m_last_point = m_data;
+  m_this_point.store(0, Concurrency::MemoryOrder::k_relaxed);
+  m_last_point.store(0, Concurrency::MemoryOrder::k_relaxed);
 }
 
 } // namespace rx::memory
@@ -1,7 +1,7 @@
 #ifndef RX_CORE_MEMORY_BUMP_POINT_ALLOCATOR_H
 #define RX_CORE_MEMORY_BUMP_POINT_ALLOCATOR_H
 #include "rx/core/memory/allocator.h"
-#include "rx/core/concurrency/spin_lock.h"
+#include "rx/core/concurrency/atomic.h"
 
 namespace Rx::Memory {
 
@@ -19,6 +19,14 @@ namespace Rx::Memory {
 // reallocation and deallocation provided the pointer passed to either is the
 // same as the last pointer returned by a call to allocate.
 //
+// Allocation is lock-free, the bump is a compare-and-swap of the bump point
+// so multiple threads can carve scratch memory out of the same allocator
+// concurrently. The point is never moved by an allocation that doesn't fit.
+// The bounds of the most recent allocation are kept as a hint, reallocation
+// and deallocation of it is a compare-and-swap of the bump point that only
+// succeeds when nothing was allocated after it. When that fails, reallocation
+// falls back to a new allocation and deallocation does nothing.
+//
 // The purpose of this allocator is to provide a very quick, linear burn
 // scratch space to allocate shortly-lived objects and to reset.
 struct BumpPointAllocator
@@ -32,6 +40,7 @@ struct BumpPointAllocator
   virtual Byte* reallocate(void* _data, Size _size);
   virtual void deallocate(void* data);
 
+  // NOTE: Not safe to call while other threads allocate.
   void reset();
 
   Size used() const;
@@ -39,19 +48,36 @@ struct BumpPointAllocator
   Size available() const;
 
 private:
-  Byte* allocate_unlocked(Size _size);
+  // The last allocation is packed as two offsets from |m_data| in units of
+  // k_alignment, the beginning in the upper 32 bits and the end in the lower.
+  static constexpr Uint64 pack(Size _begin, Size _end);
+  static constexpr Size unpack_begin(Uint64 _last);
+  static constexpr Size unpack_end(Uint64 _last);
 
   Size m_size;
   Byte* m_data;
 
-  Concurrency::SpinLock m_lock;
-
-  Byte* m_this_point RX_HINT_GUARDED_BY(m_lock);
-  Byte* m_last_point RX_HINT_GUARDED_BY(m_lock);
+  // Offset from |m_data| in bytes of the next allocation, never exceeds
+  // |m_size|.
+  Concurrency::Atomic<Size> m_this_point;
+  Concurrency::Atomic<Uint64> m_last_point;
 };
 
+inline constexpr Uint64 BumpPointAllocator::pack(Size _begin, Size _end) {
+  return (static_cast<Uint64>(_begin / k_alignment) << 32_u64)
+    | static_cast<Uint64>(_end / k_alignment);
+}
+
+inline constexpr Size BumpPointAllocator::unpack_begin(Uint64 _last) {
+  return static_cast<Size>(_last >> 32_u64) * k_alignment;
+}
+
+inline constexpr Size BumpPointAllocator::unpack_end(Uint64 _last) {
+  return static_cast<Size>(_last & 0xFFFFFFFF_u64) * k_alignment;
+}
+
 inline Size BumpPointAllocator::used() const {
-  return m_this_point - m_data;
+  return m_this_point.load(Concurrency::MemoryOrder::k_relaxed);
 }
 
 inline Size BumpPointAllocator::size() const {
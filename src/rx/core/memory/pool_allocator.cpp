@@ -0,0 +1,93 @@
+#include "rx/core/memory/pool_allocator.h"
+#include "rx/core/concurrency/scope_lock.h"
+#include "rx/core/hints/unlikely.h"
+#include "rx/core/hints/likely.h"
+#include "rx/core/assert.h"
+
+namespace Rx::Memory {
+
+PoolAllocator::PoolAllocator(Allocator& _allocator, Size _object_size, Size _objects_per_slab)
+  : m_allocator{_allocator}
+  , m_object_size{round_to_alignment(_object_size)}
+  , m_objects_per_slab{_objects_per_slab}
+  , m_slabs{nullptr}
+  , m_free_list{nullptr}
+  , m_this_point{nullptr}
+  , m_end_point{nullptr}
+  , m_statistics{}
+{
+  RX_ASSERT(_object_size, "empty objects");
+  RX_ASSERT(_objects_per_slab, "empty slabs");
+}
+
+PoolAllocator::~PoolAllocator() {
+  for (Node* slab = m_slabs; slab; ) {
+    Node* next = slab->next;
+    m_allocator.deallocate(slab);
+    slab = next;
+  }
+}
+
+Byte* PoolAllocator::allocate(Size _size) {
+  if (RX_HINT_UNLIKELY(_size > m_object_size)) {
+    return nullptr;
+  }
+
+  Concurrency::ScopeLock lock{m_lock};
+
+  // Recycle the most recently deallocated object.
+  if (RX_HINT_LIKELY(m_free_list)) {
+    Node* node = m_free_list;
+    m_free_list = node->next;
+    m_statistics.objects++;
+    return reinterpret_cast<Byte*>(node);
+  }
+
+  if (m_this_point == m_end_point) {
+    // The slab link occupies the first k_alignment bytes of the slab to keep
+    // the objects proceeding it aligned.
+    const Size size = k_alignment + m_object_size * m_objects_per_slab;
+    Byte* slab = m_allocator.allocate(size);
+    if (RX_HINT_UNLIKELY(!slab)) {
+      return nullptr;
+    }
+
+    reinterpret_cast<Node*>(slab)->next = m_slabs;
+    m_slabs = reinterpret_cast<Node*>(slab);
+    m_this_point = slab + k_alignment;
+    m_end_point = slab + size;
+    m_statistics.slabs++;
+  }
+
+  Byte* result = m_this_point;
+  m_this_point += m_object_size;
+  m_statistics.objects++;
+  return result;
+}
+
+Byte* PoolAllocator::reallocate(void* _data, Size _size) {
+  if (RX_HINT_UNLIKELY(!_data)) {
+    return allocate(_size);
+  }
+
+  return _size <= m_object_size ? reinterpret_cast<Byte*>(_data) : nullptr;
+}
+
+void PoolAllocator::deallocate(void* _data) {
+  if (RX_HINT_UNLIKELY(!_data)) {
+    return;
+  }
+
+  Concurrency::ScopeLock lock{m_lock};
+  Node* node = reinterpret_cast<Node*>(_data);
+  node->next = m_free_list;
+  m_free_list = node;
+  m_statistics.objects--;
+}
+
+PoolAllocator::Statistics PoolAllocator::stats() const {
+  Concurrency::ScopeLock lock{m_lock};
+  return m_statistics;
+}
+
+} // namespace rx::memory
@@ -0,0 +1,71 @@
+#ifndef RX_CORE_MEMORY_POOL_ALLOCATOR_H
+#define RX_CORE_MEMORY_POOL_ALLOCATOR_H
+#include "rx/core/memory/allocator.h"
+#include "rx/core/concurrency/spin_lock.h"
+
+namespace Rx::Memory {
+
+// # Pool Allocator
+//
+// The idea behind a pool allocator is to recycle fixed-size objects instead of
+// returning them to the general allocator. Memory is requested from the parent
+// allocator in slabs of |_objects_per_slab| objects. Deallocated objects are
+// put on a free list and handed back out by the next allocation, slabs are only
+// returned to the parent allocator when the pool allocator is destroyed.
+//
+// Only allocations less than or equal to the object size given on construction
+// can be made, larger allocations return nullptr. Reallocation succeeds in-place
+// when the new size fits in an object and fails otherwise.
+//
+// A pool allocator is typically made for a single type, e.g:
+//  static Global<PoolAllocator> s_pool{"allocators", "things", parent, sizeof(Thing), 64};
+//  auto thing = make_ptr<Thing>(*s_pool, ...);
+//
+// The purpose of this allocator is to keep hot, short-lived objects, such as
+// those created with make_ptr, off of the general heap.
+struct PoolAllocator
+  final : Allocator
+{
+  RX_MARK_NO_COPY(PoolAllocator);
+  RX_MARK_NO_MOVE(PoolAllocator);
+
+  PoolAllocator(Allocator& _allocator, Size _object_size, Size _objects_per_slab);
+  ~PoolAllocator();
+
+  virtual Byte* allocate(Size _size);
+  virtual Byte* reallocate(void* _data, Size _size);
+  virtual void deallocate(void* _data);
+
+  struct Statistics {
+    Size slabs;   // Number of slabs allocated from the parent allocator
+    Size objects; // Number of objects currently allocated
+  };
+
+  Statistics stats() const;
+
+  constexpr Size object_size() const;
+
+private:
+  struct Node {
+    Node* next;
+  };
+
+  Allocator& m_allocator;
+  Size m_object_size;
+  Size m_objects_per_slab;
+
+  mutable Concurrency::SpinLock m_lock;
+  Node* m_slabs        RX_HINT_GUARDED_BY(m_lock);
+  Node* m_free_list    RX_HINT_GUARDED_BY(m_lock);
+  Byte* m_this_point   RX_HINT_GUARDED_BY(m_lock);
+  Byte* m_end_point    RX_HINT_GUARDED_BY(m_lock);
+  Statistics m_statistics RX_HINT_GUARDED_BY(m_lock);
+};
+
+inline constexpr Size PoolAllocator::object_size() const {
+  return m_object_size;
+}
+
+} // namespace rx::memory
+
+#endif // RX_CORE_MEMORY_POOL_ALLOCATOR_H
@@ -10,19 +10,20 @@ SystemAllocator::SystemAllocator()
 #else
   : m_stats_allocator{HeapAllocator::instance()}
 #endif
+  , m_tracing_allocator{m_stats_allocator, "system"}
 {
 }
 
 Byte* SystemAllocator::allocate(Size _size) {
-  return m_stats_allocator.allocate(_size);
+  return m_tracing_allocator.allocate(_size);
 }
 
 Byte* SystemAllocator::reallocate(void* _data, Size _size) {
-  return m_stats_allocator.reallocate(_data, _size);
+  return m_tracing_allocator.reallocate(_data, _size);
 }
 
 void SystemAllocator::deallocate(void* _data) {
-  return m_stats_allocator.deallocate(_data);
+  return m_tracing_allocator.deallocate(_data);
 }
 
 Global<SystemAllocator> SystemAllocator::s_instance{"system", "allocator"};
@@ -1,6 +1,7 @@
 #ifndef RX_CORE_MEMORY_SYSTEM_ALLOCATOR_H
 #define RX_CORE_MEMORY_SYSTEM_ALLOCATOR_H
 #include "rx/core/memory/stats_allocator.h"
+#include "rx/core/memory/tracing_allocator.h"
 
 #include "rx/core/global.h"
 
@@ -12,6 +13,9 @@ namespace Rx::Memory {
 // allocator to track global system allocations. When something isn't provided
 // an allocator, this is the allocator used. More specifically, the global
 // g_system_allocator is used.
+//
+// Allocations are also routed through a tracing allocator tagged "system" so
+// they can be traced with TracingAllocator::start.
 struct SystemAllocator
   final : Allocator
 {
@@ -27,6 +31,7 @@ struct SystemAllocator
 
 private:
   StatsAllocator m_stats_allocator;
+  TracingAllocator m_tracing_allocator;
 
   static Global<SystemAllocator> s_instance;
 };
@@ -0,0 +1,182 @@
+#include "rx/core/memory/tagged_allocator.h"
+#include "rx/core/memory/tracing_allocator.h"
+#include "rx/core/concurrency/scope_lock.h"
+#include "rx/core/concurrency/spin_lock.h"
+#include "rx/core/hints/unlikely.h"
+#include "rx/core/global.h"
+
+namespace Rx::Memory {
+
+// Subsystem allocators are globals in this group. It's initialized right after
+// the system allocator and finalized right before it.
+static GlobalGroup g_group_allocators{"allocators"};
+
+static Concurrency::SpinLock g_lock;
+static TaggedAllocator* g_head RX_HINT_GUARDED_BY(g_lock);
+
+// The size of the allocation is stored in the k_alignment bytes in front of
+// it, this keeps the returned pointer aligned.
+struct Header {
+  Size size;
+};
+
+static_assert(sizeof(Header) <= Allocator::k_alignment,
+  "header does not fit in alignment");
+
+TaggedAllocator::TaggedAllocator(TaggedAllocator& _parent, const char* _name, Size _budget)
+  : TaggedAllocator{_parent, &_parent, _name, _budget}
+{
+}
+
+TaggedAllocator::TaggedAllocator(Allocator& _parent, const char* _name, Size _budget)
+  : TaggedAllocator{_parent, nullptr, _name, _budget}
+{
+}
+
+TaggedAllocator::TaggedAllocator(Allocator& _allocator, TaggedAllocator* _parent,
+  const char* _name, Size _budget)
+  : m_allocator{_allocator}
+  , m_parent{_parent}
+  , m_name{_name}
+  , m_budget_callback{nullptr}
+  , m_allocations{0}
+  , m_deallocations{0}
+  , m_used_bytes{0}
+  , m_peak_bytes{0}
+  , m_budget{_budget}
+{
+  Concurrency::ScopeLock locked{g_lock};
+  m_next = g_head;
+  g_head = this;
+}
+
+TaggedAllocator::~TaggedAllocator() {
+  Concurrency::ScopeLock locked{g_lock};
+  for (TaggedAllocator** node = &g_head; *node; node = &(*node)->m_next) {
+    if (*node == this) {
+      *node = m_next;
+      break;
+    }
+  }
+}
+
+bool TaggedAllocator::reserve(Size _size) {
+  const Size used = m_used_bytes.fetch_add(_size, Concurrency::MemoryOrder::k_relaxed) + _size;
+  const Size budget = m_budget.load(Concurrency::MemoryOrder::k_relaxed);
+  if (RX_HINT_UNLIKELY(budget && used > budget)) {
+    if (!m_budget_callback || !m_budget_callback(*this, _size)) {
+      m_used_bytes.fetch_sub(_size, Concurrency::MemoryOrder::k_relaxed);
+      return false;
+    }
+  }
+
+  Size peak = m_peak_bytes.load(Concurrency::MemoryOrder::k_relaxed);
+  while (used > peak && !m_peak_bytes.compare_exchange_weak(peak, used,
+    Concurrency::MemoryOrder::k_relaxed, Concurrency::MemoryOrder::k_relaxed))
+  {
+    // |peak| was updated by the failed exchange.
+  }
+
+  return true;
+}
+
+void TaggedAllocator::release(Size _size) {
+  m_used_bytes.fetch_sub(_size, Concurrency::MemoryOrder::k_relaxed);
+}
+
+Byte* TaggedAllocator::allocate(Size _size) {
+  if (RX_HINT_UNLIKELY(!reserve(_size))) {
+    return nullptr;
+  }
+
+  // Traced allocations are attributed to the outermost tagged allocator.
+  const TracingAllocator::Tag tag{m_name};
+  Byte* base = m_allocator.allocate(_size + k_alignment);
+  if (RX_HINT_UNLIKELY(!base)) {
+    release(_size);
+    return nullptr;
+  }
+
+  reinterpret_cast<Header*>(base)->size = _size;
+  m_allocations.fetch_add(1, Concurrency::MemoryOrder::k_relaxed);
+
+  return base + k_alignment;
+}
+
+Byte* TaggedAllocator::reallocate(void* _data, Size _size) {
+  if (RX_HINT_UNLIKELY(!_data)) {
+    return allocate(_size);
+  }
+
+  Byte* base = reinterpret_cast<Byte*>(_data) - k_alignment;
+  const Size size = reinterpret_cast<Header*>(base)->size;
+
+  // Only growth is subject to the budget.
+  if (_size > size && RX_HINT_UNLIKELY(!reserve(_size - size))) {
+    return nullptr;
+  }
+
+  const TracingAllocator::Tag tag{m_name};
+  Byte* resize = m_allocator.reallocate(base, _size + k_alignment);
+  if (RX_HINT_UNLIKELY(!resize)) {
+    if (_size > size) {
+      release(_size - size);
+    }
+    return nullptr;
+  }
+
+  if (_size < size) {
+    release(size - _size);
+  }
+
+  reinterpret_cast<Header*>(resize)->size = _size;
+
+  return resize + k_alignment;
+}
+
+void TaggedAllocator::deallocate(void* _data) {
+  if (RX_HINT_UNLIKELY(!_data)) {
+    return;
+  }
+
+  Byte* base = reinterpret_cast<Byte*>(_data) - k_alignment;
+  release(reinterpret_cast<Header*>(base)->size);
+  m_deallocations.fetch_add(1, Concurrency::MemoryOrder::k_relaxed);
+
+  const TracingAllocator::Tag tag{m_name};
+  m_allocator.deallocate(base);
+}
+
+TaggedAllocator::Statistics TaggedAllocator::stats() const {
+  // The fields are read independently, they're only approximately consistent
+  // with each other while other threads allocate.
+  Statistics statistics;
+  statistics.allocations = m_allocations.load(Concurrency::MemoryOrder::k_relaxed);
+  statistics.deallocations = m_deallocations.load(Concurrency::MemoryOrder::k_relaxed);
+  statistics.used_bytes = m_used_bytes.load(Concurrency::MemoryOrder::k_relaxed);
+  statistics.peak_bytes = m_peak_bytes.load(Concurrency::MemoryOrder::k_relaxed);
+  statistics.budget = m_budget.load(Concurrency::MemoryOrder::k_relaxed);
+  return statistics;
+}
+
+void TaggedAllocator::set_budget(Size _budget) {
+  m_budget.store(_budget, Concurrency::MemoryOrder::k_relaxed);
+}
+
+void TaggedAllocator::set_budget_callback(BudgetCallback _callback) {
+  m_budget_callback = _callback;
+}
+
+void TaggedAllocator::lock() {
+  g_lock.lock();
+}
+
+void TaggedAllocator::unlock() {
+  g_lock.unlock();
+}
+
+TaggedAllocator* TaggedAllocator::head() {
+  return g_head;
+}
+
+} // namespace rx::memory
@@ -0,0 +1,132 @@
+#ifndef RX_CORE_MEMORY_TAGGED_ALLOCATOR_H
+#define RX_CORE_MEMORY_TAGGED_ALLOCATOR_H
+#include "rx/core/memory/allocator.h"
+#include "rx/core/concurrency/atomic.h"
+
+namespace Rx::Memory {
+
+// # Tagged Allocator
+//
+// The idea behind a tagged allocator is to give a subsystem it's own named
+// allocator which forwards to a parent allocator while accounting for the
+// memory the subsystem uses. Since a tagged allocator can be the parent of
+// another tagged allocator, they form a tree where the usage of every node
+// includes the usage of all of it's children.
+//
+// Accounting is done with atomics, there is no lock on any allocation path.
+// Allocations are extended by k_alignment bytes to store the size of the
+// allocation in front of it.
+//
+// Each tagged allocator can be given a hard budget. When an allocation would
+// exceed the budget, the budget callback is called with the allocator and the
+// size of the allocation. When the callback returns true the allocation is
+// allowed anyway, otherwise, or when there is no callback, the allocation
+// fails and nullptr is returned.
+//
+// Every tagged allocator is registered in a global list so that they can all
+// be enumerated as a tree with |each|.
+//
+// The purpose of this allocator is to give subsystems live memory accounting
+// and budgets.
+struct TaggedAllocator
+  final : Allocator
+{
+  RX_MARK_NO_COPY(TaggedAllocator);
+  RX_MARK_NO_MOVE(TaggedAllocator);
+
+  using BudgetCallback = bool (*)(TaggedAllocator& _allocator, Size _size);
+
+  TaggedAllocator(TaggedAllocator& _parent, const char* _name, Size _budget = 0);
+  TaggedAllocator(Allocator& _parent, const char* _name, Size _budget = 0);
+  ~TaggedAllocator();
+
+  virtual Byte* allocate(Size _size);
+  virtual Byte* reallocate(void* _data, Size _size);
+  virtual void deallocate(void* _data);
+
+  struct Statistics {
+    Size allocations;   // Number of calls to allocate
+    Size deallocations; // Number of calls to deallocate
+    Size used_bytes;    // Bytes currently in use, as requested
+    Size peak_bytes;    // Peak of |used_bytes|
+    Size budget;        // Budget in bytes, zero when there's no budget
+  };
+
+  Statistics stats() const;
+
+  // A budget of zero disables the budget.
+  void set_budget(Size _budget);
+
+  // NOTE: The callback is not synchronized, set it before allocating.
+  void set_budget_callback(BudgetCallback _callback);
+
+  constexpr const char* name() const;
+
+  // The parent when it's also a tagged allocator, nullptr otherwise.
+  constexpr TaggedAllocator* parent() const;
+
+  // Enumerate every tagged allocator as a tree, parents before children,
+  // calling |_function| with the allocator and it's depth in the tree.
+  //
+  // NOTE: A global lock is held during enumeration, |_function| cannot
+  // construct or destroy tagged allocators.
+  template<typename F>
+  static void each(F&& _function);
+
+private:
+  TaggedAllocator(Allocator& _allocator, TaggedAllocator* _parent,
+    const char* _name, Size _budget);
+
+  static void lock();
+  static void unlock();
+  static TaggedAllocator* head();
+
+  template<typename F>
+  static void each(TaggedAllocator* _parent, Size _depth, F& _function);
+
+  bool reserve(Size _size);
+  void release(Size _size);
+
+  Allocator& m_allocator;
+  TaggedAllocator* m_parent;
+  const char* m_name;
+  BudgetCallback m_budget_callback;
+
+  Concurrency::Atomic<Size> m_allocations;
+  Concurrency::Atomic<Size> m_deallocations;
+  Concurrency::Atomic<Size> m_used_bytes;
+  Concurrency::Atomic<Size> m_peak_bytes;
+  Concurrency::Atomic<Size> m_budget;
+
+  // Link in the global list of tagged allocators.
+  TaggedAllocator* m_next;
+};
+
+inline constexpr const char* TaggedAllocator::name() const {
+  return m_name;
+}
+
+inline constexpr TaggedAllocator* TaggedAllocator::parent() const {
+  return m_parent;
+}
+
+template<typename F>
+inline void TaggedAllocator::each(F&& _function) {
+  lock();
+  each(nullptr, 0, _function);
+  unlock();
+}
+
+template<typename F>
+inline void TaggedAllocator::each(TaggedAllocator* _parent, Size _depth, F& _function) {
+  for (TaggedAllocator* node = head(); node; node = node->m_next) {
+    if (node->m_parent == _parent) {
+      _function(*node, _depth);
+      each(node, _depth + 1, _function);
+    }
+  }
+}
+
+} // namespace rx::memory
+
+#endif // RX_CORE_MEMORY_TAGGED_ALLOCATOR_H
@@ -0,0 +1,750 @@
+#include <string.h> // memcpy, strlen
+
+#include "rx/core/memory/tracing_allocator.h"
+#include "rx/core/memory/heap_allocator.h"
+#include "rx/core/concurrency/scope_lock.h"
+#include "rx/core/concurrency/spin_lock.h"
+#include "rx/core/concurrency/atomic.h"
+#include "rx/core/filesystem/file.h"
+#include "rx/core/algorithm/quick_sort.h"
+#include "rx/core/algorithm/min.h"
+#include "rx/core/time/qpc.h"
+#include "rx/core/hints/unlikely.h"
+#include "rx/core/hints/no_inline.h"
+#include "rx/core/config.h" // RX_PLATFORM_{LINUX,WINDOWS}
+#include "rx/core/string.h"
+#include "rx/core/vector.h"
+#include "rx/core/hash.h"
+#include "rx/core/map.h"
+
+#if defined(RX_PLATFORM_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h> // CaptureStackBackTrace
+#endif
+
+namespace Rx::Memory {
+
+// The trace file is a little-endian stream of chunks following a header.
+//
+// Header:
+//  char magic[4] = "RXMT"
+//  Uint32 version
+//  Uint64 ticks per second
+//
+// Every chunk begins with a Uint8 kind:
+//  k_string  : Uint32 id, Uint16 length, char data[length]
+//  k_event   : Uint8 op, Uint8 frames, Uint16 thread, Uint32 tag, Uint32 file,
+//              Uint32 function, Uint32 line, Uint64 ticks, Uint64 address,
+//              Uint64 previous, Uint64 size, Uint64 backtrace[frames]
+//  k_dropped : Uint64 count
+//
+// Strings are referenced by id from events, the id zero is reserved for no
+// string. Each string is written once, before the first event using it.
+static constexpr const char k_magic[4]{'R', 'X', 'M', 'T'};
+static constexpr const Uint32 k_version{1};
+
+enum : Uint8 {
+  k_string,
+  k_event,
+  k_dropped
+};
+
+enum : Uint8 {
+  k_allocate,
+  k_reallocate,
+  k_deallocate
+};
+
+static constexpr const Size k_max_frames{8};
+static constexpr const Size k_ring_capacity{2048}; // Must be a power of two.
+
+struct Record {
+  Uint8 op;
+  Uint8 frames;
+  Uint32 line;
+  const char* tag;
+  const char* file;
+  const char* function;
+  Uint64 ticks;
+  UintPtr address;
+  UintPtr previous;
+  Uint64 size;
+  UintPtr backtrace[k_max_frames];
+};
+
+// Single-producer, single-consumer ring of records owned by one thread. The
+// owning thread is the only producer and the consumer is whoever holds
+// |g_lock| while draining. The indices are kept on separate cache lines so the
+// producer and consumer do not false share.
+struct Ring {
+  Ring(Ring* _next, Uint32 _thread)
+    : next{_next}
+    , thread{_thread}
+    , head{0}
+    , tail{0}
+  {
+  }
+
+  Ring* next;
+  Uint32 thread;
+  Byte pad0[64];
+  Concurrency::Atomic<Uint64> head;
+  Byte pad1[64 - sizeof(Concurrency::Atomic<Uint64>)];
+  Concurrency::Atomic<Uint64> tail;
+  Byte pad2[64 - sizeof(Concurrency::Atomic<Uint64>)];
+  Record records[k_ring_capacity];
+};
+
+struct Writer {
+  Writer(Allocator& _allocator, const char* _file_name);
+
+  bool write_header();
+  void write(const Record& _record, Uint32 _thread);
+  void write_dropped(Uint64 _count);
+  bool flush();
+
+  Filesystem::File file;
+
+private:
+  template<typename T>
+  void put(const T& _value);
+  void put(const char* _data, Size _size);
+
+  Uint32 intern(const char* _string);
+
+  Map<UintPtr, Uint32> m_strings;
+  Vector<Byte> m_buffer;
+  Uint32 m_next_string;
+};
+
+// Rings are never released since threads do not notify us when they exit, a
+// thread that is torn down leaks it's ring. This is bounded by the number of
+// threads that have ever allocated while tracing was active.
+static Concurrency::Atomic<Ring*> g_rings{nullptr};
+static Concurrency::Atomic<Uint32> g_threads{0};
+static Concurrency::Atomic<Uint64> g_dropped{0};
+static Concurrency::Atomic<bool> g_active{false};
+
+static Concurrency::SpinLock g_lock;
+static Writer* g_writer;
+
+static thread_local Ring* t_ring;
+static thread_local const TracingAllocator::Scope* t_scope;
+static thread_local const char* t_tag;
+
+Writer::Writer(Allocator& _allocator, const char* _file_name)
+  : file{_allocator, _file_name, "wb"}
+  , m_strings{_allocator}
+  , m_buffer{_allocator}
+  , m_next_string{1}
+{
+}
+
+template<typename T>
+void Writer::put(const T& _value) {
+  put(reinterpret_cast<const char*>(&_value), sizeof _value);
+}
+
+void Writer::put(const char* _data, Size _size) {
+  const Size size = m_buffer.size();
+  RX_ASSERT(m_buffer.resize(size + _size, Utility::UninitializedTag{}),
+    "out of memory");
+  memcpy(m_buffer.data() + size, _data, _size);
+}
+
+Uint32 Writer::intern(const char* _string) {
+  if (!_string) {
+    return 0;
+  }
+
+  const auto key = reinterpret_cast<UintPtr>(_string);
+  if (const auto* id = m_strings.find(key)) {
+    return *id;
+  }
+
+  const Uint32 id = m_next_string++;
+  const auto length = static_cast<Uint16>(Algorithm::min(strlen(_string), Size{0xffff}));
+  put(k_string);
+  put(id);
+  put(length);
+  put(_string, length);
+
+  m_strings.insert(key, id);
+  return id;
+}
+
+bool Writer::write_header() {
+  put(k_magic, sizeof k_magic);
+  put(k_version);
+  put(Time::qpc_frequency());
+  return flush();
+}
+
+void Writer::write(const Record& _record, Uint32 _thread) {
+  // Intern all strings first since they are written as chunks of their own.
+  const Uint32 tag = intern(_record.tag);
+  const Uint32 file = intern(_record.file);
+  const Uint32 function = intern(_record.function);
+
+  put(k_event);
+  put(_record.op);
+  put(_record.frames);
+  put(static_cast<Uint16>(_thread));
+  put(tag);
+  put(file);
+  put(function);
+  put(_record.line);
+  put(_record.ticks);
+  put(static_cast<Uint64>(_record.address));
+  put(static_cast<Uint64>(_record.previous));
+  put(_record.size);
+  for (Uint8 i = 0; i < _record.frames; i++) {
+    put(static_cast<Uint64>(_record.backtrace[i]));
+  }
+}
+
+void Writer::write_dropped(Uint64 _count) {
+  put(k_dropped);
+  put(_count);
+}
+
+bool Writer::flush() {
+  if (m_buffer.is_empty()) {
+    return true;
+  }
+  const Uint64 size = m_buffer.size();
+  const bool result = file.write(m_buffer.data(), size) == size;
+  m_buffer.clear();
+  return result;
+}
+
+// Drain every ring into the writer. Must be called with |g_lock| held.
+static bool drain() {
+  for (Ring* ring = g_rings.load(Concurrency::MemoryOrder::k_acquire); ring; ring = ring->next) {
+    const Uint64 tail = ring->tail.load(Concurrency::MemoryOrder::k_relaxed);
+    const Uint64 head = ring->head.load(Concurrency::MemoryOrder::k_acquire);
+    if (g_writer) {
+      for (Uint64 i = tail; i != head; i++) {
+        g_writer->write(ring->records[i & (k_ring_capacity - 1)], ring->thread);
+      }
+    }
+    ring->tail.store(head, Concurrency::MemoryOrder::k_release);
+  }
+
+  if (!g_writer) {
+    return false;
+  }
+
+  if (const Uint64 dropped = g_dropped.exchange(0, Concurrency::MemoryOrder::k_relaxed)) {
+    g_writer->write_dropped(dropped);
+  }
+
+  return g_writer->flush();
+}
+
+static Ring* acquire_ring() {
+  // Name the final type so the allocation here is not mistaken for a
+  // speculative call back into the tracing allocator.
+  auto& allocator = static_cast<HeapAllocator&>(HeapAllocator::instance());
+  Byte* data = allocator.allocate(sizeof(Ring));
+  if (RX_HINT_UNLIKELY(!data)) {
+    return nullptr;
+  }
+
+  const Uint32 thread = g_threads.fetch_add(1, Concurrency::MemoryOrder::k_relaxed);
+  Ring* head = g_rings.load(Concurrency::MemoryOrder::k_relaxed);
+  Ring* ring = Utility::construct<Ring>(data, head, thread);
+  while (!g_rings.compare_exchange_weak(ring->next, ring,
+    Concurrency::MemoryOrder::k_release, Concurrency::MemoryOrder::k_relaxed))
+  {
+    // |ring->next| was updated with the current head by the failed exchange.
+  }
+
+  return t_ring = ring;
+}
+
+// Skip the frames of record and the tracing allocator itself.
+static constexpr const int k_skip_frames{2};
+
+// Both of these are never inlined so the number of frames to skip is known.
+RX_HINT_NO_INLINE static Uint8 capture_backtrace(UintPtr* backtrace_) {
+#if defined(RX_PLATFORM_WINDOWS)
+  // Skip this frame too, Windows counts from the caller of
+  // CaptureStackBackTrace.
+  void* frames[k_max_frames];
+  const USHORT count = CaptureStackBackTrace(k_skip_frames + 1, k_max_frames, frames, nullptr);
+  for (USHORT i = 0; i < count; i++) {
+    backtrace_[i] = reinterpret_cast<UintPtr>(frames[i]);
+  }
+  return static_cast<Uint8>(count);
+#elif defined(RX_FRAME_POINTERS) && (defined(RX_COMPILER_GCC) || defined(RX_COMPILER_CLANG))
+  // There are no unwind tables to walk the stack with, follow the chain of
+  // saved frame pointers instead. Every frame begins with the frame pointer of
+  // the caller followed by the return address into the caller.
+  static constexpr const UintPtr k_max_frame_size{1024 * 1024};
+  auto frame = reinterpret_cast<void* const*>(__builtin_frame_address(0));
+  Uint8 n = 0;
+  for (int skip = k_skip_frames; frame && n < k_max_frames; ) {
+    const auto address = reinterpret_cast<UintPtr>(frame[1]);
+    if (!address) {
+      break;
+    }
+
+    if (skip) {
+      skip--;
+    } else {
+      backtrace_[n++] = address;
+    }
+
+    // The stack grows down so the caller's frame is above this one. Anything
+    // else is the end of the chain, or a frame in code that was built without
+    // frame pointers, like the C library.
+    const auto next = reinterpret_cast<void* const*>(frame[0]);
+    const auto distance = reinterpret_cast<UintPtr>(next) - reinterpret_cast<UintPtr>(frame);
+    if (next <= frame || distance > k_max_frame_size
+      || reinterpret_cast<UintPtr>(next) % alignof(void*))
+    {
+      break;
+    }
+    frame = next;
+  }
+  return n;
+#else
+  (void)backtrace_;
+  return 0;
+#endif
+}
+
+RX_HINT_NO_INLINE static void record(Uint8 _op, const char* _tag, const void* _address,
+  const void* _previous, Uint64 _size, Uint64 _ticks)
+{
+  Ring* ring = t_ring ? t_ring : acquire_ring();
+  if (RX_HINT_UNLIKELY(!ring)) {
+    g_dropped.fetch_add(1, Concurrency::MemoryOrder::k_relaxed);
+    return;
+  }
+
+  const Uint64 head = ring->head.load(Concurrency::MemoryOrder::k_relaxed);
+  const Uint64 tail = ring->tail.load(Concurrency::MemoryOrder::k_acquire);
+  if (RX_HINT_UNLIKELY(head - tail >= k_ring_capacity)) {
+    g_dropped.fetch_add(1, Concurrency::MemoryOrder::k_relaxed);
+    return;
+  }
+
+  Record& entry = ring->records[head & (k_ring_capacity - 1)];
+  entry.op = _op;
+  entry.tag = t_tag ? t_tag : _tag;
+  entry.ticks = _ticks;
+  entry.address = reinterpret_cast<UintPtr>(_address);
+  entry.previous = reinterpret_cast<UintPtr>(_previous);
+  entry.size = _size;
+  if (const TracingAllocator::Scope* scope = t_scope) {
+    const SourceLocation& location = scope->location();
+    entry.file = location.file();
+    entry.function = location.function();
+    entry.line = static_cast<Uint32>(location.line());
+  } else {
+    entry.file = nullptr;
+    entry.function = nullptr;
+    entry.line = 0;
+  }
+  entry.frames = capture_backtrace(entry.backtrace);
+
+  ring->head.store(head + 1, Concurrency::MemoryOrder::k_release);
+
+  // Opportunistically drain when half full. Never wait on the lock here, if
+  // someone else holds it they're already draining.
+  if (head + 1 - tail >= k_ring_capacity / 2 && g_lock.try_lock()) {
+    drain();
+    g_lock.unlock();
+  }
+}
+
+Byte* TracingAllocator::allocate(Size _size) {
+  Byte* data = m_allocator.allocate(_size);
+  if (RX_HINT_UNLIKELY(g_active.load(Concurrency::MemoryOrder::k_relaxed)) && data) {
+    record(k_allocate, m_tag, data, nullptr, _size, Time::qpc_ticks());
+  }
+  return data;
+}
+
+Byte* TracingAllocator::reallocate(void* _data, Size _size) {
+  if (RX_HINT_UNLIKELY(!_data)) {
+    return allocate(_size);
+  }
+
+  Byte* data = m_allocator.reallocate(_data, _size);
+  if (RX_HINT_UNLIKELY(g_active.load(Concurrency::MemoryOrder::k_relaxed)) && data) {
+    record(k_reallocate, m_tag, data, _data, _size, Time::qpc_ticks());
+  }
+  return data;
+}
+
+void TracingAllocator::deallocate(void* _data) {
+  // Record before releasing the memory so that the address cannot be handed
+  // out again by another thread with an earlier timestamp than this one.
+  if (RX_HINT_UNLIKELY(g_active.load(Concurrency::MemoryOrder::k_relaxed)) && _data) {
+    record(k_deallocate, m_tag, _data, nullptr, 0, Time::qpc_ticks());
+  }
+  m_allocator.deallocate(_data);
+}
+
+TracingAllocator::Scope::Scope(const SourceLocation& _location)
+  : m_location{_location}
+  , m_previous{t_scope}
+{
+  t_scope = this;
+}
+
+TracingAllocator::Scope::~Scope() {
+  t_scope = m_previous;
+}
+
+TracingAllocator::Tag::Tag(const char* _tag)
+  : m_previous{t_tag}
+{
+  if (!m_previous) {
+    t_tag = _tag;
+  }
+}
+
+TracingAllocator::Tag::~Tag() {
+  t_tag = m_previous;
+}
+
+bool TracingAllocator::start(const char* _file_name) {
+  Concurrency::ScopeLock locked{g_lock};
+  if (g_writer) {
+    return false;
+  }
+
+  Allocator& allocator = HeapAllocator::instance();
+  Writer* writer = allocator.create<Writer>(allocator, _file_name);
+  if (!writer || !writer->file || !writer->write_header()) {
+    allocator.destroy<Writer>(writer);
+    return false;
+  }
+
+  // Discard anything left behind in the rings by a previous trace.
+  drain();
+  g_dropped.store(0, Concurrency::MemoryOrder::k_relaxed);
+
+  g_writer = writer;
+  g_active.store(true, Concurrency::MemoryOrder::k_release);
+  return true;
+}
+
+bool TracingAllocator::stop() {
+  g_active.store(false, Concurrency::MemoryOrder::k_release);
+
+  Concurrency::ScopeLock locked{g_lock};
+  if (!g_writer) {
+    return false;
+  }
+
+  const bool result = drain();
+  HeapAllocator::instance().destroy<Writer>(g_writer);
+  g_writer = nullptr;
+  return result;
+}
+
+bool TracingAllocator::flush() {
+  Concurrency::ScopeLock locked{g_lock};
+  return drain() && g_writer->file.flush();
+}
+
+bool TracingAllocator::is_active() {
+  return g_active.load(Concurrency::MemoryOrder::k_relaxed);
+}
+
+struct Event {
+  Uint8 op;
+  Uint32 site;
+  Uint64 ticks;
+  Uint64 address;
+  Uint64 previous;
+  Uint64 size;
+};
+
+struct SiteKey {
+  bool operator==(const SiteKey& _key) const;
+
+  Uint32 tag;
+  Uint32 file;
+  Uint32 function;
+  Uint32 line;
+  Uint64 backtrace[k_max_frames];
+  Uint8 frames;
+};
+
+bool SiteKey::operator==(const SiteKey& _key) const {
+  if (tag != _key.tag || file != _key.file || function != _key.function
+    || line != _key.line || frames != _key.frames)
+  {
+    return false;
+  }
+  for (Uint8 i = 0; i < frames; i++) {
+    if (backtrace[i] != _key.backtrace[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct Live {
+  Uint64 size;
+  Uint32 site;
+};
+
+struct Reader {
+  Reader(const Byte* _data, Size _size)
+    : m_data{_data}
+    , m_end{_data + _size}
+  {
+  }
+
+  template<typename T>
+  bool get(T& value_) {
+    if (m_data + sizeof value_ > m_end) {
+      return false;
+    }
+    memcpy(&value_, m_data, sizeof value_);
+    m_data += sizeof value_;
+    return true;
+  }
+
+  const char* skip(Size _size) {
+    if (m_data + _size > m_end) {
+      return nullptr;
+    }
+    const char* data = reinterpret_cast<const char*>(m_data);
+    m_data += _size;
+    return data;
+  }
+
+  bool is_empty() const {
+    return m_data == m_end;
+  }
+
+private:
+  const Byte* m_data;
+  const Byte* m_end;
+};
+
+bool TracingAllocator::summarize(const char* _file_name, Summary& summary_) {
+  Allocator& allocator = summary_.m_allocator;
+
+  auto contents = Filesystem::read_binary_file(allocator, _file_name);
+  if (!contents) {
+    return false;
+  }
+
+  Reader reader{contents->data(), contents->size()};
+
+  char magic[4];
+  Uint32 version;
+  Uint64 frequency;
+  if (!reader.get(magic) || memcmp(magic, k_magic, sizeof magic) != 0
+    || !reader.get(version) || version != k_version
+    || !reader.get(frequency) || frequency == 0)
+  {
+    return false;
+  }
+
+  Map<Uint32, String> strings{allocator};
+  Map<Size, Uint32> site_indices{allocator};
+  Vector<SiteKey> site_keys{allocator};
+  Vector<Event> events{allocator};
+  Uint64 dropped{0};
+
+  while (!reader.is_empty()) {
+    Uint8 kind;
+    if (!reader.get(kind)) {
+      return false;
+    }
+
+    if (kind == k_string) {
+      Uint32 id;
+      Uint16 length;
+      if (!reader.get(id) || !reader.get(length)) {
+        return false;
+      }
+      const char* data = reader.skip(length);
+      if (!data) {
+        return false;
+      }
+      strings.insert(id, String{allocator, data, data + length});
+    } else if (kind == k_event) {
+      Uint8 op, frames;
+      Uint16 thread;
+      SiteKey key{};
+      Event event;
+      if (!reader.get(op) || !reader.get(frames) || !reader.get(thread)
+        || !reader.get(key.tag) || !reader.get(key.file) || !reader.get(key.function)
+        || !reader.get(key.line) || !reader.get(event.ticks)
+        || !reader.get(event.address) || !reader.get(event.previous)
+        || !reader.get(event.size) || frames > k_max_frames)
+      {
+        return false;
+      }
+
+      key.frames = frames;
+      for (Uint8 i = 0; i < frames; i++) {
+        if (!reader.get(key.backtrace[i])) {
+          return false;
+        }
+      }
+
+      event.op = op;
+      event.site = 0;
+
+      // Deallocations are attributed to the site that made the allocation.
+      if (op != k_deallocate) {
+        // Sites are identified by the tag and the source location when there
+        // is one, otherwise by the tag and the backtrace.
+        Size hash = Hash<Uint32>{}(key.tag);
+        if (key.file) {
+          hash = hash_combine(hash, hash_combine(hash_combine(Hash<Uint32>{}(key.file),
+            Hash<Uint32>{}(key.function)), Hash<Uint32>{}(key.line)));
+          key.frames = 0;
+        } else {
+          for (Uint8 i = 0; i < frames; i++) {
+            hash = hash_combine(hash, Hash<Uint64>{}(key.backtrace[i]));
+          }
+        }
+
+        // Different sites can have the same hash, probe the next hash until
+        // finding this site or an unused hash.
+        for (;; hash++) {
+          const auto* index = site_indices.find(hash);
+          if (!index) {
+            event.site = static_cast<Uint32>(site_keys.size());
+            site_indices.insert(hash, event.site);
+            site_keys.push_back(key);
+            break;
+          }
+          if (site_keys[*index] == key) {
+            event.site = *index;
+            break;
+          }
+        }
+      }
+
+      events.push_back(event);
+    } else if (kind == k_dropped) {
+      Uint64 count;
+      if (!reader.get(count)) {
+        return false;
+      }
+      dropped += count;
+    } else {
+      return false;
+    }
+  }
+
+  // Rings are drained one thread at a time so events need to be put back into
+  // the order they happened in before replaying them.
+  Algorithm::quick_sort(events.data(), events.data() + events.size(),
+    [](const Event& _lhs, const Event& _rhs) { return _lhs.ticks < _rhs.ticks; });
+
+  Vector<Site> sites{allocator, site_keys.size()};
+  Map<Uint64, Live> live{allocator};
+
+  auto release = [&](Uint64 _address) {
+    if (const auto* find = live.find(_address)) {
+      Site& site = sites[find->site];
+      site.live_bytes -= find->size;
+      site.live_allocations--;
+      live.erase(_address);
+    }
+  };
+
+  events.each_fwd([&](const Event& _event) {
+    switch (_event.op) {
+    case k_reallocate:
+      release(_event.previous);
+      [[fallthrough]];
+    case k_allocate:
+      {
+        Site& site = sites[_event.site];
+        release(_event.address);
+        site.live_bytes += _event.size;
+        site.live_allocations++;
+        site.allocations++;
+        live.insert(_event.address, {_event.size, _event.site});
+      }
+      break;
+    case k_deallocate:
+      release(_event.address);
+      break;
+    }
+  });
+
+  const Float64 duration = events.size() > 1
+    ? static_cast<Float64>(events.last().ticks - events.first().ticks) / frequency
+    : 0.0;
+
+  // Produce the names of every site.
+  auto name = [&](Uint32 _id) -> const char* {
+    const auto* find = strings.find(_id);
+    return find ? find->data() : "?";
+  };
+
+  Vector<String> names{allocator};
+  Size names_size{0};
+  site_keys.each_fwd([&](const SiteKey& _key) {
+    String result{allocator, name(_key.tag)};
+    if (_key.file) {
+      result.append(String::format(allocator, ": %s:%d (%s)", name(_key.file),
+        static_cast<Sint32>(_key.line), name(_key.function)));
+    } else if (_key.frames) {
+      result.append(':');
+      for (Uint8 i = 0; i < _key.frames; i++) {
+        result.append(String::format(allocator, " %#zx",
+          static_cast<Size>(_key.backtrace[i])));
+      }
+    }
+    names_size += result.size() + 1;
+    names.push_back(Utility::move(result));
+  });
+
+  char* names_data = reinterpret_cast<char*>(allocator.allocate(names_size));
+  Site* sites_data = reinterpret_cast<Site*>(allocator.allocate(sizeof(Site) * sites.size()));
+  if (!names_data || !sites_data) {
+    allocator.deallocate(names_data);
+    allocator.deallocate(sites_data);
+    return false;
+  }
+
+  Uint64 live_bytes{0};
+  char* name_next = names_data;
+  for (Size i = 0; i < sites.size(); i++) {
+    Site& site = sites[i];
+    const String& site_name = names[i];
+    memcpy(name_next, site_name.data(), site_name.size() + 1);
+    site.name = name_next;
+    site.rate = duration > 0.0 ? site.allocations / duration : 0.0;
+    name_next += site_name.size() + 1;
+    live_bytes += site.live_bytes;
+  }
+
+  Algorithm::quick_sort(sites.data(), sites.data() + sites.size(),
+    [](const Site& _lhs, const Site& _rhs) { return _lhs.live_bytes > _rhs.live_bytes; });
+
+  memcpy(sites_data, sites.data(), sizeof(Site) * sites.size());
+
+  allocator.deallocate(summary_.m_sites);
+  allocator.deallocate(summary_.m_names);
+
+  summary_.m_sites = sites_data;
+  summary_.m_names = names_data;
+  summary_.m_size = sites.size();
+  summary_.m_live_bytes = live_bytes;
+  summary_.m_dropped = dropped;
+  summary_.m_duration = duration;
+
+  return true;
+}
+
+} // namespace rx::memory
@@ -0,0 +1,191 @@
+#ifndef RX_CORE_MEMORY_TRACING_ALLOCATOR_H
+#define RX_CORE_MEMORY_TRACING_ALLOCATOR_H
+#include "rx/core/memory/allocator.h"
+#include "rx/core/source_location.h"
+#include "rx/core/pp.h"
+
+namespace Rx::Memory {
+
+// # Tracing Allocator
+//
+// The idea behind a tracing allocator is to wrap an existing allocator
+// implementation and record every allocation, reallocation and deallocation
+// made through it so that memory growth can be attributed to the subsystem
+// and call site responsible for it.
+//
+// Tracing is opt-in. Until |start| is called the allocator only forwards to
+// the allocator it wraps. Once started, every operation produces a record
+// containing the size, address, the outermost active |Tag| or otherwise the
+// tag of the tracing allocator, the innermost active |Scope| source location
+// and a short backtrace. Records are written into a lock-free ring owned by
+// the calling thread and are later drained into a compact binary trace file
+// by |flush|, or opportunistically by the producing thread when it's ring
+// becomes half full.
+//
+// Backtraces are collected by walking frame pointers, since the engine is
+// built without unwind tables. They're only available when RX_FRAME_POINTERS
+// is defined, which the Makefile does for builds that keep frame pointers, or
+// on Windows. Otherwise call sites are only known through scopes.
+//
+// The trace file can be summarized with |summarize|, which is what the memory
+// statistics HUD uses, or offline with src/tools/memory_trace.py.
+//
+// The purpose of this allocator is to provide a heap profiler for any
+// allocator, including the system allocator.
+struct TracingAllocator
+  final : Allocator
+{
+  constexpr TracingAllocator(Allocator& _allocator, const char* _tag);
+
+  virtual Byte* allocate(Size _size);
+  virtual Byte* reallocate(void* _data, Size _size);
+  virtual void deallocate(void* _data);
+
+  constexpr const char* tag() const;
+
+  // Attributes every traced operation made by the calling thread to
+  // |_location| for the lifetime of the scope. Scopes nest, the innermost
+  // scope applies.
+  //
+  // Use RX_MEMORY_TRACE_SCOPE to attribute to the location it's used at.
+  struct Scope {
+    RX_MARK_NO_COPY(Scope);
+    RX_MARK_NO_MOVE(Scope);
+
+    Scope(const SourceLocation& _location);
+    ~Scope();
+
+    const SourceLocation& location() const;
+
+  private:
+    SourceLocation m_location;
+    const Scope* m_previous;
+  };
+
+  // Attributes every traced operation made by the calling thread to the tag
+  // |_tag| for the lifetime of the tag, instead of the tag of the tracing
+  // allocator. Tags nest, the outermost tag applies. This is how an allocator
+  // which forwards to the system allocator, like TaggedAllocator, gets it's
+  // own name in the trace rather than "system", even through parents.
+  struct Tag {
+    RX_MARK_NO_COPY(Tag);
+    RX_MARK_NO_MOVE(Tag);
+
+    Tag(const char* _tag);
+    ~Tag();
+
+  private:
+    const char* m_previous;
+  };
+
+  // Begin tracing all tracing allocators into the file |_file_name|. Returns
+  // false if tracing is already active or the file could not be opened.
+  static bool start(const char* _file_name);
+
+  // Drain all per-thread rings into the trace file and stop tracing.
+  static bool stop();
+
+  // Drain all per-thread rings into the trace file.
+  static bool flush();
+
+  static bool is_active();
+
+  // A call site in a summarized trace.
+  struct Site {
+    const char* name;        // "tag: file:line (function)", "tag: backtrace" or "tag"
+    Uint64 live_bytes;       // Bytes still allocated at the end of the trace
+    Uint64 live_allocations; // Allocations still live at the end of the trace
+    Uint64 allocations;      // Total number of allocations and reallocations
+    Float64 rate;            // Allocations per second over the entire trace
+  };
+
+  struct Summary {
+    RX_MARK_NO_COPY(Summary);
+    RX_MARK_NO_MOVE(Summary);
+
+    Summary(Allocator& _allocator);
+    ~Summary();
+
+    // Sites are ordered by |live_bytes|, largest first.
+    const Site* sites() const;
+    Size size() const;
+
+    Uint64 live_bytes() const;
+    Uint64 dropped() const;
+    Float64 duration() const;
+
+  private:
+    friend struct TracingAllocator;
+    Allocator& m_allocator;
+    Site* m_sites;
+    char* m_names;
+    Size m_size;
+    Uint64 m_live_bytes;
+    Uint64 m_dropped;
+    Float64 m_duration;
+  };
+
+  // Read and aggregate the trace file |_file_name| into |summary_|.
+  static bool summarize(const char* _file_name, Summary& summary_);
+
+private:
+  Allocator& m_allocator;
+  const char* m_tag;
+};
+
+inline constexpr TracingAllocator::TracingAllocator(Allocator& _allocator, const char* _tag)
+  : m_allocator{_allocator}
+  , m_tag{_tag}
+{
+}
+
+inline constexpr const char* TracingAllocator::tag() const {
+  return m_tag;
+}
+
+inline const SourceLocation& TracingAllocator::Scope::location() const {
+  return m_location;
+}
+
+inline TracingAllocator::Summary::Summary(Allocator& _allocator)
+  : m_allocator{_allocator}
+  , m_sites{nullptr}
+  , m_names{nullptr}
+  , m_size{0}
+  , m_live_bytes{0}
+  , m_dropped{0}
+  , m_duration{0.0}
+{
+}
+
+inline TracingAllocator::Summary::~Summary() {
+  m_allocator.deallocate(m_sites);
+  m_allocator.deallocate(m_names);
+}
+
+inline const TracingAllocator::Site* TracingAllocator::Summary::sites() const {
+  return m_sites;
+}
+
+inline Size TracingAllocator::Summary::size() const {
+  return m_size;
+}
+
+inline Uint64 TracingAllocator::Summary::live_bytes() const {
+  return m_live_bytes;
+}
+
+inline Uint64 TracingAllocator::Summary::dropped() const {
+  return m_dropped;
+}
+
+inline Float64 TracingAllocator::Summary::duration() const {
+  return m_duration;
+}
+
+} // namespace rx::memory
+
+#define RX_MEMORY_TRACE_SCOPE() \
+  const ::Rx::Memory::TracingAllocator::Scope RX_PP_UNIQUE(rx_memory_trace){RX_SOURCE_LOCATION}
+
+#endif // RX_CORE_MEMORY_TRACING_ALLOCATOR_H
@@ -6,6 +6,7 @@
 #include "rx/core/traits/is_trivially_destructible.h"
 #include "rx/core/traits/return_type.h"
 #include "rx/core/traits/is_same.h"
+#include "rx/core/traits/enable_if.h"
 
 #include "rx/core/utility/swap.h"
 
@@ -46,9 +47,28 @@ struct Set {
   K* insert(K&& _key);
   K* insert(const K& _key);
 
+  // Insert with |_hash| being the precomputed Hash<K> of |_key|.
+  K* insert(K&& _key, Size _hash);
+  K* insert(const K& _key, Size _hash);
+
   K* find(const K& _key) const;
 
+  // Lookup with a key of another type, see is_heterogeneous_key.
+  template<typename U, typename = traits::enable_if<is_heterogeneous_key<K, U>>>
+  K* find(const U& _key) const;
+
+  // Lookup with |_hash| being the precomputed Hash<K> of |_key|. The type of
+  // |_key| need only compare equal with |K|.
+  template<typename U>
+  K* find(const U& _key, Size _hash) const;
+
   bool erase(const K& _key);
+
+  template<typename U, typename = traits::enable_if<is_heterogeneous_key<K, U>>>
+  bool erase(const U& _key);
+  template<typename U>
+  bool erase(const U& _key, Size _hash);
+
   Size size() const;
   bool is_empty() const;
 
@@ -65,6 +85,7 @@ private:
   void clear_and_deallocate();
 
   static Size hash_key(const K& _key);
+  static Size normalize_hash(Size _hash);
   static bool is_deleted(Size _hash);
 
   Size desired_position(Size _hash) const;
@@ -82,7 +103,10 @@ private:
   K* inserter(Size _hash, K&& key_);
   K* inserter(Size _hash, const K& _key);
 
-  bool lookup_index(const K& _key, Size& _index) const;
+  template<typename U>
+  bool lookup_index(const U& _key, Size _hash, Size& _index) const;
+
+  void erase_index(Size _index);
 
   Memory::Allocator* m_allocator;
 
@@ -247,9 +271,40 @@ inline K* Set<K>::insert(const K& _key) {
   return inserter(hash_key(_key), _key);
 }
 
+template<typename K>
+inline K* Set<K>::insert(K&& key_, Size _hash) {
+  if (++m_size >= m_resize_threshold && !grow()) {
+    return nullptr;
+  }
+  return inserter(normalize_hash(_hash), Utility::forward<K>(key_));
+}
+
+template<typename K>
+inline K* Set<K>::insert(const K& _key, Size _hash) {
+  if (++m_size >= m_resize_threshold && !grow()) {
+    return nullptr;
+  }
+  return inserter(normalize_hash(_hash), _key);
+}
+
 template<typename K>
 K* Set<K>::find(const K& _key) const {
-  if (Size index; lookup_index(_key, index)) {
+  if (Size index; lookup_index(_key, hash_key(_key), index)) {
+    return m_keys + index;
+  }
+  return nullptr;
+}
+
+template<typename K>
+template<typename U, typename>
+inline K* Set<K>::find(const U& _key) const {
+  return find(_key, _key.hash());
+}
+
+template<typename K>
+template<typename U>
+inline K* Set<K>::find(const U& _key, Size _hash) const {
+  if (Size index; lookup_index(_key, normalize_hash(_hash), index)) {
     return m_keys + index;
   }
   return nullptr;
@@ -257,23 +312,44 @@ K* Set<K>::find(const K& _key) const {
 
 template<typename K>
 inline bool Set<K>::erase(const K& _key) {
-  if (Size index; lookup_index(_key, index)) {
-    if constexpr (!traits::is_trivially_destructible<K>) {
-      Utility::destruct<K>(m_keys + index);
-    }
+  if (Size index; lookup_index(_key, hash_key(_key), index)) {
+    erase_index(index);
+    return true;
+  }
+  return false;
+}
 
-    if constexpr (sizeof index == 8) {
-      element_hash(index) |= 0x8000000000000000;
-    } else {
-      element_hash(index) |= 0x80000000;
-    }
+template<typename K>
+template<typename U, typename>
+inline bool Set<K>::erase(const U& _key) {
+  return erase(_key, _key.hash());
+}
 
-    m_size--;
+template<typename K>
+template<typename U>
+inline bool Set<K>::erase(const U& _key, Size _hash) {
+  if (Size index; lookup_index(_key, normalize_hash(_hash), index)) {
+    erase_index(index);
     return true;
   }
   return false;
 }
 
+template<typename K>
+inline void Set<K>::erase_index(Size _index) {
+  if constexpr (!traits::is_trivially_destructible<K>) {
+    Utility::destruct<K>(m_keys + _index);
+  }
+
+  if constexpr (sizeof _index == 8) {
+    element_hash(_index) |= 0x8000000000000000;
+  } else {
+    element_hash(_index) |= 0x80000000;
+  }
+
+  m_size--;
+}
+
 template<typename K>
 inline Size Set<K>::size() const {
   return m_size;
@@ -286,7 +362,12 @@ inline bool Set<K>::is_empty() const {
 
 template<typename K>
 inline Size Set<K>::hash_key(const K& _key) {
-  auto hash_value{Hash<K>{}(_key)};
+  return normalize_hash(Hash<K>{}(_key));
+}
+
+template<typename K>
+inline Size Set<K>::normalize_hash(Size _hash) {
+  auto hash_value{_hash};
 
   // MSB is used to indicate deleted elements
   if constexpr(sizeof hash_value == 8) {
@@ -431,8 +512,9 @@ inline K* Set<K>::inserter(Size _hash, const K& _key) {
 }
 
 template<typename K>
-inline bool Set<K>::lookup_index(const K& _key, Size& _index) const {
-  const Size hash{hash_key(_key)};
+template<typename U>
+inline bool Set<K>::lookup_index(const U& _key, Size _hash, Size& _index) const {
+  const Size hash{_hash};
   Size position{desired_position(hash)};
   Size distance{0};
   for (;;) {
@@ -0,0 +1,540 @@
+#ifndef RX_CORE_SMALL_VECTOR_H
+#define RX_CORE_SMALL_VECTOR_H
+#include "rx/core/assert.h"
+
+#include "rx/core/traits/is_same.h"
+#include "rx/core/traits/is_trivially_copyable.h"
+#include "rx/core/traits/is_trivially_destructible.h"
+#include "rx/core/traits/return_type.h"
+
+#include "rx/core/utility/construct.h"
+#include "rx/core/utility/destruct.h"
+#include "rx/core/utility/exchange.h"
+#include "rx/core/utility/forward.h"
+#include "rx/core/utility/move.h"
+
+#include "rx/core/memory/system_allocator.h" // memory::{system_allocator, allocator}
+#include "rx/core/memory/uninitialized_storage.h"
+
+#include "rx/core/hints/force_inline.h"
+#include "rx/core/hints/likely.h"
+#include "rx/core/hints/restrict.h"
+#include "rx/core/hints/unlikely.h"
+
+namespace Rx {
+
+namespace detail {
+  void copy(void *RX_HINT_RESTRICT dst_, const void* RX_HINT_RESTRICT _src, Size _size);
+}
+
+// # Small Vector
+//
+// The idea behind a small vector is to store the first |E| elements inline
+// in the vector itself, only allocating memory from the allocator when it
+// grows beyond that. Vectors which are usually small and short-lived then
+// never touch the allocator at all.
+//
+// Once the elements spill to memory from the allocator they stay there until
+// the vector is destroyed, clearing the vector keeps the capacity.
+//
+// Moving a small vector which is still using it's inline storage has to move
+// the elements individually.
+//
+// 32-bit: 16 + sizeof(T) * E bytes
+// 64-bit: 32 + sizeof(T) * E bytes
+template<typename T, Size E>
+struct SmallVector {
+  static_assert(E != 0, "use Vector for no inline storage");
+
+  static constexpr const Size k_npos{-1_z};
+
+  SmallVector();
+  SmallVector(Memory::Allocator& _allocator);
+  SmallVector(Memory::Allocator& _allocator, const SmallVector& _other);
+  SmallVector(const SmallVector& _other);
+  SmallVector(SmallVector&& other_);
+  ~SmallVector();
+
+  SmallVector& operator=(const SmallVector& _other);
+  SmallVector& operator=(SmallVector&& other_);
+
+  T& operator[](Size _index);
+  const T& operator[](Size _index) const;
+
+  // resize to |size| with |value| for new objects
+  bool resize(Size _size, const T& _value = {});
+
+  // reserve |size| elements
+  bool reserve(Size _size);
+
+  void clear();
+
+  Size find(const T& _value) const;
+
+  template<typename F>
+  Size find_if(F&& _compare) const;
+
+  // append |data| by copy
+  bool push_back(const T& _data);
+  // append |data| by move
+  bool push_back(T&& data_);
+
+  void pop_back();
+
+  // append new |T| construct with |args|
+  template<typename... Ts>
+  bool emplace_back(Ts&&... _args);
+
+  Size size() const;
+  Size capacity() const;
+
+  bool in_range(Size _index) const;
+  bool is_empty() const;
+
+  // If the elements are still stored inline.
+  bool is_small() const;
+
+  // enumerate collection either forward or reverse
+  template<typename F>
+  bool each_fwd(F&& _func);
+  template<typename F>
+  bool each_rev(F&& _func);
+  template<typename F>
+  bool each_fwd(F&& _func) const;
+  template<typename F>
+  bool each_rev(F&& _func) const;
+
+  void erase(Size _from, Size _to);
+
+  // first or last element
+  const T& first() const;
+  T& first();
+  const T& last() const;
+  T& last();
+
+  const T* data() const;
+  T* data();
+
+  constexpr Memory::Allocator& allocator() const;
+
+private:
+  T* inline_data();
+  void release();
+
+  // Moves the elements of |other_| into this vector, which must be empty and
+  // using it's inline storage. Leaves |other_| empty.
+  void take(SmallVector&& other_);
+
+  Memory::Allocator* m_allocator;
+  T* m_data;
+  Size m_size;
+  Size m_capacity;
+  Memory::UninitializedStorage<sizeof(T) * E, alignof(T)> m_storage;
+};
+
+template<typename T, Size E>
+inline SmallVector<T, E>::SmallVector()
+  : SmallVector{Memory::SystemAllocator::instance()}
+{
+}
+
+template<typename T, Size E>
+inline SmallVector<T, E>::SmallVector(Memory::Allocator& _allocator)
+  : m_allocator{&_allocator}
+  , m_data{inline_data()}
+  , m_size{0}
+  , m_capacity{E}
+{
+}
+
+template<typename T, Size E>
+inline SmallVector<T, E>::SmallVector(Memory::Allocator& _allocator, const SmallVector& _other)
+  : SmallVector{_allocator}
+{
+  RX_ASSERT(reserve(_other.m_size), "out of memory");
+
+  if constexpr (traits::is_trivially_copyable<T>) {
+    detail::copy(m_data, _other.m_data, sizeof(T) * _other.m_size);
+  } else for (Size i = 0; i < _other.m_size; i++) {
+    Utility::construct<T>(m_data + i, _other.m_data[i]);
+  }
+
+  m_size = _other.m_size;
+}
+
+template<typename T, Size E>
+inline SmallVector<T, E>::SmallVector(const SmallVector& _other)
+  : SmallVector{*_other.m_allocator, _other}
+{
+}
+
+template<typename T, Size E>
+inline SmallVector<T, E>::SmallVector(SmallVector&& other_)
+  : SmallVector{*other_.m_allocator}
+{
+  take(Utility::move(other_));
+}
+
+template<typename T, Size E>
+inline SmallVector<T, E>::~SmallVector() {
+  release();
+}
+
+template<typename T, Size E>
+inline SmallVector<T, E>& SmallVector<T, E>::operator=(const SmallVector& _other) {
+  RX_ASSERT(&_other != this, "self assignment");
+
+  clear();
+  RX_ASSERT(reserve(_other.m_size), "out of memory");
+
+  if constexpr (traits::is_trivially_copyable<T>) {
+    detail::copy(m_data, _other.m_data, sizeof(T) * _other.m_size);
+  } else for (Size i = 0; i < _other.m_size; i++) {
+    Utility::construct<T>(m_data + i, _other.m_data[i]);
+  }
+
+  m_size = _other.m_size;
+
+  return *this;
+}
+
+template<typename T, Size E>
+inline SmallVector<T, E>& SmallVector<T, E>::operator=(SmallVector&& other_) {
+  RX_ASSERT(&other_ != this, "self assignment");
+
+  release();
+
+  m_allocator = other_.m_allocator;
+  m_data = inline_data();
+  m_capacity = E;
+  take(Utility::move(other_));
+
+  return *this;
+}
+
+template<typename T, Size E>
+inline T& SmallVector<T, E>::operator[](Size _index) {
+  RX_ASSERT(in_range(_index), "out of bounds (%zu >= %zu)", _index, m_size);
+  return m_data[_index];
+}
+
+template<typename T, Size E>
+inline const T& SmallVector<T, E>::operator[](Size _index) const {
+  RX_ASSERT(in_range(_index), "out of bounds (%zu >= %zu)", _index, m_size);
+  return m_data[_index];
+}
+
+template<typename T, Size E>
+bool SmallVector<T, E>::resize(Size _size, const T& _value) {
+  if (!reserve(_size)) {
+    return false;
+  }
+
+  if constexpr (!traits::is_trivially_destructible<T>) {
+    for (Size i = m_size; i > _size; --i) {
+      Utility::destruct<T>(m_data + (i - 1));
+    }
+  }
+
+  for (Size i = m_size; i < _size; i++) {
+    Utility::construct<T>(m_data + i, _value);
+  }
+
+  m_size = _size;
+  return true;
+}
+
+template<typename T, Size E>
+bool SmallVector<T, E>::reserve(Size _size) {
+  if (RX_HINT_LIKELY(_size <= m_capacity)) {
+    return true;
+  }
+
+  // Always resize capacity with the Golden ratio, like Vector.
+  Size capacity = m_capacity;
+  while (capacity < _size) {
+    capacity = ((capacity + 1) * 3) / 2;
+  }
+
+  // Once spilled the memory can be reallocated in place for trivial |T|.
+  if constexpr (traits::is_trivially_copyable<T>) {
+    if (!is_small()) {
+      T* resize = reinterpret_cast<T*>(allocator().reallocate(m_data, capacity * sizeof(T)));
+      if (RX_HINT_UNLIKELY(!resize)) {
+        return false;
+      }
+      m_data = resize;
+      m_capacity = capacity;
+      return true;
+    }
+  }
+
+  T* resize = reinterpret_cast<T*>(allocator().allocate(sizeof(T), capacity));
+  if (RX_HINT_UNLIKELY(!resize)) {
+    return false;
+  }
+
+  if constexpr (traits::is_trivially_copyable<T>) {
+    detail::copy(resize, m_data, sizeof(T) * m_size);
+  } else for (Size i = 0; i < m_size; i++) {
+    Utility::construct<T>(resize + i, Utility::move(m_data[i]));
+    Utility::destruct<T>(m_data + i);
+  }
+
+  if (!is_small()) {
+    allocator().deallocate(m_data);
+  }
+
+  m_data = resize;
+  m_capacity = capacity;
+  return true;
+}
+
+template<typename T, Size E>
+inline void SmallVector<T, E>::clear() {
+  if constexpr (!traits::is_trivially_destructible<T>) {
+    for (Size i = m_size - 1; i < m_size; i--) {
+      Utility::destruct<T>(m_data + i);
+    }
+  }
+  m_size = 0;
+}
+
+template<typename T, Size E>
+inline Size SmallVector<T, E>::find(const T& _value) const {
+  for (Size i = 0; i < m_size; i++) {
+    if (m_data[i] == _value) {
+      return i;
+    }
+  }
+  return k_npos;
+}
+
+template<typename T, Size E>
+template<typename F>
+inline Size SmallVector<T, E>::find_if(F&& _compare) const {
+  for (Size i = 0; i < m_size; i++) {
+    if (_compare(m_data[i])) {
+      return i;
+    }
+  }
+  return k_npos;
+}
+
+template<typename T, Size E>
+inline bool SmallVector<T, E>::push_back(const T& _value) {
+  return emplace_back(_value);
+}
+
+template<typename T, Size E>
+inline bool SmallVector<T, E>::push_back(T&& value_) {
+  return emplace_back(Utility::move(value_));
+}
+
+template<typename T, Size E>
+inline void SmallVector<T, E>::pop_back() {
+  RX_ASSERT(m_size, "empty vector");
+  m_size--;
+  if constexpr (!traits::is_trivially_destructible<T>) {
+    Utility::destruct<T>(m_data + m_size);
+  }
+}
+
+template<typename T, Size E>
+template<typename... Ts>
+inline bool SmallVector<T, E>::emplace_back(Ts&&... _args) {
+  if (RX_HINT_UNLIKELY(m_size == m_capacity)) {
+    // The arguments may refer to an element which is moved by growing.
+    T value{Utility::forward<Ts>(_args)...};
+    if (!reserve(m_size + 1)) {
+      return false;
+    }
+    Utility::construct<T>(m_data + m_size, Utility::move(value));
+  } else {
+    Utility::construct<T>(m_data + m_size, Utility::forward<Ts>(_args)...);
+  }
+
+  m_size++;
+  return true;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE Size SmallVector<T, E>::size() const {
+  return m_size;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE Size SmallVector<T, E>::capacity() const {
+  return m_capacity;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE bool SmallVector<T, E>::in_range(Size _index) const {
+  return _index < m_size;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE bool SmallVector<T, E>::is_empty() const {
+  return m_size == 0;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE bool SmallVector<T, E>::is_small() const {
+  return m_data == reinterpret_cast<const T*>(m_storage.data());
+}
+
+template<typename T, Size E>
+template<typename F>
+inline bool SmallVector<T, E>::each_fwd(F&& _func) {
+  for (Size i = 0; i < m_size; i++) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      if (!_func(m_data[i])) {
+        return false;
+      }
+    } else {
+      _func(m_data[i]);
+    }
+  }
+  return true;
+}
+
+template<typename T, Size E>
+template<typename F>
+inline bool SmallVector<T, E>::each_fwd(F&& _func) const {
+  for (Size i = 0; i < m_size; i++) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      if (!_func(m_data[i])) {
+        return false;
+      }
+    } else {
+      _func(m_data[i]);
+    }
+  }
+  return true;
+}
+
+template<typename T, Size E>
+template<typename F>
+inline bool SmallVector<T, E>::each_rev(F&& _func) {
+  for (Size i = m_size - 1; i < m_size; i--) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      if (!_func(m_data[i])) {
+        return false;
+      }
+    } else {
+      _func(m_data[i]);
+    }
+  }
+  return true;
+}
+
+template<typename T, Size E>
+template<typename F>
+inline bool SmallVector<T, E>::each_rev(F&& _func) const {
+  for (Size i = m_size - 1; i < m_size; i--) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      if (!_func(m_data[i])) {
+        return false;
+      }
+    } else {
+      _func(m_data[i]);
+    }
+  }
+  return true;
+}
+
+template<typename T, Size E>
+inline void SmallVector<T, E>::erase(Size _from, Size _to) {
+  const Size range = _to - _from;
+  T* end = m_data + m_size;
+
+  for (T* value = m_data + _to, *dest = m_data + _from; value != end; ++value, ++dest) {
+    *dest = Utility::move(*value);
+  }
+
+  if constexpr (!traits::is_trivially_destructible<T>) {
+    for (T* value = end - range; value < end; ++value) {
+      Utility::destruct<T>(value);
+    }
+  }
+
+  m_size -= range;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE const T& SmallVector<T, E>::first() const {
+  RX_ASSERT(m_size, "empty vector");
+  return m_data[0];
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE T& SmallVector<T, E>::first() {
+  RX_ASSERT(m_size, "empty vector");
+  return m_data[0];
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE const T& SmallVector<T, E>::last() const {
+  RX_ASSERT(m_size, "empty vector");
+  return m_data[m_size - 1];
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE T& SmallVector<T, E>::last() {
+  RX_ASSERT(m_size, "empty vector");
+  return m_data[m_size - 1];
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE const T* SmallVector<T, E>::data() const {
+  return m_data;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE T* SmallVector<T, E>::data() {
+  return m_data;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE constexpr Memory::Allocator& SmallVector<T, E>::allocator() const {
+  return *m_allocator;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE T* SmallVector<T, E>::inline_data() {
+  return reinterpret_cast<T*>(m_storage.data());
+}
+
+template<typename T, Size E>
+inline void SmallVector<T, E>::release() {
+  clear();
+
+  // Avoid the heavy indirect call through |m_allocator| when never spilled.
+  if (!is_small()) {
+    allocator().deallocate(m_data);
+  }
+}
+
+template<typename T, Size E>
+inline void SmallVector<T, E>::take(SmallVector&& other_) {
+  if (!other_.is_small()) {
+    // Steal the memory of |other_|, which is from the same allocator.
+    m_data = Utility::exchange(other_.m_data, other_.inline_data());
+    m_size = Utility::exchange(other_.m_size, 0);
+    m_capacity = Utility::exchange(other_.m_capacity, E);
+    return;
+  }
+
+  if constexpr (traits::is_trivially_copyable<T>) {
+    detail::copy(m_data, other_.m_data, sizeof(T) * other_.m_size);
+  } else for (Size i = 0; i < other_.m_size; i++) {
+    Utility::construct<T>(m_data + i, Utility::move(other_.m_data[i]));
+  }
+
+  m_size = other_.m_size;
+  other_.clear();
+}
+
+} // namespace rx
+
+#endif // RX_CORE_SMALL_VECTOR_H
@@ -57,7 +57,7 @@ inline StaticPool::StaticPool(Size _object_size, Size _object_count)
 }
 
 inline StaticPool::~StaticPool() {
-  RX_ASSERT(m_bitset.count_set_bits() == 0, "leaked objects");
+  RX_ASSERT(m_bitset.find_first_set() == -1_z, "leaked objects");
   allocator().deallocate(m_data);
 }
 
@@ -109,7 +109,7 @@ RX_HINT_FORCE_INLINE bool StaticPool::is_empty() const {
 }
 
 inline bool StaticPool::can_allocate() const {
-  return m_bitset.count_unset_bits() != 0;
+  return m_bitset.find_first_unset() != -1_z;
 }
 
 inline Byte* StaticPool::data_of(Size _index) const {
@@ -0,0 +1,410 @@
+#ifndef RX_CORE_STATIC_VECTOR_H
+#define RX_CORE_STATIC_VECTOR_H
+#include "rx/core/assert.h"
+
+#include "rx/core/traits/is_same.h"
+#include "rx/core/traits/is_trivially_copyable.h"
+#include "rx/core/traits/is_trivially_destructible.h"
+#include "rx/core/traits/return_type.h"
+
+#include "rx/core/utility/construct.h"
+#include "rx/core/utility/destruct.h"
+#include "rx/core/utility/forward.h"
+#include "rx/core/utility/move.h"
+
+#include "rx/core/memory/uninitialized_storage.h"
+
+#include "rx/core/hints/force_inline.h"
+#include "rx/core/hints/restrict.h"
+#include "rx/core/hints/unlikely.h"
+
+namespace Rx {
+
+namespace detail {
+  void copy(void *RX_HINT_RESTRICT dst_, const void* RX_HINT_RESTRICT _src, Size _size);
+}
+
+// # Static Vector
+//
+// The idea behind a static vector is to provide the interface of a vector for
+// a fixed maximum of |E| elements which are stored inline, without ever
+// allocating memory.
+//
+// Like the other containers, functions which add elements return false when
+// there is no room left rather than growing.
+//
+// 32-bit: 4 + sizeof(T) * E bytes
+// 64-bit: 8 + sizeof(T) * E bytes
+template<typename T, Size E>
+struct StaticVector {
+  static_assert(E != 0, "empty static vector");
+
+  static constexpr const Size k_npos{-1_z};
+
+  constexpr StaticVector();
+  StaticVector(const StaticVector& _other);
+  StaticVector(StaticVector&& other_);
+  ~StaticVector();
+
+  StaticVector& operator=(const StaticVector& _other);
+  StaticVector& operator=(StaticVector&& other_);
+
+  T& operator[](Size _index);
+  const T& operator[](Size _index) const;
+
+  // resize to |size| with |value| for new objects
+  bool resize(Size _size, const T& _value = {});
+
+  void clear();
+
+  Size find(const T& _value) const;
+
+  template<typename F>
+  Size find_if(F&& _compare) const;
+
+  // append |data| by copy
+  bool push_back(const T& _data);
+  // append |data| by move
+  bool push_back(T&& data_);
+
+  void pop_back();
+
+  // append new |T| construct with |args|
+  template<typename... Ts>
+  bool emplace_back(Ts&&... _args);
+
+  Size size() const;
+  constexpr Size capacity() const;
+
+  bool in_range(Size _index) const;
+  bool is_empty() const;
+  bool is_full() const;
+
+  // enumerate collection either forward or reverse
+  template<typename F>
+  bool each_fwd(F&& _func);
+  template<typename F>
+  bool each_rev(F&& _func);
+  template<typename F>
+  bool each_fwd(F&& _func) const;
+  template<typename F>
+  bool each_rev(F&& _func) const;
+
+  void erase(Size _from, Size _to);
+
+  // first or last element
+  const T& first() const;
+  T& first();
+  const T& last() const;
+  T& last();
+
+  const T* data() const;
+  T* data();
+
+private:
+  Memory::UninitializedStorage<sizeof(T) * E, alignof(T)> m_storage;
+  Size m_size;
+};
+
+template<typename T, Size E>
+inline constexpr StaticVector<T, E>::StaticVector()
+  : m_size{0}
+{
+}
+
+template<typename T, Size E>
+inline StaticVector<T, E>::StaticVector(const StaticVector& _other)
+  : m_size{_other.m_size}
+{
+  if constexpr (traits::is_trivially_copyable<T>) {
+    detail::copy(data(), _other.data(), sizeof(T) * m_size);
+  } else for (Size i = 0; i < m_size; i++) {
+    Utility::construct<T>(data() + i, _other[i]);
+  }
+}
+
+template<typename T, Size E>
+inline StaticVector<T, E>::StaticVector(StaticVector&& other_)
+  : m_size{other_.m_size}
+{
+  if constexpr (traits::is_trivially_copyable<T>) {
+    detail::copy(data(), other_.data(), sizeof(T) * m_size);
+  } else for (Size i = 0; i < m_size; i++) {
+    Utility::construct<T>(data() + i, Utility::move(other_[i]));
+  }
+  other_.clear();
+}
+
+template<typename T, Size E>
+inline StaticVector<T, E>::~StaticVector() {
+  clear();
+}
+
+template<typename T, Size E>
+inline StaticVector<T, E>& StaticVector<T, E>::operator=(const StaticVector& _other) {
+  RX_ASSERT(&_other != this, "self assignment");
+
+  clear();
+
+  m_size = _other.m_size;
+  if constexpr (traits::is_trivially_copyable<T>) {
+    detail::copy(data(), _other.data(), sizeof(T) * m_size);
+  } else for (Size i = 0; i < m_size; i++) {
+    Utility::construct<T>(data() + i, _other[i]);
+  }
+
+  return *this;
+}
+
+template<typename T, Size E>
+inline StaticVector<T, E>& StaticVector<T, E>::operator=(StaticVector&& other_) {
+  RX_ASSERT(&other_ != this, "self assignment");
+
+  clear();
+
+  m_size = other_.m_size;
+  if constexpr (traits::is_trivially_copyable<T>) {
+    detail::copy(data(), other_.data(), sizeof(T) * m_size);
+  } else for (Size i = 0; i < m_size; i++) {
+    Utility::construct<T>(data() + i, Utility::move(other_[i]));
+  }
+  other_.clear();
+
+  return *this;
+}
+
+template<typename T, Size E>
+inline T& StaticVector<T, E>::operator[](Size _index) {
+  RX_ASSERT(in_range(_index), "out of bounds (%zu >= %zu)", _index, m_size);
+  return data()[_index];
+}
+
+template<typename T, Size E>
+inline const T& StaticVector<T, E>::operator[](Size _index) const {
+  RX_ASSERT(in_range(_index), "out of bounds (%zu >= %zu)", _index, m_size);
+  return data()[_index];
+}
+
+template<typename T, Size E>
+inline bool StaticVector<T, E>::resize(Size _size, const T& _value) {
+  if (_size > E) {
+    return false;
+  }
+
+  if constexpr (!traits::is_trivially_destructible<T>) {
+    for (Size i = m_size; i > _size; --i) {
+      Utility::destruct<T>(data() + (i - 1));
+    }
+  }
+
+  for (Size i = m_size; i < _size; i++) {
+    Utility::construct<T>(data() + i, _value);
+  }
+
+  m_size = _size;
+  return true;
+}
+
+template<typename T, Size E>
+inline void StaticVector<T, E>::clear() {
+  if constexpr (!traits::is_trivially_destructible<T>) {
+    for (Size i = m_size - 1; i < m_size; i--) {
+      Utility::destruct<T>(data() + i);
+    }
+  }
+  m_size = 0;
+}
+
+template<typename T, Size E>
+inline Size StaticVector<T, E>::find(const T& _value) const {
+  for (Size i = 0; i < m_size; i++) {
+    if (data()[i] == _value) {
+      return i;
+    }
+  }
+  return k_npos;
+}
+
+template<typename T, Size E>
+template<typename F>
+inline Size StaticVector<T, E>::find_if(F&& _compare) const {
+  for (Size i = 0; i < m_size; i++) {
+    if (_compare(data()[i])) {
+      return i;
+    }
+  }
+  return k_npos;
+}
+
+template<typename T, Size E>
+inline bool StaticVector<T, E>::push_back(const T& _value) {
+  return emplace_back(_value);
+}
+
+template<typename T, Size E>
+inline bool StaticVector<T, E>::push_back(T&& value_) {
+  return emplace_back(Utility::move(value_));
+}
+
+template<typename T, Size E>
+inline void StaticVector<T, E>::pop_back() {
+  RX_ASSERT(m_size, "empty vector");
+  m_size--;
+  if constexpr (!traits::is_trivially_destructible<T>) {
+    Utility::destruct<T>(data() + m_size);
+  }
+}
+
+template<typename T, Size E>
+template<typename... Ts>
+inline bool StaticVector<T, E>::emplace_back(Ts&&... _args) {
+  if (RX_HINT_UNLIKELY(m_size == E)) {
+    return false;
+  }
+
+  Utility::construct<T>(data() + m_size, Utility::forward<Ts>(_args)...);
+
+  m_size++;
+  return true;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE Size StaticVector<T, E>::size() const {
+  return m_size;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE constexpr Size StaticVector<T, E>::capacity() const {
+  return E;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE bool StaticVector<T, E>::in_range(Size _index) const {
+  return _index < m_size;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE bool StaticVector<T, E>::is_empty() const {
+  return m_size == 0;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE bool StaticVector<T, E>::is_full() const {
+  return m_size == E;
+}
+
+template<typename T, Size E>
+template<typename F>
+inline bool StaticVector<T, E>::each_fwd(F&& _func) {
+  for (Size i = 0; i < m_size; i++) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      if (!_func(data()[i])) {
+        return false;
+      }
+    } else {
+      _func(data()[i]);
+    }
+  }
+  return true;
+}
+
+template<typename T, Size E>
+template<typename F>
+inline bool StaticVector<T, E>::each_fwd(F&& _func) const {
+  for (Size i = 0; i < m_size; i++) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      if (!_func(data()[i])) {
+        return false;
+      }
+    } else {
+      _func(data()[i]);
+    }
+  }
+  return true;
+}
+
+template<typename T, Size E>
+template<typename F>
+inline bool StaticVector<T, E>::each_rev(F&& _func) {
+  for (Size i = m_size - 1; i < m_size; i--) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      if (!_func(data()[i])) {
+        return false;
+      }
+    } else {
+      _func(data()[i]);
+    }
+  }
+  return true;
+}
+
+template<typename T, Size E>
+template<typename F>
+inline bool StaticVector<T, E>::each_rev(F&& _func) const {
+  for (Size i = m_size - 1; i < m_size; i--) {
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      if (!_func(data()[i])) {
+        return false;
+      }
+    } else {
+      _func(data()[i]);
+    }
+  }
+  return true;
+}
+
+template<typename T, Size E>
+inline void StaticVector<T, E>::erase(Size _from, Size _to) {
+  const Size range = _to - _from;
+  T* end = data() + m_size;
+
+  for (T* value = data() + _to, *dest = data() + _from; value != end; ++value, ++dest) {
+    *dest = Utility::move(*value);
+  }
+
+  if constexpr (!traits::is_trivially_destructible<T>) {
+    for (T* value = end - range; value < end; ++value) {
+      Utility::destruct<T>(value);
+    }
+  }
+
+  m_size -= range;
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE const T& StaticVector<T, E>::first() const {
+  RX_ASSERT(m_size, "empty vector");
+  return data()[0];
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE T& StaticVector<T, E>::first() {
+  RX_ASSERT(m_size, "empty vector");
+  return data()[0];
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE const T& StaticVector<T, E>::last() const {
+  RX_ASSERT(m_size, "empty vector");
+  return data()[m_size - 1];
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE T& StaticVector<T, E>::last() {
+  RX_ASSERT(m_size, "empty vector");
+  return data()[m_size - 1];
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE const T* StaticVector<T, E>::data() const {
+  return reinterpret_cast<const T*>(m_storage.data());
+}
+
+template<typename T, Size E>
+RX_HINT_FORCE_INLINE T* StaticVector<T, E>::data() {
+  return reinterpret_cast<T*>(m_storage.data());
+}
+
+} // namespace rx
+
+#endif // RX_CORE_STATIC_VECTOR_H
@@ -2,7 +2,7 @@
 #include <string.h> // memmove
 
 #include "rx/core/stream.h"
-#include "rx/core/string.h" // utf16_to_utf8
+#include "rx/core/string.h" // utf16_to_utf8, utf16_to_utf8_length
 #include "rx/core/abort.h"
 
 #include "rx/core/hints/may_alias.h"
@@ -33,7 +33,7 @@ static Vector<Byte> convert_text_encoding(Vector<Byte>&& data_) {
     }
 
     // Determine how many bytes are needed to convert the encoding.
-    const Size length = utf16_to_utf8(contents, chars, nullptr);
+    const Size length = utf16_to_utf8_length(contents, chars);
 
     // Convert UTF-16 to UTF-8.
     Vector<Byte> result{data_.allocator(), length, Utility::UninitializedTag{}};
@@ -3,53 +3,279 @@
 #include <stdio.h> // vsnprintf
 
 #include "rx/core/string.h" // string
+#include "rx/core/string_view.h"
 
 #include "rx/core/utility/swap.h"
+#include "rx/core/utility/bit.h"
 
-#include "rx/core/hash/fnv1a.h"
+#include "rx/core/hash/wyhash.h"
 
-#include "rx/core/hints/unreachable.h"
 #include "rx/core/hints/unlikely.h"
 
+#if defined(RX_HAS_AVX2)
+#include <immintrin.h> // __m256i, _mm256_*
+#elif defined(RX_HAS_SSE2)
+#include <emmintrin.h> // __m128i, _mm_*
+#endif
+
 namespace Rx {
 
+// Invalid sequences are converted to the replacement character.
+static constexpr const Uint32 k_replacement_character = 0xfffd;
+
+// Decode the UTF-8 sequence at the start of |_contents|. Returns the number of
+// bytes in the sequence or zero when the sequence is invalid, which is the
+// case for truncated, overlong and surrogate sequences.
+static Size utf8_decode(const char* _contents, Size _length, Uint32& code_point_) {
+  const auto data = reinterpret_cast<const Byte*>(_contents);
+  const Byte lead = data[0];
+
+  Size size = 0;
+  Uint32 code_point = 0;
+  Uint32 minimum = 0;
+  if (lead <= 0x7f) {
+    code_point_ = lead;
+    return 1;
+  } else if ((lead & 0xe0) == 0xc0) {
+    size = 2;
+    code_point = lead & 0x1f;
+    minimum = 0x80;
+  } else if ((lead & 0xf0) == 0xe0) {
+    size = 3;
+    code_point = lead & 0x0f;
+    minimum = 0x800;
+  } else if ((lead & 0xf8) == 0xf0) {
+    size = 4;
+    code_point = lead & 0x07;
+    minimum = 0x10000;
+  } else {
+    return 0;
+  }
+
+  if (size > _length) {
+    return 0;
+  }
+
+  for (Size i = 1; i < size; i++) {
+    if ((data[i] & 0xc0) != 0x80) {
+      return 0;
+    }
+    code_point = (code_point << 6) | (data[i] & 0x3f);
+  }
+
+  if (code_point < minimum || code_point > 0x10ffff
+    || (code_point >= 0xd800 && code_point <= 0xdfff))
+  {
+    return 0;
+  }
+
+  code_point_ = code_point;
+  return size;
+}
+
+// Decode the UTF-16 sequence at the start of |_contents|. Returns the number
+// of elements in the sequence or zero for an unpaired surrogate.
+static Size utf16_decode(const Uint16* _contents, Size _length, Uint32& code_point_) {
+  const Uint32 element = _contents[0];
+  if (element < 0xd800 || element > 0xdfff) {
+    code_point_ = element;
+    return 1;
+  }
+
+  if (element <= 0xdbff && _length >= 2
+    && _contents[1] >= 0xdc00 && _contents[1] <= 0xdfff)
+  {
+    code_point_ = 0x10000 + ((element - 0xd800) << 10) + (_contents[1] - 0xdc00);
+    return 2;
+  }
+
+  return 0;
+}
+
+static Size utf8_encoded_size(Uint32 _code_point) {
+  if (_code_point <= 0x7f) {
+    return 1;
+  } else if (_code_point <= 0x7ff) {
+    return 2;
+  } else if (_code_point <= 0xffff) {
+    return 3;
+  }
+  return 4;
+}
+
+// Text is mostly ASCII, which is the same in all three encodings. The leading
+// run of ASCII characters is found, and converted, a vector at a time.
+static Size utf8_ascii_span(const char* _contents, Size _length) {
+  Size i = 0;
+#if defined(RX_HAS_AVX2)
+  for (; i + 32 <= _length; i += 32) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_contents + i));
+    if (const Uint32 mask = _mm256_movemask_epi8(chunk)) {
+      return i + bit_search_lsb(mask);
+    }
+  }
+#endif
+#if defined(RX_HAS_SSE2)
+  for (; i + 16 <= _length; i += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_contents + i));
+    if (const Uint32 mask = _mm_movemask_epi8(chunk)) {
+      return i + bit_search_lsb(mask);
+    }
+  }
+#endif
+  for (; i < _length && static_cast<Byte>(_contents[i]) <= 0x7f; i++);
+  return i;
+}
+
+static Size utf16_ascii_span(const Uint16* _contents, Size _length) {
+  Size i = 0;
+#if defined(RX_HAS_AVX2)
+  const __m256i high_wide = _mm256_set1_epi16(static_cast<short>(0xff80));
+  for (; i + 16 <= _length; i += 16) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_contents + i));
+    const __m256i ascii = _mm256_cmpeq_epi16(_mm256_and_si256(chunk, high_wide), _mm256_setzero_si256());
+    const Uint32 mask = ~static_cast<Uint32>(_mm256_movemask_epi8(ascii));
+    if (mask) {
+      return i + bit_search_lsb(mask) / 2;
+    }
+  }
+#endif
+#if defined(RX_HAS_SSE2)
+  const __m128i high = _mm_set1_epi16(static_cast<short>(0xff80));
+  for (; i + 8 <= _length; i += 8) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_contents + i));
+    const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(chunk, high), _mm_setzero_si128());
+    const Uint32 mask = ~static_cast<Uint32>(_mm_movemask_epi8(ascii)) & 0xffff;
+    if (mask) {
+      return i + bit_search_lsb(mask) / 2;
+    }
+  }
+#endif
+  for (; i < _length && _contents[i] <= 0x7f; i++);
+  return i;
+}
+
+// Widen the leading run of ASCII characters into |utf16_contents_|.
+static Size utf8_widen_ascii(const char* _contents, Size _length, Uint16* utf16_contents_) {
+  Size i = 0;
+#if defined(RX_HAS_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= _length; i += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_contents + i));
+    if (_mm_movemask_epi8(chunk)) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(utf16_contents_ + i), _mm_unpacklo_epi8(chunk, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(utf16_contents_ + i + 8), _mm_unpackhi_epi8(chunk, zero));
+  }
+#endif
+  for (; i < _length && static_cast<Byte>(_contents[i]) <= 0x7f; i++) {
+    utf16_contents_[i] = static_cast<Byte>(_contents[i]);
+  }
+  return i;
+}
+
+// Narrow the leading run of ASCII characters into |utf8_contents_|.
+static Size utf16_narrow_ascii(const Uint16* _contents, Size _length, char* utf8_contents_) {
+  Size i = 0;
+#if defined(RX_HAS_SSE2)
+  const __m128i high = _mm_set1_epi16(static_cast<short>(0xff80));
+  for (; i + 16 <= _length; i += 16) {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_contents + i));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_contents + i + 8));
+    const __m128i test = _mm_and_si128(_mm_or_si128(lo, hi), high);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(test, _mm_setzero_si128())) != 0xffff) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(utf8_contents_ + i), _mm_packus_epi16(lo, hi));
+  }
+#endif
+  for (; i < _length && _contents[i] <= 0x7f; i++) {
+    utf8_contents_[i] = static_cast<char>(_contents[i]);
+  }
+  return i;
+}
+
+bool utf8_validate(const char* _utf8_contents, Size _length) {
+  for (Size i = 0; i < _length; ) {
+    i += utf8_ascii_span(_utf8_contents + i, _length - i);
+    if (i == _length) {
+      break;
+    }
+
+    Uint32 code_point = 0;
+    const Size size = utf8_decode(_utf8_contents + i, _length - i, code_point);
+    if (!size) {
+      return false;
+    }
+    i += size;
+  }
+  return true;
+}
+
+Size utf8_to_utf16_length(const char* _utf8_contents, Size _length) {
+  Size elements = 0;
+  for (Size i = 0; i < _length; ) {
+    const Size ascii = utf8_ascii_span(_utf8_contents + i, _length - i);
+    elements += ascii;
+    i += ascii;
+    if (i == _length) {
+      break;
+    }
+
+    Uint32 code_point = k_replacement_character;
+    const Size size = utf8_decode(_utf8_contents + i, _length - i, code_point);
+    elements += code_point > 0xffff ? 2 : 1;
+    i += size ? size : 1;
+  }
+  return elements;
+}
+
+Size utf16_to_utf8_length(const Uint16* _utf16_contents, Size _length) {
+  Size elements = 0;
+  for (Size i = 0; i < _length; ) {
+    const Size ascii = utf16_ascii_span(_utf16_contents + i, _length - i);
+    elements += ascii;
+    i += ascii;
+    if (i == _length) {
+      break;
+    }
+
+    Uint32 code_point = k_replacement_character;
+    const Size size = utf16_decode(_utf16_contents + i, _length - i, code_point);
+    elements += utf8_encoded_size(code_point);
+    i += size ? size : 1;
+  }
+  return elements;
+}
+
 Size utf8_to_utf16(const char* _utf8_contents, Size _length,
   Uint16* utf16_contents_)
 {
-  Size elements{0};
-  Uint32 code_point{0};
-
-  for (Size i{0}; i < _length; i++) {
-    const char* element{_utf8_contents + i};
-    const Byte element_ch{static_cast<Byte>(*element)};
-
-    if (element_ch <= 0x7f) {
-      code_point = static_cast<Uint16>(element_ch);
-    } else if (element_ch <= 0xbf) {
-      code_point = (code_point << 6) | (element_ch & 0x3f);
-    } else if (element_ch <= 0xdf) {
-      code_point = element_ch & 0x1f;
-    } else if (element_ch <= 0xef) {
-      code_point = element_ch & 0x0f;
-    } else {
-      code_point = element_ch & 0x07;
+  if (!utf16_contents_) {
+    return utf8_to_utf16_length(_utf8_contents, _length);
+  }
+
+  Size elements = 0;
+  for (Size i = 0; i < _length; ) {
+    const Size ascii = utf8_widen_ascii(_utf8_contents + i, _length - i,
+      utf16_contents_ + elements);
+    elements += ascii;
+    i += ascii;
+    if (i == _length) {
+      break;
     }
 
-    element++;
-    if ((*element & 0xc0) != 0x80 && code_point <= 0x10ffff) {
-      if (code_point > 0xffff) {
-        elements += 2;
-        if (utf16_contents_) {
-          *utf16_contents_++ = static_cast<Uint16>(0xd800 + (code_point >> 10));
-          *utf16_contents_++ = static_cast<Uint16>(0xdc00 + (code_point & 0x03ff));
-        }
-      } else if (code_point < 0xd800 || code_point >= 0xe000) {
-        elements += 1;
-        if (utf16_contents_) {
-          *utf16_contents_++ = static_cast<Uint16>(code_point);
-        }
-      }
+    Uint32 code_point = k_replacement_character;
+    const Size size = utf8_decode(_utf8_contents + i, _length - i, code_point);
+    if (code_point > 0xffff) {
+      code_point -= 0x10000;
+      utf16_contents_[elements++] = static_cast<Uint16>(0xd800 + (code_point >> 10));
+      utf16_contents_[elements++] = static_cast<Uint16>(0xdc00 + (code_point & 0x03ff));
+    } else {
+      utf16_contents_[elements++] = static_cast<Uint16>(code_point);
     }
+    i += size ? size : 1;
   }
 
   return elements;
@@ -58,51 +284,48 @@ Size utf8_to_utf16(const char* _utf8_contents, Size _length,
 Size utf16_to_utf8(const Uint16* _utf16_contents, Size _length,
   char* utf8_contents_)
 {
-  Size elements{0};
-  Uint32 code_point{0};
-
-  for (Size i{0}; i < _length; i++) {
-    const Uint16* element{_utf16_contents + i};
-
-    if (*element >= 0xd800 && *element <= 0xdbff) {
-      code_point = ((*element - 0xd800) << 10) + 0x10000;
-    } else {
-      if (*element >= 0xdc00 && *element <= 0xdfff) {
-        code_point |= *element - 0xdc00;
-      } else {
-        code_point = *element;
-      }
-
-      if (code_point < 0x7f) {
-        elements += 1;
-        if (utf8_contents_) {
-          *utf8_contents_++ = static_cast<char>(code_point);
-        }
-      } else if (code_point <= 0x7ff) {
-        elements += 2;
-        if (utf8_contents_) {
-          *utf8_contents_++ = static_cast<char>(0xc0 | ((code_point >> 6) & 0x1f));
-          *utf8_contents_++ = static_cast<char>(0x80 | (code_point & 0x3f));
-        }
-      } else if (code_point <= 0xffff) {
-        elements += 3;
-        if (utf8_contents_) {
-          *utf8_contents_++ = static_cast<char>(0xe0 | ((code_point >> 12) & 0x0f));
-          *utf8_contents_++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
-          *utf8_contents_++ = static_cast<char>(0x80 | (code_point & 0x3f));
-        }
-      } else {
-        elements += 4;
-        if (utf8_contents_) {
-          *utf8_contents_++ = static_cast<char>(0xf0 | ((code_point >> 18) & 0x07));
-          *utf8_contents_++ = static_cast<char>(0x80 | ((code_point >> 12) & 0x3f));
-          *utf8_contents_++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
-          *utf8_contents_++ = static_cast<char>(0x80 | (code_point & 0x3f));
-        }
-      }
+  if (!utf8_contents_) {
+    return utf16_to_utf8_length(_utf16_contents, _length);
+  }
+
+  Size elements = 0;
+  for (Size i = 0; i < _length; ) {
+    const Size ascii = utf16_narrow_ascii(_utf16_contents + i, _length - i,
+      utf8_contents_ + elements);
+    elements += ascii;
+    i += ascii;
+    if (i == _length) {
+      break;
+    }
 
-      code_point = 0;
+    Uint32 code_point = k_replacement_character;
+    const Size size = utf16_decode(_utf16_contents + i, _length - i, code_point);
+    char* element = utf8_contents_ + elements;
+    switch (utf8_encoded_size(code_point)) {
+    case 1:
+      element[0] = static_cast<char>(code_point);
+      elements += 1;
+      break;
+    case 2:
+      element[0] = static_cast<char>(0xc0 | ((code_point >> 6) & 0x1f));
+      element[1] = static_cast<char>(0x80 | (code_point & 0x3f));
+      elements += 2;
+      break;
+    case 3:
+      element[0] = static_cast<char>(0xe0 | ((code_point >> 12) & 0x0f));
+      element[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+      element[2] = static_cast<char>(0x80 | (code_point & 0x3f));
+      elements += 3;
+      break;
+    case 4:
+      element[0] = static_cast<char>(0xf0 | ((code_point >> 18) & 0x07));
+      element[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3f));
+      element[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+      element[3] = static_cast<char>(0x80 | (code_point & 0x3f));
+      elements += 4;
+      break;
     }
+    i += size ? size : 1;
   }
 
   return elements;
@@ -365,10 +588,10 @@ String String::strip(const char* _set) const {
   return {allocator(), beg, end + 1};
 }
 
-Vector<String> String::split(Memory::Allocator& _allocator, int _token, Size _count) const {
+SmallVector<String, 4> String::split(Memory::Allocator& _allocator, int _token, Size _count) const {
   bool quoted{false};
   bool limit{_count > 0};
-  Vector<String> result{_allocator};
+  SmallVector<String, 4> result{_allocator};
 
   // When there is a limit we can reserve the storage upfront.
   if (limit) {
@@ -486,27 +709,19 @@ String String::human_size_format(Size _size) {
 }
 
 bool String::begins_with(const char* _prefix) const {
-  return strstr(m_data, _prefix) == m_data;
+  return StringView{*this}.begins_with(_prefix);
 }
 
 bool String::begins_with(const String& _prefix) const {
-  return strstr(m_data, _prefix.data()) == m_data;
+  return StringView{*this}.begins_with(_prefix);
 }
 
 bool String::ends_with(const char* _suffix) const {
-  if (size() < strlen(_suffix)) {
-    return false;
-  }
-
-  return strcmp(m_data + size() - strlen(_suffix), _suffix) == 0;
+  return StringView{*this}.ends_with(_suffix);
 }
 
 bool String::ends_with(const String& _suffix) const {
-  if (size() < _suffix.size()) {
-    return false;
-  }
-
-  return strcmp(m_data + size() - _suffix.size(), _suffix.data()) == 0;
+  return StringView{*this}.ends_with(_suffix);
 }
 
 bool String::contains(const char* _needle) const {
@@ -518,13 +733,12 @@ bool String::contains(const String& _needle) const {
 }
 
 Size String::hash() const {
-  const Byte* data = reinterpret_cast<const Byte*>(m_data);
-  if constexpr (sizeof(Size) == 8) {
-    return Hash::fnv1a<Uint64>(data, size());
-  } else {
-    return Hash::fnv1a<Uint32>(data, size());
-  }
-  RX_HINT_UNREACHABLE();
+  return hash_of(m_data, size());
+}
+
+Size String::hash_of(const char* _contents, Size _size) {
+  const Byte* data = reinterpret_cast<const Byte*>(_contents);
+  return static_cast<Size>(Hash::wyhash(data, _size));
 }
 
 Memory::View String::disown() {
@@ -553,10 +767,10 @@ Memory::View String::disown() {
 }
 
 WideString String::to_utf16() const {
-  const Size length = utf8_to_utf16(m_data, size(), nullptr);
+  const Size length = utf8_to_utf16_length(m_data, size());
   WideString contents{allocator()};
-  contents.resize(length);
-  utf8_to_utf16(m_data, length, contents.data());
+  RX_ASSERT(contents.resize(length), "out of memory");
+  utf8_to_utf16(m_data, size(), contents.data());
   return contents;
 }
 
@@ -690,9 +904,9 @@ bool WideString::resize(Size _size) {
 }
 
 String WideString::to_utf8() const {
-  Size size{utf16_to_utf8(m_data, m_size, nullptr)};
+  const Size size = utf16_to_utf8_length(m_data, m_size);
   String contents{allocator()};
-  contents.resize(size);
+  RX_ASSERT(contents.resize(size), "out of memory");
   utf16_to_utf8(m_data, m_size, contents.data());
   return contents;
 }
@@ -3,6 +3,7 @@
 #include "rx/core/assert.h" // RX_ASSERT
 #include "rx/core/format.h" // format
 #include "rx/core/vector.h" // vector
+#include "rx/core/small_vector.h" // SmallVector
 
 #include "rx/core/traits/remove_cvref.h"
 
@@ -82,8 +83,8 @@ struct String {
   String strip(const char* _set) const;
 
   // split string by |token| up to |count| times, use |count| of zero for no limit
-  Vector<String> split(Memory::Allocator& _allocator, int _ch, Size _count = 0) const;
-  Vector<String> split(int _ch, Size _count = 0) const;
+  SmallVector<String, 4> split(Memory::Allocator& _allocator, int _ch, Size _count = 0) const;
+  SmallVector<String, 4> split(int _ch, Size _count = 0) const;
 
   // take substring from |offset| of |length|, use |length| of zero for whole string
   String substring(Size _offset, Size _length = 0) const;
@@ -120,6 +121,9 @@ struct String {
 
   Size hash() const;
 
+  // The hash of |_size| bytes of |_contents|, the same as String::hash.
+  static Size hash_of(const char* _contents, Size _size);
+
   WideString to_utf16() const;
 
   constexpr Memory::Allocator& allocator() const;
@@ -285,7 +289,7 @@ inline bool String::insert_at(Size _position, const String& _contents) {
   return insert_at(_position, _contents.data(), _contents.size());
 }
 
-inline Vector<String> String::split(int _ch, Size _count) const {
+inline SmallVector<String, 4> String::split(int _ch, Size _count) const {
   return split(allocator(), _ch, _count);
 }
 
@@ -426,12 +430,23 @@ RX_HINT_FORCE_INLINE constexpr Memory::Allocator& WideString::allocator() const
   return *m_allocator;
 }
 
+// Convert between UTF-8 and UTF-16, returning the number of elements written.
+// Invalid sequences are converted to U+FFFD. Passing nullptr for the output
+// returns the number of elements needed, the same as the *_length functions.
 Size utf16_to_utf8(const Uint16* _utf16_contents, Size _length,
   char* utf8_contents_);
 
 Size utf8_to_utf16(const char* _utf8_contents, Size _length,
   Uint16* utf16_contents_);
 
+// Exact number of elements needed to convert the contents, so the destination
+// can be allocated once.
+Size utf16_to_utf8_length(const Uint16* _utf16_contents, Size _length);
+Size utf8_to_utf16_length(const char* _utf8_contents, Size _length);
+
+// Check that |_utf8_contents| is well-formed UTF-8.
+bool utf8_validate(const char* _utf8_contents, Size _length);
+
 /*
 RX_HINT_FORCE_INLINE Rx::String operator""_s(const char* _contents, Size _length) {
   return {_contents, _length};
@@ -0,0 +1,148 @@
+#include <string.h> // strlen, memcpy
+
+#include "rx/core/string_builder.h"
+#include "rx/core/string.h"
+#include "rx/core/stream.h"
+
+#include "rx/core/algorithm/max.h"
+#include "rx/core/algorithm/min.h"
+
+#include "rx/core/hints/unlikely.h"
+
+namespace Rx {
+
+StringBuilder& StringBuilder::operator=(StringBuilder&& other_) {
+  RX_ASSERT(&other_ != this, "self assignment");
+
+  release();
+
+  m_allocator = other_.m_allocator;
+  m_head = Utility::exchange(other_.m_head, nullptr);
+  m_tail = Utility::exchange(other_.m_tail, nullptr);
+  m_size = Utility::exchange(other_.m_size, 0);
+
+  return *this;
+}
+
+bool StringBuilder::append(const char* _contents, Size _size) {
+  // Fill whatever is left of the last chunk first.
+  if (m_tail) {
+    const Size size = Algorithm::min(_size, m_tail->capacity - m_tail->size);
+    memcpy(m_tail->data() + m_tail->size, _contents, size);
+    m_tail->size += size;
+    m_size += size;
+    _contents += size;
+    _size -= size;
+  }
+
+  if (!_size) {
+    return true;
+  }
+
+  Chunk* chunk = grow(_size);
+  if (RX_HINT_UNLIKELY(!chunk)) {
+    return false;
+  }
+
+  memcpy(chunk->data(), _contents, _size);
+  chunk->size = _size;
+  m_size += _size;
+
+  return true;
+}
+
+bool StringBuilder::append(const char* _contents) {
+  return append(_contents, strlen(_contents));
+}
+
+bool StringBuilder::append(const String& _contents) {
+  return append(_contents.data(), _contents.size());
+}
+
+bool StringBuilder::append(const StringView& _contents) {
+  return append(_contents.data(), _contents.size());
+}
+
+bool StringBuilder::formatter(const char* _format, ...) {
+  // Format directly into the last chunk. When it doesn't fit, the result is
+  // formatted again into a new chunk large enough to hold all of it.
+  char* data = m_tail ? m_tail->data() + m_tail->size : nullptr;
+  Size available = m_tail ? m_tail->capacity - m_tail->size : 0;
+
+  va_list va;
+  va_start(va, _format);
+  // The null-terminator is written too, it's overwritten by the next append.
+  const Size length = format_buffer_va_list(data, available, _format, va);
+  va_end(va);
+
+  if (length < available) {
+    m_tail->size += length;
+    m_size += length;
+    return true;
+  }
+
+  Chunk* chunk = grow(length + 1);
+  if (RX_HINT_UNLIKELY(!chunk)) {
+    return false;
+  }
+
+  va_start(va, _format);
+  format_buffer_va_list(chunk->data(), length + 1, _format, va);
+  va_end(va);
+
+  chunk->size = length;
+  m_size += length;
+
+  return true;
+}
+
+StringBuilder::Chunk* StringBuilder::grow(Size _size) {
+  const Size capacity = Algorithm::max(_size, k_chunk_size);
+  auto chunk = reinterpret_cast<Chunk*>(m_allocator->allocate(sizeof(Chunk) + capacity));
+  if (RX_HINT_UNLIKELY(!chunk)) {
+    return nullptr;
+  }
+
+  chunk->next = nullptr;
+  chunk->size = 0;
+  chunk->capacity = capacity;
+
+  if (m_tail) {
+    m_tail->next = chunk;
+  } else {
+    m_head = chunk;
+  }
+  m_tail = chunk;
+
+  return chunk;
+}
+
+void StringBuilder::release() {
+  for (Chunk* chunk = m_head; chunk; ) {
+    Chunk* next = chunk->next;
+    m_allocator->deallocate(chunk);
+    chunk = next;
+  }
+}
+
+String StringBuilder::flatten(Memory::Allocator& _allocator) const {
+  String result{_allocator};
+  RX_ASSERT(result.reserve(m_size), "out of memory");
+  each_chunk([&](const StringView& _chunk) {
+    result.append(_chunk.data(), _chunk.size());
+  });
+  return result;
+}
+
+String StringBuilder::flatten() const {
+  return flatten(allocator());
+}
+
+bool StringBuilder::write(Stream* _stream) const {
+  return each_chunk([_stream](const StringView& _chunk) {
+    const auto data = reinterpret_cast<const Byte*>(_chunk.data());
+    return _stream->write(data, _chunk.size()) == _chunk.size();
+  });
+}
+
+} // namespace rx
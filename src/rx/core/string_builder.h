@@ -0,0 +1,171 @@
+#ifndef RX_CORE_STRING_BUILDER_H
+#define RX_CORE_STRING_BUILDER_H
+#include "rx/core/format.h" // FormatNormalize
+#include "rx/core/markers.h"
+#include "rx/core/string_view.h"
+
+#include "rx/core/traits/is_same.h"
+#include "rx/core/traits/remove_cvref.h"
+#include "rx/core/traits/return_type.h"
+
+#include "rx/core/utility/exchange.h"
+#include "rx/core/utility/forward.h"
+
+#include "rx/core/memory/system_allocator.h" // memory::{system_allocator, allocator}
+
+#include "rx/core/hints/force_inline.h"
+
+namespace Rx {
+
+struct String;
+struct Stream;
+
+// # String Builder
+//
+// The idea behind a string builder is to assemble large text, such as shader
+// sources or configuration files, out of many small pieces without the
+// repeated reallocation and copying of appending to a String.
+//
+// The contents are stored in a list of chunks which are never moved once
+// written. Appends and formatting write directly into the last chunk and
+// allocate another when it's full. The contents are only ever copied once,
+// either when flattened into a String or when written to a Stream.
+//
+// Chunks are not null-terminated and a single append may be split across
+// two chunks.
+//
+// 32-bit: 16 bytes
+// 64-bit: 32 bytes
+struct StringBuilder {
+  RX_MARK_NO_COPY(StringBuilder);
+
+  static constexpr const Size k_chunk_size = 4096;
+
+  constexpr StringBuilder();
+  constexpr StringBuilder(Memory::Allocator& _allocator);
+  StringBuilder(StringBuilder&& other_);
+  ~StringBuilder();
+
+  StringBuilder& operator=(StringBuilder&& other_);
+
+  bool append(const char* _contents, Size _size);
+  bool append(const char* _contents);
+  bool append(const String& _contents);
+  bool append(const StringView& _contents);
+  bool append(char _ch);
+
+  // format |_format| with |_arguments| directly into the builder
+  template<typename... Ts>
+  bool format(const char* _format, Ts&&... _arguments);
+
+  void clear();
+
+  Size size() const;
+  bool is_empty() const;
+
+  // enumerate the contents a chunk at a time as StringView
+  template<typename F>
+  bool each_chunk(F&& _func) const;
+
+  // copy the contents into a single String
+  String flatten(Memory::Allocator& _allocator) const;
+  String flatten() const;
+
+  // write the contents to |_stream| without flattening
+  bool write(Stream* _stream) const;
+
+  constexpr Memory::Allocator& allocator() const;
+
+private:
+  // The characters of a chunk are stored immediately after it.
+  struct Chunk {
+    Chunk* next;
+    Size size;
+    Size capacity;
+    char* data() { return reinterpret_cast<char*>(this + 1); }
+    const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+  };
+
+  bool formatter(const char* _format, ...);
+  Chunk* grow(Size _size);
+  void release();
+
+  Memory::Allocator* m_allocator;
+  Chunk* m_head;
+  Chunk* m_tail;
+  Size m_size;
+};
+
+inline constexpr StringBuilder::StringBuilder()
+  : StringBuilder{Memory::SystemAllocator::instance()}
+{
+}
+
+inline constexpr StringBuilder::StringBuilder(Memory::Allocator& _allocator)
+  : m_allocator{&_allocator}
+  , m_head{nullptr}
+  , m_tail{nullptr}
+  , m_size{0}
+{
+}
+
+inline StringBuilder::StringBuilder(StringBuilder&& other_)
+  : m_allocator{other_.m_allocator}
+  , m_head{Utility::exchange(other_.m_head, nullptr)}
+  , m_tail{Utility::exchange(other_.m_tail, nullptr)}
+  , m_size{Utility::exchange(other_.m_size, 0)}
+{
+}
+
+inline StringBuilder::~StringBuilder() {
+  release();
+}
+
+inline bool StringBuilder::append(char _ch) {
+  return append(&_ch, 1);
+}
+
+template<typename... Ts>
+inline bool StringBuilder::format(const char* _format, Ts&&... _arguments) {
+  return formatter(_format, FormatNormalize<traits::remove_cvref<Ts>>{}(Utility::forward<Ts>(_arguments))...);
+}
+
+inline void StringBuilder::clear() {
+  release();
+  m_head = nullptr;
+  m_tail = nullptr;
+  m_size = 0;
+}
+
+RX_HINT_FORCE_INLINE Size StringBuilder::size() const {
+  return m_size;
+}
+
+RX_HINT_FORCE_INLINE bool StringBuilder::is_empty() const {
+  return m_size == 0;
+}
+
+template<typename F>
+inline bool StringBuilder::each_chunk(F&& _func) const {
+  for (const Chunk* chunk = m_head; chunk; chunk = chunk->next) {
+    if (!chunk->size) {
+      continue;
+    }
+    if constexpr (traits::is_same<traits::return_type<F>, bool>) {
+      if (!_func(StringView{chunk->data(), chunk->size})) {
+        return false;
+      }
+    } else {
+      _func(StringView{chunk->data(), chunk->size});
+    }
+  }
+  return true;
+}
+
+RX_HINT_FORCE_INLINE constexpr Memory::Allocator& StringBuilder::allocator() const {
+  return *m_allocator;
+}
+
+} // namespace rx
+
+#endif // RX_CORE_STRING_BUILDER_H
@@ -1,45 +1,157 @@
-#include <string.h> // strstr, strlen, memcpy
+#include <string.h> // strlen, memcmp, memcpy, memset
 
 #include "rx/core/string_table.h"
 #include "rx/core/string.h"
 
+#include "rx/core/algorithm/quick_sort.h"
+#include "rx/core/algorithm/min.h"
+
+#include "rx/core/utility/swap.h"
+
 #include "rx/core/hints/unlikely.h"
+#include "rx/core/hints/unreachable.h"
 
 namespace Rx {
 
+// The index is kept at most three quarters full.
+static constexpr const Size k_index_min_capacity = 16;
+
+// Largest table the index can refer into.
+static constexpr const Size k_max_size = 0xffffffff_z;
+
+static inline bool index_is_full(Size _count, Size _capacity) {
+  return _count * 4 >= _capacity * 3;
+}
+
 StringTable::StringTable(Memory::Allocator& _allocator, const char* _data, Size _size)
   : m_data{_allocator, _size}
+  , m_index{_allocator}
+  , m_count{0}
 {
   RX_ASSERT(_data[_size] == '\0', "missing null-terminator");
   memcpy(m_data.data(), _data, _size);
 }
 
-Optional<Size> StringTable::find(const char* _string) const {
-  if (RX_HINT_UNLIKELY(m_data.is_empty())) {
+Optional<Size> StringTable::find(const char* _string, Size _size, Size _hash) const {
+  if (RX_HINT_UNLIKELY(m_index.is_empty())) {
     return nullopt;
   }
 
-  if (const char* search = strstr(m_data.data(), _string)) {
-    return static_cast<Size>(search - m_data.data());
+  const Size mask = m_index.size() - 1;
+  for (Size index = _hash & mask; ; index = (index + 1) & mask) {
+    const Slot& slot = m_index[index];
+    if (!slot.offset) {
+      return nullopt;
+    }
+
+    // Compare the |_size| characters, then check the string in the table
+    // ends there too, rather than being a longer string with this prefix.
+    // The table is null-terminated so reading |_size| characters of a shorter
+    // string stops being equal at it's terminator and never reads past the
+    // end of the table.
+    if (slot.hash == static_cast<Uint32>(_hash)) {
+      const char* string = m_data.data() + slot.offset - 1;
+      if (!memcmp(string, _string, _size) && string[_size] == '\0') {
+        return slot.offset - 1;
+      }
+    }
   }
-  return nullopt;
+
+  RX_HINT_UNREACHABLE();
 }
 
-Optional<Size> StringTable::add(const char* _string, Size _size) {
+Optional<Size> StringTable::add(const char* _string, Size _size, Size _hash) {
+  if (index_is_full(m_count + 1, m_index.size())) {
+    const Size capacity = m_index.is_empty() ? k_index_min_capacity : m_index.size() * 2;
+    if (!grow_index(capacity)) {
+      return nullopt;
+    }
+  }
+
+  // Offsets in the index are 32-bit.
   const Size index = m_data.size();
   const Size total = _size + 1;
-  if (m_data.resize(index + total, Utility::UninitializedTag{})) {
-    memcpy(m_data.data() + index, _string, total);
-    return index;
+  if (index + total > k_max_size) {
+    return nullopt;
+  }
+
+  if (!m_data.resize(index + total, Utility::UninitializedTag{})) {
+    return nullopt;
+  }
+
+  memcpy(m_data.data() + index, _string, _size);
+  m_data[index + _size] = '\0';
+
+  link(_hash, index);
+  m_count++;
+
+  return index;
+}
+
+bool StringTable::grow_index(Size _capacity) {
+  Vector<Slot> index{allocator()};
+  if (!index.resize(_capacity)) {
+    return false;
+  }
+
+  Utility::swap(m_index, index);
+  index.each_fwd([this](const Slot& _slot) {
+    if (_slot.offset) {
+      link(_slot.hash, _slot.offset - 1);
+    }
+  });
+
+  return true;
+}
+
+bool StringTable::rebuild_index() {
+  Size count = 0;
+  for (Size offset = 0; offset < m_data.size(); offset += strlen(m_data.data() + offset) + 1) {
+    count++;
+  }
+
+  Size capacity = k_index_min_capacity;
+  while (index_is_full(count, capacity)) {
+    capacity *= 2;
+  }
+
+  m_index.clear();
+  if (!m_index.resize(capacity)) {
+    return false;
+  }
+
+  for (Size offset = 0; offset < m_data.size(); ) {
+    const Size size = strlen(m_data.data() + offset);
+    link(String::hash_of(m_data.data() + offset, size), offset);
+    offset += size + 1;
+  }
+
+  m_count = count;
+
+  return true;
+}
+
+void StringTable::link(Size _hash, Size _offset) {
+  const Size mask = m_index.size() - 1;
+  Size index = _hash & mask;
+  while (m_index[index].offset) {
+    index = (index + 1) & mask;
   }
-  return nullopt;
+  m_index[index] = {static_cast<Uint32>(_hash), static_cast<Uint32>(_offset + 1)};
 }
 
 Optional<Size> StringTable::insert(const char* _string, Size _size) {
-  if (auto search = find(_string)) {
+  // A table constructed from raw string data has no index yet.
+  if (RX_HINT_UNLIKELY(m_index.is_empty() && !m_data.is_empty()) && !rebuild_index()) {
+    return nullopt;
+  }
+
+  const Size hash = String::hash_of(_string, _size);
+  if (auto search = find(_string, _size, hash)) {
     return *search;
   }
-  return add(_string, _size);
+
+  return add(_string, _size, hash);
 }
 
 Optional<Size> StringTable::insert(const char* _string) {
@@ -50,4 +162,123 @@ Optional<Size> StringTable::insert(const String& _string) {
   return insert(_string.data(), _string.size());
 }
 
+// The last (up to) eight characters of a string, last character in the most
+// significant byte. Comparing these orders most strings by their reversed
+// characters without reading the table.
+static inline Uint64 suffix_key(const char* _string, Size _size) {
+  const auto string = reinterpret_cast<const Byte*>(_string);
+  const Size size = Algorithm::min(_size, 8_z);
+  Uint64 key = 0;
+  for (Size i = 1; i <= size; i++) {
+    key |= static_cast<Uint64>(string[_size - i]) << (64 - 8 * i);
+  }
+  return key;
+}
+
+bool StringTable::compact(Map<Size, Size>& remap_) {
+  struct Entry {
+    Uint64 key;
+    Size offset;
+    Size size;
+    Size compacted_offset;
+    Uint32 hash;
+  };
+
+  // The index has the offset and hash of every string, take them from there
+  // rather than scanning and hashing the table again.
+  if (RX_HINT_UNLIKELY(m_index.is_empty() && !m_data.is_empty()) && !rebuild_index()) {
+    return false;
+  }
+
+  const char* data = m_data.data();
+
+  Vector<Entry> entries{allocator()};
+  if (!entries.reserve(m_count)) {
+    return false;
+  }
+
+  for (Size i = 0; i < m_index.size(); i++) {
+    const Slot& slot = m_index[i];
+    if (slot.offset) {
+      const Size offset = slot.offset - 1;
+      const Size size = strlen(data + offset);
+      entries.push_back({suffix_key(data + offset, size), offset, size, 0, slot.hash});
+    }
+  }
+
+  // Sort by the reversed strings in descending order. A string which is a
+  // suffix of another sorts after it, with only strings sharing that suffix
+  // in between.
+  Algorithm::quick_sort(entries.data(), entries.data() + entries.size(),
+    [data](const Entry& _lhs, const Entry& _rhs) {
+      if (_lhs.key != _rhs.key) {
+        return _lhs.key > _rhs.key;
+      }
+
+      // The keys only differ from the ninth last character on.
+      const auto lhs = reinterpret_cast<const Byte*>(data + _lhs.offset + _lhs.size);
+      const auto rhs = reinterpret_cast<const Byte*>(data + _rhs.offset + _rhs.size);
+      const Size size = Algorithm::min(_lhs.size, _rhs.size);
+      for (Size i = 9; i <= size; i++) {
+        if (lhs[-i] != rhs[-i]) {
+          return lhs[-i] > rhs[-i];
+        }
+      }
+      return _lhs.size > _rhs.size;
+    });
+
+  Vector<char> compacted{allocator()};
+  if (!compacted.reserve(m_data.size())) {
+    return false;
+  }
+
+  // The last string stored in |compacted|.
+  const Entry* stored = nullptr;
+
+  remap_.clear();
+  for (Size i = 0; i < entries.size(); i++) {
+    Entry& entry = entries[i];
+    if (stored && entry.size <= stored->size && !memcmp(data + entry.offset,
+      data + stored->offset + stored->size - entry.size, entry.size))
+    {
+      entry.compacted_offset = stored->compacted_offset + stored->size - entry.size;
+    } else {
+      stored = &entry;
+      entry.compacted_offset = compacted.size();
+
+      const Size total = entry.size + 1;
+      if (!compacted.resize(entry.compacted_offset + total, Utility::UninitializedTag{})) {
+        return false;
+      }
+      memcpy(compacted.data() + entry.compacted_offset, data + entry.offset, total);
+    }
+
+    if (!remap_.insert(entry.offset, entry.compacted_offset)) {
+      return false;
+    }
+  }
+
+  m_data = Utility::move(compacted);
+
+  // Index every string at it's new offset, including the ones sharing the
+  // storage of another string, so they're found by |insert|. There are as
+  // many strings as before so the index keeps it's capacity.
+  memset(m_index.data(), 0, sizeof(Slot) * m_index.size());
+  entries.each_fwd([this](const Entry& _entry) {
+    link(_entry.hash, _entry.compacted_offset);
+  });
+
+  return true;
+}
+
+void StringTable::clear() {
+  m_data.clear();
+
+  // Keep the capacity of the index, tables are often cleared and refilled.
+  if (m_index.size()) {
+    memset(m_index.data(), 0, sizeof(Slot) * m_index.size());
+  }
+  m_count = 0;
+}
+
 } // namespace rx
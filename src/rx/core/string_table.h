@@ -2,11 +2,21 @@
 #define RX_CORE_STRING_TABLE_H
 #include "rx/core/vector.h"
 #include "rx/core/optional.h"
+#include "rx/core/map.h"
 
 namespace Rx {
 
 struct String;
 
+// # String Table
+//
+// The idea behind a string table is to store many null-terminated strings in
+// one contiguous buffer and refer to them by offset into it. Inserting a string
+// which is already in the table returns the offset of the existing string.
+//
+// Deduplication is done with a hash index from string to offset kept alongside
+// the data, an insert is O(1) amortized. A table constructed from raw string
+// data builds the index the first time something is inserted into it.
 struct StringTable {
   constexpr StringTable();
   constexpr StringTable(Memory::Allocator& _allocator);
@@ -25,6 +35,12 @@ struct StringTable {
   Optional<Size> insert(const char* _string);
   Optional<Size> insert(const String& _string);
 
+  // Share the storage of strings which are a suffix of another string, e.g
+  // "bar" is stored as the end of "foobar". Offsets previously returned by
+  // |insert| are no longer valid, |remap_| maps every previous offset of a
+  // string to it's new offset.
+  bool compact(Map<Size, Size>& remap_);
+
   const char* operator[](Size _index) const;
 
   const char* data() const;
@@ -35,10 +51,23 @@ struct StringTable {
   constexpr Memory::Allocator& allocator() const;
 
 private:
-  Optional<Size> find(const char* _string) const;
-  Optional<Size> add(const char* _string, Size _size);
+  // Slots are kept small so more of the index stays in cache, the hash is
+  // only compared to skip most mismatching strings without reading them.
+  struct Slot {
+    Uint32 hash;
+    Uint32 offset; // Offset of the string plus one, zero when the slot is empty.
+  };
+
+  Optional<Size> find(const char* _string, Size _size, Size _hash) const;
+  Optional<Size> add(const char* _string, Size _size, Size _hash);
+
+  bool grow_index(Size _capacity);
+  bool rebuild_index();
+  void link(Size _hash, Size _offset);
 
   Vector<char> m_data;
+  Vector<Slot> m_index;
+  Size m_count;
 };
 
 inline constexpr StringTable::StringTable()
@@ -48,31 +77,43 @@ inline constexpr StringTable::StringTable()
 
 inline constexpr StringTable::StringTable(Memory::Allocator& _allocator)
   : m_data{_allocator}
+  , m_index{_allocator}
+  , m_count{0}
 {
 }
 
 inline StringTable::StringTable(Vector<char>&& data_)
   : m_data{Utility::move(data_)}
+  , m_index{m_data.allocator()}
+  , m_count{0}
 {
 }
 
 inline StringTable::StringTable(StringTable&& string_table_)
   : m_data{Utility::move(string_table_.m_data)}
+  , m_index{Utility::move(string_table_.m_index)}
+  , m_count{Utility::exchange(string_table_.m_count, 0)}
 {
 }
 
 inline StringTable::StringTable(const StringTable& _string_table)
   : m_data{_string_table.m_data}
+  , m_index{_string_table.m_index}
+  , m_count{_string_table.m_count}
 {
 }
 
 inline StringTable& StringTable::operator=(StringTable&& string_table_) {
   m_data = Utility::move(string_table_.m_data);
+  m_index = Utility::move(string_table_.m_index);
+  m_count = Utility::exchange(string_table_.m_count, 0);
   return *this;
 }
 
 inline StringTable& StringTable::operator=(const StringTable& _string_table) {
   m_data = _string_table.m_data;
+  m_index = _string_table.m_index;
+  m_count = _string_table.m_count;
   return *this;
 }
 
@@ -88,10 +129,6 @@ inline Size StringTable::size() const {
   return m_data.size();
 }
 
-inline void StringTable::clear() {
-  m_data.clear();
-}
-
 RX_HINT_FORCE_INLINE constexpr Memory::Allocator& StringTable::allocator() const {
   return m_data.allocator();
 }
@@ -0,0 +1,159 @@
+#include <string.h> // strlen, strchr, memchr, memcmp, memcpy
+
+#include "rx/core/string_view.h"
+#include "rx/core/string.h"
+
+#include "rx/core/algorithm/min.h"
+
+namespace Rx {
+
+StringView::StringView(const char* _contents)
+  : m_data{_contents}
+  , m_size{strlen(_contents)}
+{
+}
+
+StringView::StringView(const String& _contents)
+  : m_data{_contents.data()}
+  , m_size{_contents.size()}
+{
+}
+
+Size StringView::find_first_of(int _ch) const {
+  if (auto search = static_cast<const char*>(memchr(m_data, _ch, m_size))) {
+    return search - m_data;
+  }
+  return k_npos;
+}
+
+Size StringView::find_first_of(const StringView& _contents) const {
+  if (_contents.m_size > m_size) {
+    return k_npos;
+  } else if (_contents.m_size == 0) {
+    return 0;
+  }
+
+  // Search for the first character and compare the rest from there.
+  const char* end = m_data + m_size - _contents.m_size + 1;
+  for (const char* ch = m_data; ch < end; ch++) {
+    ch = static_cast<const char*>(memchr(ch, _contents.m_data[0], end - ch));
+    if (!ch) {
+      break;
+    }
+    if (!memcmp(ch, _contents.m_data, _contents.m_size)) {
+      return ch - m_data;
+    }
+  }
+
+  return k_npos;
+}
+
+Size StringView::find_last_of(int _ch) const {
+  for (Size i = m_size - 1; i < m_size; i--) {
+    if (m_data[i] == _ch) {
+      return i;
+    }
+  }
+  return k_npos;
+}
+
+Size StringView::find_last_of(const StringView& _contents) const {
+  if (_contents.m_size > m_size) {
+    return k_npos;
+  }
+
+  for (Size offset = m_size - _contents.m_size + 1; offset-- > 0; ) {
+    if (!memcmp(m_data + offset, _contents.m_data, _contents.m_size)) {
+      return offset;
+    }
+  }
+
+  return k_npos;
+}
+
+bool StringView::begins_with(const StringView& _prefix) const {
+  return _prefix.m_size <= m_size
+    && !memcmp(m_data, _prefix.m_data, _prefix.m_size);
+}
+
+bool StringView::ends_with(const StringView& _suffix) const {
+  return _suffix.m_size <= m_size
+    && !memcmp(m_data + m_size - _suffix.m_size, _suffix.m_data, _suffix.m_size);
+}
+
+bool StringView::contains(const StringView& _needle) const {
+  return find_first_of(_needle) != k_npos;
+}
+
+StringView StringView::lstrip(const char* _set) const {
+  Size offset = 0;
+  for (; offset < m_size && strchr(_set, m_data[offset]); offset++);
+  return {m_data + offset, m_size - offset};
+}
+
+StringView StringView::rstrip(const char* _set) const {
+  Size size = m_size;
+  for (; size && strchr(_set, m_data[size - 1]); size--);
+  return {m_data, size};
+}
+
+StringView StringView::strip(const char* _set) const {
+  return lstrip(_set).rstrip(_set);
+}
+
+StringView StringView::substring(Size _offset, Size _length) const {
+  RX_ASSERT(_offset <= m_size, "out of bounds");
+  if (_length == 0) {
+    return {m_data + _offset, m_size - _offset};
+  }
+  RX_ASSERT(_offset + _length <= m_size, "out of bounds");
+  return {m_data + _offset, _length};
+}
+
+Size StringView::hash() const {
+  return String::hash_of(m_data, m_size);
+}
+
+String StringView::to_string(Memory::Allocator& _allocator) const {
+  return {_allocator, m_data, m_size};
+}
+
+String StringView::to_string() const {
+  return to_string(Memory::SystemAllocator::instance());
+}
+
+Optional<StringView> StringView::Tokenizer::next() {
+  if (m_done) {
+    return nullopt;
+  }
+
+  // The last token when limited takes the rest of the view.
+  const bool last = m_count == 1;
+  if (m_count) {
+    m_count--;
+  }
+
+  const Size index = last ? k_npos : m_rest.find_first_of(m_token);
+  if (index == k_npos) {
+    m_done = true;
+    return m_rest;
+  }
+
+  const StringView token{m_rest.data(), index};
+  m_rest = {m_rest.data() + index + 1, m_rest.size() - index - 1};
+  return token;
+}
+
+bool operator==(const StringView& _lhs, const StringView& _rhs) {
+  return _lhs.size() == _rhs.size()
+    && !memcmp(_lhs.data(), _rhs.data(), _lhs.size());
+}
+
+const char* FormatNormalize<StringView>::operator()(const StringView& _value) {
+  const Size size = Algorithm::min(_value.size(), sizeof scratch - 1);
+  memcpy(scratch, _value.data(), size);
+  scratch[size] = '\0';
+  return scratch;
+}
+
+} // namespace rx
@@ -0,0 +1,170 @@
+#ifndef RX_CORE_STRING_VIEW_H
+#define RX_CORE_STRING_VIEW_H
+#include "rx/core/assert.h" // RX_ASSERT
+#include "rx/core/format.h" // FormatNormalize
+#include "rx/core/optional.h"
+
+#include "rx/core/memory/system_allocator.h" // memory::{system_allocator, allocator}
+
+namespace Rx {
+
+struct String;
+
+// # String View
+//
+// The idea behind a string view is to refer to a range of characters owned by
+// something else, such as a String, a literal or a JSON document, without
+// copying them. Substrings, stripping and splitting a view produce more views
+// into the same characters and never allocate.
+//
+// A view is not null-terminated. It must not outlive the characters it refers
+// to, use |to_string| to make an owning copy.
+//
+// 32-bit: 8 bytes
+// 64-bit: 16 bytes
+struct StringView {
+  static constexpr const Size k_npos{-1_z};
+
+  struct Tokenizer;
+
+  constexpr StringView();
+  constexpr StringView(const char* _data, Size _size);
+  StringView(const char* _contents);
+  StringView(const String& _contents);
+
+  Size find_first_of(int _ch) const;
+  Size find_first_of(const StringView& _contents) const;
+
+  Size find_last_of(int _ch) const;
+  Size find_last_of(const StringView& _contents) const;
+
+  bool begins_with(const StringView& _prefix) const;
+  bool ends_with(const StringView& _suffix) const;
+  bool contains(const StringView& _needle) const;
+
+  // returns view with leading characters in set removed
+  StringView lstrip(const char* _set) const;
+
+  // returns view with trailing characters in set removed
+  StringView rstrip(const char* _set) const;
+
+  // returns view with leading and trailing characters in set removed
+  StringView strip(const char* _set) const;
+
+  // view of |length| characters from |offset|, use |length| of zero for the rest
+  StringView substring(Size _offset, Size _length = 0) const;
+
+  // lazily split view by |token| up to |count| times, use |count| of zero for no limit
+  Tokenizer split(int _token, Size _count = 0) const;
+
+  constexpr const char* data() const;
+  constexpr Size size() const;
+  constexpr bool is_empty() const;
+
+  const char& operator[](Size _index) const;
+
+  const char& first() const;
+  const char& last() const;
+
+  // The same hash as a String with the same contents.
+  Size hash() const;
+
+  String to_string(Memory::Allocator& _allocator) const;
+  String to_string() const;
+
+private:
+  const char* m_data;
+  Size m_size;
+};
+
+// # Tokenizer
+//
+// Produces the tokens of a view separated by a token character one at a time,
+// without allocating. Empty tokens between adjacent separators are produced
+// too. When there is a limit the last token is the rest of the view.
+//
+//  auto tokens = view.split(' ');
+//  while (auto token = tokens.next()) {
+//    ...
+//  }
+struct StringView::Tokenizer {
+  constexpr Tokenizer(const StringView& _contents, int _token, Size _count);
+
+  Optional<StringView> next();
+
+private:
+  StringView m_rest;
+  int m_token;
+  Size m_count;
+  bool m_done;
+};
+
+bool operator==(const StringView& _lhs, const StringView& _rhs);
+bool operator!=(const StringView& _lhs, const StringView& _rhs);
+
+// Views are not null-terminated, they're formatted through a bounded copy.
+template<>
+struct FormatNormalize<StringView> {
+  char scratch[512];
+  const char* operator()(const StringView& _value);
+};
+
+inline constexpr StringView::StringView()
+  : m_data{""}
+  , m_size{0}
+{
+}
+
+inline constexpr StringView::StringView(const char* _data, Size _size)
+  : m_data{_data}
+  , m_size{_size}
+{
+}
+
+inline StringView::Tokenizer StringView::split(int _token, Size _count) const {
+  return {*this, _token, _count};
+}
+
+RX_HINT_FORCE_INLINE constexpr const char* StringView::data() const {
+  return m_data;
+}
+
+RX_HINT_FORCE_INLINE constexpr Size StringView::size() const {
+  return m_size;
+}
+
+RX_HINT_FORCE_INLINE constexpr bool StringView::is_empty() const {
+  return m_size == 0;
+}
+
+inline const char& StringView::operator[](Size _index) const {
+  RX_ASSERT(_index < m_size, "out of bounds (%zu >= %zu)", _index, m_size);
+  return m_data[_index];
+}
+
+inline const char& StringView::first() const {
+  RX_ASSERT(m_size, "empty view");
+  return m_data[0];
+}
+
+inline const char& StringView::last() const {
+  RX_ASSERT(m_size, "empty view");
+  return m_data[m_size - 1];
+}
+
+inline constexpr StringView::Tokenizer::Tokenizer(const StringView& _contents,
+  int _token, Size _count)
+  : m_rest{_contents}
+  , m_token{_token}
+  , m_count{_count}
+  , m_done{false}
+{
+}
+
+inline bool operator!=(const StringView& _lhs, const StringView& _rhs) {
+  return !(_lhs == _rhs);
+}
+
+} // namespace rx
+
+#endif // RX_CORE_STRING_VIEW_H
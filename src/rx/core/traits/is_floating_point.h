@@ -5,7 +5,7 @@
 #include "rx/core/traits/is_same.h"
 #include "rx/core/traits/remove_cv.h"
 
-namespace rx::traits {
+namespace Rx::traits {
 
 template<typename T>
 inline constexpr const bool is_floating_point{
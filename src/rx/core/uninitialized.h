@@ -2,6 +2,10 @@
 #define RX_CORE_UNINITIALIZED_H
 #include "rx/core/memory/uninitialized_storage.h"
 
+#include "rx/core/utility/construct.h"
+#include "rx/core/utility/destruct.h"
+#include "rx/core/utility/forward.h"
+
 namespace Rx {
 
 // # Uninitialized object
@@ -1,12 +1,16 @@
 #ifndef RX_CORE_UTILITY_BIT_H
 #define RX_CORE_UTILITY_BIT_H
 #include "rx/core/types.h"
+#include "rx/core/config.h" // RX_COMPILER_*
 
 namespace Rx {
 
 template<typename T>
 inline Size bit_search_lsb(T _bits);
 
+template<typename T>
+inline Size bit_search_msb(T _bits);
+
 template<typename T>
 inline Size bit_pop_count(T _bits);
 
@@ -22,6 +26,16 @@ inline Size bit_search_lsb(Uint64 _bits) {
   return _bits ? __builtin_ctzll(_bits) : 64;
 }
 
+template<>
+inline Size bit_search_msb(Uint32 _bits) {
+  return _bits ? 31 - __builtin_clz(_bits) : 32;
+}
+
+template<>
+inline Size bit_search_msb(Uint64 _bits) {
+  return _bits ? 63 - __builtin_clzll(_bits) : 64;
+}
+
 template<>
 inline Size bit_pop_count(Uint32 _bits) {
   return __builtin_popcountl(_bits);
@@ -86,6 +100,37 @@ inline Size bit_pop_count(Uint64 _bits) {
 }
 #endif
 
+#if !defined(RX_COMPILER_CLANG) && !defined(RX_COMPILER_GCC)
+// smear the most significant bit right, the population count is then one more
+// than the index of it
+template<>
+inline Size bit_search_msb(Uint32 _bits) {
+  if (!_bits) {
+    return 32;
+  }
+  _bits |= _bits >> 1;
+  _bits |= _bits >> 2;
+  _bits |= _bits >> 4;
+  _bits |= _bits >> 8;
+  _bits |= _bits >> 16;
+  return bit_pop_count(_bits) - 1;
+}
+
+template<>
+inline Size bit_search_msb(Uint64 _bits) {
+  if (!_bits) {
+    return 64;
+  }
+  _bits |= _bits >> 1;
+  _bits |= _bits >> 2;
+  _bits |= _bits >> 4;
+  _bits |= _bits >> 8;
+  _bits |= _bits >> 16;
+  _bits |= _bits >> 32;
+  return bit_pop_count(_bits) - 1;
+}
+#endif
+
 template<typename T>
 inline Size bit_next(T _bits, Size _bit) {
   return bit_search_lsb<T>(_bits & ~((T{1} << _bit) - 1));
@@ -7,6 +7,10 @@
 
 #include "rx/console/variable.h"
 
+#include "rx/core/memory/tagged_allocator.h"
+#include "rx/core/time/qpc.h"
+#include "rx/core/algorithm/min.h"
+
 namespace Rx::hud {
 
 RX_CONSOLE_SVAR(
@@ -23,8 +27,24 @@ RX_CONSOLE_IVAR(
   64,
   25);
 
+RX_CONSOLE_SVAR(
+  trace_file,
+  "hud.memory_stats.trace_file",
+  "memory trace file to summarize in memory stats hud",
+  "");
+
+RX_CONSOLE_IVAR(
+  trace_sites,
+  "hud.memory_stats.trace_sites",
+  "number of call sites to show from the memory trace",
+  0,
+  64,
+  8);
+
 MemoryStats::MemoryStats(Render::Immediate2D* _immediate)
   : m_immediate{_immediate}
+  , m_trace_summary{Memory::SystemAllocator::instance()}
+  , m_trace_ticks{0}
 {
 }
 
@@ -52,6 +72,56 @@ void MemoryStats::render() {
   line(String::format("used memory (actual):    %s", String::human_size_format(stats.used_actual_bytes)));
   line(String::format("peak memory (requested): %s", String::human_size_format(stats.peak_request_bytes)));
   line(String::format("peak memory (actual):    %s", String::human_size_format(stats.peak_actual_bytes)));
+
+  // Subsystem allocators as a tree, children indented under their parents.
+  Memory::TaggedAllocator::each([&](Memory::TaggedAllocator& _allocator, Size _depth) {
+    const auto stats = _allocator.stats();
+    String name{String::format("%*s%s", static_cast<int>(_depth * 2), "", _allocator.name())};
+    if (stats.budget) {
+      line(String::format("%s: %s / %s (peak %s)", name,
+        String::human_size_format(stats.used_bytes),
+        String::human_size_format(stats.budget),
+        String::human_size_format(stats.peak_bytes)));
+    } else {
+      line(String::format("%s: %s (peak %s)", name,
+        String::human_size_format(stats.used_bytes),
+        String::human_size_format(stats.peak_bytes)));
+    }
+  });
+
+  const String& file_name = *trace_file;
+  if (file_name.is_empty()) {
+    return;
+  }
+
+  // Summarizing reads the entire trace, don't do it every frame.
+  const Uint64 ticks = Time::qpc_ticks();
+  if (file_name != m_trace_file || ticks - m_trace_ticks >= Time::qpc_frequency()) {
+    if (Memory::TracingAllocator::is_active()) {
+      Memory::TracingAllocator::flush();
+    }
+    if (!Memory::TracingAllocator::summarize(file_name.data(), m_trace_summary)) {
+      line(String::format("trace: failed to read '%s'", file_name));
+      return;
+    }
+    m_trace_file = file_name;
+    m_trace_ticks = ticks;
+  }
+
+  line(String::format("trace: %s live over %.2fs (%zu dropped)",
+    String::human_size_format(m_trace_summary.live_bytes()),
+    m_trace_summary.duration(),
+    static_cast<Size>(m_trace_summary.dropped())));
+
+  const Size sites = Algorithm::min(m_trace_summary.size(), static_cast<Size>(*trace_sites));
+  for (Size i = 0; i < sites; i++) {
+    const auto& site = m_trace_summary.sites()[i];
+    line(String::format("%s: %s in %zu, %.1f/s",
+      site.name,
+      String::human_size_format(site.live_bytes),
+      static_cast<Size>(site.live_allocations),
+      site.rate));
+  }
 }
 
 } // namespace rx::hud
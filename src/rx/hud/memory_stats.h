@@ -1,5 +1,7 @@
 #ifndef RX_HUD_MEMORY_STATS_H
 #define RX_HUD_MEMORY_STATS_H
+#include "rx/core/memory/tracing_allocator.h"
+#include "rx/core/string.h"
 
 namespace Rx::Render {
   struct Immediate2D;
@@ -12,6 +14,12 @@ struct MemoryStats {
   void render();
 private:
   Render::Immediate2D* m_immediate;
+
+  // Summary of the trace file given by hud.memory_stats.trace_file, refreshed
+  // at most once a second.
+  Memory::TracingAllocator::Summary m_trace_summary;
+  String m_trace_file;
+  Uint64 m_trace_ticks;
 };
 
 } // namespace rx::hud
@@ -13,6 +13,7 @@
 #include "rx/render/backend/null.h"
 
 #include "rx/core/filesystem/file.h"
+#include "rx/core/memory/tagged_allocator.h"
 
 #include "rx/core/profiler.h"
 #include "rx/core/global.h"
@@ -27,6 +28,10 @@
 
 using namespace Rx;
 
+// Used for the rendering backend and frontend.
+static Global<Memory::TaggedAllocator> g_render_allocator{"allocators", "render",
+  Memory::SystemAllocator::instance(), "render"};
+
 RX_CONSOLE_V2IVAR(
   display_resolution,
   "display.resolution",
@@ -112,7 +117,7 @@ RX_CONSOLE_IVAR(
 RX_CONSOLE_IVAR(
   thread_pool_static_pool_size,
   "thread_pool.static_pool_size",
-  "size of static pool for jobs before another static pool is allocated",
+  "number of jobs the thread pool queue holds before adding a job waits",
   32,
   4096,
   1024);
@@ -157,12 +162,15 @@ int main(int _argc, char** _argv) {
   auto* system_group = Globals::find("system");
   auto* console_group = Globals::find("console");
   auto* cvars_group = Globals::find("cvars");
+  auto* allocators_group = Globals::find("allocators");
 
   // Explicitly initialize globals that need to be initialized in a specific
   // order for things to work.
   system_group->find("heap_allocator")->init();
   system_group->find("electric_fence_allocator")->init();
   system_group->find("allocator")->init();
+  allocators_group->init();
+  system_group->find("atoms")->init();
   system_group->find("logger")->init();
   system_group->find("profiler")->init();
 
@@ -179,9 +187,9 @@ int main(int _argc, char** _argv) {
     Console::Interface::save("config.cfg");
   }
 
-  const Size static_pool_size = *thread_pool_static_pool_size;
+  const Size queue_size = *thread_pool_static_pool_size;
   const Size threads = *thread_pool_threads ? *thread_pool_threads : SDL_GetCPUCount();
-  system_group->find("thread_pool")->init(threads, static_pool_size);
+  system_group->find("thread_pool")->init(threads, queue_size);
 
   // The following scope exists because anything inside here needs to go out
   // of scope before the engine can safely return from main. This is because main
@@ -251,6 +259,41 @@ int main(int _argc, char** _argv) {
         return true;
       });
 
+    Console::Interface::add_command("mem.stats", "",
+                                    [](const Vector<Console::Command::Argument>&) {
+        const auto stats = static_cast<Memory::SystemAllocator&>(Memory::SystemAllocator::instance()).stats();
+        Console::Interface::print("^wsystem: %s used, %s peak",
+          String::human_size_format(stats.used_request_bytes),
+          String::human_size_format(stats.peak_request_bytes));
+        Memory::TaggedAllocator::each([](Memory::TaggedAllocator& _allocator, Size _depth) {
+          const auto stats = _allocator.stats();
+          const String indent{String::format("%*s", static_cast<int>(_depth * 2 + 2), "")};
+          if (stats.budget) {
+            Console::Interface::print("^w%s%s: %s used, %s peak, %s budget", indent,
+              _allocator.name(),
+              String::human_size_format(stats.used_bytes),
+              String::human_size_format(stats.peak_bytes),
+              String::human_size_format(stats.budget));
+          } else {
+            Console::Interface::print("^w%s%s: %s used, %s peak", indent,
+              _allocator.name(),
+              String::human_size_format(stats.used_bytes),
+              String::human_size_format(stats.peak_bytes));
+          }
+        });
+        return true;
+      });
+
+    Console::Interface::add_command("mem.trace_start", "s",
+                                    [](const Vector<Console::Command::Argument>& _arguments) {
+        return Memory::TracingAllocator::start(_arguments[0].as_string.data());
+      });
+
+    Console::Interface::add_command("mem.trace_stop", "",
+                                    [](const Vector<Console::Command::Argument>&) {
+        return Memory::TracingAllocator::stop();
+      });
+
 #if 0
     // Replace SDL2s allocator with our system allocator so we can track it's
     // memory usage.
@@ -391,7 +434,7 @@ int main(int _argc, char** _argv) {
       {
         Ptr<Render::Backend::Context> backend;
 
-        auto& allocator = Memory::SystemAllocator::instance();
+        auto& allocator = *g_render_allocator;
         if (driver_name == "gl4") {
           backend = make_ptr<Render::Backend::GL4>(allocator, allocator, reinterpret_cast<void*>(window));
         } else if (driver_name == "gl3") {
@@ -577,6 +620,9 @@ int main(int _argc, char** _argv) {
 
   SDL_Quit();
 
+  // Finish any memory trace before the allocators go away.
+  Memory::TracingAllocator::stop();
+
   Globals::fini();
 
   console_group->fini();
@@ -585,6 +631,8 @@ int main(int _argc, char** _argv) {
   system_group->find("thread_pool")->fini();
   system_group->find("profiler")->fini();
   system_group->find("logger")->fini();
+  system_group->find("atoms")->fini();
+  allocators_group->fini();
   system_group->find("allocator")->fini();
   system_group->find("electric_fence_allocator")->fini();
   system_group->find("heap_allocator")->fini();
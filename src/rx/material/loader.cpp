@@ -1,4 +1,5 @@
 #include "rx/core/filesystem/file.h"
+#include "rx/core/memory/tracing_allocator.h"
 #include "rx/core/concurrency/thread_pool.h"
 #include "rx/core/concurrency/wait_group.h"
 #include "rx/core/json.h"
@@ -41,6 +42,7 @@ void Loader::operator=(Loader&& loader_) {
 }
 
 bool Loader::load(Stream* _stream) {
+  RX_MEMORY_TRACE_SCOPE();
   if (auto contents = read_text_stream(allocator(), _stream)) {
     return parse({contents->disown()});
   }
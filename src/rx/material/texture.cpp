@@ -1,4 +1,5 @@
 #include "rx/core/filesystem/file.h"
+#include "rx/core/memory/tracing_allocator.h"
 #include "rx/core/algorithm/clamp.h"
 #include "rx/core/math/log2.h"
 #include "rx/core/json.h"
@@ -19,6 +20,7 @@ namespace Rx::Material {
 RX_LOG("material/texture", logger);
 
 bool Texture::load(Stream* _stream) {
+  RX_MEMORY_TRACE_SCOPE();
   if (auto contents = read_text_stream(allocator(), _stream)) {
     return parse({contents->disown()});
   }
@@ -105,7 +107,7 @@ bool Texture::load_texture_file() {
     want_format = Rx::Texture::PixelFormat::k_rgb_u8;
   }
 
-  Rx::Texture::Loader loader{allocator()};
+  Rx::Texture::Loader loader;
   if (!loader.load(m_file, want_format)) {
     return false;
   }
@@ -241,14 +243,15 @@ bool Texture::parse_type(const JSON& _type) {
     "emissive"
   };
 
+  const auto type_string = _type.as_string_view();
   for (const auto& match : k_matches) {
-    if (match == _type.as_string()) {
+    if (match == type_string) {
       m_type = match;
       return true;
     }
   }
 
-  return error("unknown Type '%s'", _type.as_string());
+  return error("unknown Type '%s'", type_string);
 }
 
 bool Texture::parse_filter(const JSON& _filter, bool& _mipmaps) {
@@ -262,7 +265,7 @@ bool Texture::parse_filter(const JSON& _filter, bool& _mipmaps) {
     "nearest"
   };
 
-  const auto& filter_string = _filter.as_string();
+  const auto filter_string = _filter.as_string_view();
   for (const auto& match : k_matches) {
     if (filter_string == match) {
       const bool trilinear = *match == 't';
@@ -298,7 +301,7 @@ bool Texture::parse_wrap(const JSON& _wrap) {
     { "mirror_clamp_to_edge", WrapType::k_mirror_clamp_to_edge }
   };
 
-  const auto parse = [this](const String& _type) -> Optional<WrapType> {
+  const auto parse = [this](const StringView& _type) -> Optional<WrapType> {
     for (const auto& match : k_matches) {
       if (_type == match.match) {
         return match.type;
@@ -308,8 +311,8 @@ bool Texture::parse_wrap(const JSON& _wrap) {
     return nullopt;
   };
 
-  const auto& s_wrap = parse(_wrap[0_z].as_string());
-  const auto& t_wrap = parse(_wrap[1_z].as_string());
+  const auto& s_wrap = parse(_wrap[0_z].as_string_view());
+  const auto& t_wrap = parse(_wrap[1_z].as_string_view());
 
   if (s_wrap && t_wrap) {
     m_wrap.s = *s_wrap;
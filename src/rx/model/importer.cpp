@@ -3,8 +3,10 @@
 #include "rx/model/loader.h"
 
 #include "rx/core/filesystem/file.h"
+#include "rx/core/memory/tracing_allocator.h"
 #include "rx/core/algorithm/max.h"
 #include "rx/core/map.h"
+#include "rx/core/small_vector.h"
 #include "rx/core/log.h"
 
 #include "rx/core/math/abs.h"
@@ -34,6 +36,7 @@ Importer::Importer(Memory::Allocator& _allocator)
 }
 
 bool Importer::load(Stream* _stream) {
+  RX_MEMORY_TRACE_SCOPE();
   m_name = _stream->name();
 
   if (!read(_stream)) {
@@ -109,7 +112,9 @@ bool Importer::load(Stream* _stream) {
     Math::AABB bounds;
   };
 
-  Map<String, Vector<Batch>> batches{allocator()};
+  // Most materials have only a few batches, avoid allocating for those.
+  using Batches = SmallVector<Batch, 4>;
+  Map<String, Batches> batches{allocator()};
   m_meshes.each_fwd([&](const Mesh& _mesh) {
     Math::AABB bounds;
     for (Size i{0}; i < _mesh.count; i++) {
@@ -118,7 +123,7 @@ bool Importer::load(Stream* _stream) {
     if (auto* find{batches.find(_mesh.material)}) {
       find->push_back({_mesh.offset, _mesh.count, bounds});
     } else {
-      Vector<Batch> result{allocator()};
+      Batches result{allocator()};
       result.emplace_back(_mesh.offset, _mesh.count, bounds);
       batches.insert(_mesh.material, Utility::move(result));
     }
@@ -126,7 +131,7 @@ bool Importer::load(Stream* _stream) {
 
   Vector<Mesh> optimized_meshes{allocator()};
   Vector<Uint32> optimized_elements{allocator()};
-  batches.each_pair([&](const String& _material_name, const Vector<Batch>& _batches) {
+  batches.each_pair([&](const String& _material_name, const Batches& _batches) {
     Math::AABB bounds;
     const Size elements{optimized_elements.size()};
     _batches.each_fwd([&](const Batch& _batch) {
@@ -6,6 +6,9 @@
 #include "rx/core/json.h"
 #include "rx/core/filesystem/file.h"
 #include "rx/core/algorithm/clamp.h"
+#include "rx/core/memory/tagged_allocator.h"
+#include "rx/core/memory/tracing_allocator.h"
+#include "rx/core/memory/pool_allocator.h"
 
 #include "rx/core/concurrency/thread_pool.h"
 #include "rx/core/concurrency/wait_group.h"
@@ -18,6 +21,19 @@ namespace Rx::Model {
 
 RX_LOG("model/loader", logger);
 
+// Used by loaders that aren't given an allocator.
+static Global<Memory::TaggedAllocator> s_allocator{"allocators", "model",
+  Memory::SystemAllocator::instance(), "model"};
+
+// Importers only live for the duration of |Loader::import|, recycle them.
+static Global<Memory::PoolAllocator> s_importer_allocator{"allocators",
+  "model_importers", *s_allocator, sizeof(IQM), 8_z};
+
+Loader::Loader()
+  : Loader{*s_allocator}
+{
+}
+
 Loader::Loader(Memory::Allocator& _allocator)
   : m_allocator{_allocator}
   , as_nat{}
@@ -44,6 +60,7 @@ Loader::~Loader() {
 }
 
 bool Loader::load(Stream* _stream) {
+  RX_MEMORY_TRACE_SCOPE();
   if (auto contents = read_text_stream(allocator(), _stream)) {
     return parse({contents->disown()});
   }
@@ -112,17 +129,14 @@ bool Loader::parse(const JSON& _definition) {
 
   // Load all the materials across multiple threads.
   // concurrency::thread_pool pool{m_allocator, 32};
-  Concurrency::Mutex mutex;
   Concurrency::WaitGroup group{materials.size()};
   materials.each([&](const JSON& _material) {
     Concurrency::ThreadPool::instance().add([&, _material](int) {
       Material::Loader loader{allocator()};
       if (_material.is_string() && loader.load(_material.as_string())) {
-        Concurrency::ScopeLock lock{mutex};
-        m_materials.insert(loader.name(), Utility::move(loader));
+        m_materials.insert(Atom{loader.name()}, Utility::move(loader));
       } else if (_material.is_object() && loader.parse(_material)) {
-        Concurrency::ScopeLock lock{mutex};
-        m_materials.insert(loader.name(), Utility::move(loader));
+        m_materials.insert(Atom{loader.name()}, Utility::move(loader));
       }
       group.signal();
     });
@@ -138,8 +152,7 @@ bool Loader::import(const String& _file_name) {
 
   // determine the model format based on the extension
   if (_file_name.ends_with(".iqm")) {
-    auto& this_allocator = allocator();
-    if (!(new_loader = make_ptr<IQM>(this_allocator, this_allocator))) {
+    if (!(new_loader = make_ptr<IQM>(*s_importer_allocator, allocator()))) {
       return error("out of memory");
     }
   } else {
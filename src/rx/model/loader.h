@@ -4,12 +4,16 @@
 
 #include "rx/material/loader.h"
 
+#include "rx/core/atom.h"
+#include "rx/core/concurrent_map.h"
+
 namespace Rx::Model {
 
 struct Loader {
   RX_MARK_NO_COPY(Loader);
   RX_MARK_NO_MOVE(Loader);
 
+  Loader();
   Loader(Memory::Allocator& _allocator);
   ~Loader();
 
@@ -39,7 +43,7 @@ struct Loader {
   Vector<Vertex>&& vertices();
   Vector<Mesh>&& meshes();
   Vector<Uint32>&& elements();
-  Map<String, Material::Loader>&& materials();
+  ConcurrentMap<Atom, Material::Loader>&& materials();
 
   // Only valid for animated models.
   Vector<AnimatedVertex>&& animated_vertices();
@@ -82,7 +86,8 @@ private:
   Vector<Math::Vec3f> m_positions;
   Vector<Math::Mat3x4f> m_frames;
   Optional<Math::Transform> m_transform;
-  Map<String, Material::Loader> m_materials;
+  // Materials are loaded in parallel, see parse.
+  ConcurrentMap<Atom, Material::Loader> m_materials;
   String m_name;
   int m_flags;
 };
@@ -117,7 +122,7 @@ inline Vector<Uint32>&& Loader::elements() {
   return Utility::move(m_elements);
 }
 
-inline Map<String, Material::Loader>&& Loader::materials() {
+inline ConcurrentMap<Atom, Material::Loader>&& Loader::materials() {
   return Utility::move(m_materials);
 }
 
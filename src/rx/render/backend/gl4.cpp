@@ -6,6 +6,9 @@
 
 #include "rx/core/algorithm/max.h"
 #include "rx/core/math/log2.h"
+#include "rx/core/small_vector.h"
+#include "rx/core/static_vector.h"
+#include "rx/core/string_builder.h"
 
 #include "rx/core/profiler.h"
 #include "rx/core/log.h"
@@ -569,7 +572,7 @@ namespace detail_gl4 {
           if (_draw_buffers->is_empty()) {
             pglNamedFramebufferDrawBuffer(this_target->fbo, GL_NONE);
           } else {
-            Vector<GLenum> draw_buffers;
+            StaticVector<GLenum, Frontend::Buffers::k_max_buffers> draw_buffers;
             for (Size i{0}; i < _draw_buffers->size(); i++) {
               draw_buffers.push_back(GL_COLOR_ATTACHMENT0 + (*_draw_buffers)[i]);
             }
@@ -781,7 +784,8 @@ static GLuint compile_shader(const Vector<Frontend::Uniform>& _uniforms,
     "#define rx_point_size gl_PointSize\n"
     "#define rx_point_coord gl_PointCoord\n";
 
-  String contents{k_prelude};
+  StringBuilder contents;
+  contents.append(k_prelude);
 
   GLenum type = 0;
   switch (_shader.kind) {
@@ -789,22 +793,22 @@ static GLuint compile_shader(const Vector<Frontend::Uniform>& _uniforms,
     type = GL_VERTEX_SHADER;
     // emit vertex attributes inputs
     _shader.inputs.each_pair([&](const String& _name, const Frontend::Shader::InOut& _inout) {
-      contents.append(String::format("layout(location = %zu) in %s %s;\n", _inout.index, inout_to_string(_inout.kind), _name));
+      contents.format("layout(location = %zu) in %s %s;\n", _inout.index, inout_to_string(_inout.kind), _name);
     });
     // emit vertex outputs
     _shader.outputs.each_pair([&](const String& _name, const Frontend::Shader::InOut& _inout) {
-      contents.append(String::format("out %s %s;\n", inout_to_string(_inout.kind), _name));
+      contents.format("out %s %s;\n", inout_to_string(_inout.kind), _name);
     });
     break;
   case Frontend::Shader::Type::k_fragment:
     type = GL_FRAGMENT_SHADER;
     // emit fragment inputs
     _shader.inputs.each_pair([&](const String& _name, const Frontend::Shader::InOut& _inout) {
-      contents.append(String::format("in %s %s;\n", inout_to_string(_inout.kind), _name));
+      contents.format("in %s %s;\n", inout_to_string(_inout.kind), _name);
     });
     // emit fragment outputs
     _shader.outputs.each_pair([&](const String& _name, const Frontend::Shader::InOut& _inout) {
-      contents.append(String::format("layout(location = %d) out %s %s;\n", _inout.index, inout_to_string(_inout.kind), _name));
+      contents.format("layout(location = %d) out %s %s;\n", _inout.index, inout_to_string(_inout.kind), _name);
     });
     break;
   }
@@ -813,7 +817,7 @@ static GLuint compile_shader(const Vector<Frontend::Uniform>& _uniforms,
   _uniforms.each_fwd([&](const Frontend::Uniform& _uniform) {
     // Don't emit padding uniforms.
     if (!_uniform.is_padding()) {
-      contents.append(String::format("uniform %s %s;\n", uniform_to_string(_uniform.type()), _uniform.name()));
+      contents.format("uniform %s %s;\n", uniform_to_string(_uniform.type()), _uniform.name());
     }
   });
 
@@ -823,11 +827,16 @@ static GLuint compile_shader(const Vector<Frontend::Uniform>& _uniforms,
   // append the user shader source now
   contents.append(_shader.source);
 
-  const GLchar* data{static_cast<const GLchar*>(contents.data())};
-  const GLint size{static_cast<GLint>(contents.size())};
+  // The chunks of the source are given to GL directly as separate strings.
+  SmallVector<const GLchar*, 8> data;
+  SmallVector<GLint, 8> size;
+  contents.each_chunk([&](const StringView& _chunk) {
+    data.push_back(static_cast<const GLchar*>(_chunk.data()));
+    size.push_back(static_cast<GLint>(_chunk.size()));
+  });
 
   GLuint handle{pglCreateShader(type)};
-  pglShaderSource(handle, 1, &data, &size);
+  pglShaderSource(handle, static_cast<GLsizei>(data.size()), data.data(), size.data());
   pglCompileShader(handle);
 
   GLint status{0};
@@ -841,7 +850,7 @@ static GLuint compile_shader(const Vector<Frontend::Uniform>& _uniforms,
     if (log_size) {
       Vector<char> error_log{Memory::SystemAllocator::instance(), static_cast<Size>(log_size)};
       pglGetShaderInfoLog(handle, log_size, &log_size, error_log.data());
-      logger->error("\n%s\n%s", error_log.data(), contents);
+      logger->error("\n%s\n%s", error_log.data(), contents.flatten());
     }
 
     pglDeleteShader(handle);
@@ -1262,7 +1271,7 @@ void GL4::process(Byte* _command) {
 
           const auto shaders{render_program->shaders()};
 
-          Vector<GLuint> shader_handles;
+          SmallVector<GLuint, 2> shader_handles;
           shaders.each_fwd([&](const Frontend::Shader& _shader) {
             GLuint shader_handle{compile_shader(render_program->uniforms(), _shader)};
             if (shader_handle != 0) {
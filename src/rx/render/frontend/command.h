@@ -2,8 +2,8 @@
 #define RX_RENDER_FRONTEND_COMMAND_H
 
 #include "rx/core/source_location.h"
+#include "rx/core/static_vector.h"
 #include "rx/core/memory/bump_point_allocator.h"
-#include "rx/core/utility/nat.h"
 #include "rx/math/vec4.h"
 #include "rx/render/frontend/state.h"
 
@@ -95,11 +95,7 @@ struct Buffers {
   const int *data() const;
 
 private:
-  union {
-    Utility::Nat m_nat;
-    int m_elements[k_max_buffers];
-  };
-  Size m_index;
+  StaticVector<int, k_max_buffers> m_elements;
 };
 
 struct Textures {
@@ -119,11 +115,7 @@ struct Textures {
   Texture *operator[](Size _index) const;
 
 private:
-  union {
-    Utility::Nat m_nat;
-    void *m_handles[k_max_textures];
-  };
-  Size m_index;
+  StaticVector<void*, k_max_textures> m_handles;
 };
 
 struct DrawCommand {
@@ -250,7 +242,7 @@ inline Size CommandBuffer::size() const {
 
 // textures
 inline constexpr Textures::Textures()
-  : m_nat{}, m_index{0} {
+  : m_handles{} {
 }
 
 template<typename T>
@@ -262,47 +254,45 @@ inline int Textures::add(T *_texture) {
     traits::is_same<T, TextureCM>,
     "|_texture| isn't a texture pointer");
 
-  RX_ASSERT(m_index < k_max_textures, "too many draw textures");
-  m_handles[m_index] = static_cast<void *>(_texture);
-  return static_cast<int>(m_index++);
+  RX_ASSERT(m_handles.push_back(static_cast<void *>(_texture)),
+    "too many draw textures");
+  return static_cast<int>(m_handles.size() - 1);
 }
 
 inline bool Textures::is_empty() const {
-  return m_index == 0;
+  return m_handles.is_empty();
 }
 
 inline Size Textures::size() const {
-  return m_index;
+  return m_handles.size();
 }
 
 inline void Textures::clear() {
-  m_index = 0;
+  m_handles.clear();
 }
 
 inline Texture *Textures::operator[](Size _index) const {
-  RX_ASSERT(_index < k_max_textures, "out of bounds");
   return reinterpret_cast<Texture *>(m_handles[_index]);
 }
 
 // buffers
 inline constexpr Buffers::Buffers()
-  : m_nat{}, m_index{0} {
+  : m_elements{} {
 }
 
 inline void Buffers::add(int _buffer) {
-  RX_ASSERT(m_index < k_max_buffers, "too many draw buffers");
-  m_elements[m_index++] = _buffer;
+  RX_ASSERT(m_elements.push_back(_buffer), "too many draw buffers");
 }
 
 inline bool Buffers::operator==(const Buffers &_buffers) const {
   // Comparing buffers is approximate and not exact. When we share
   // a common initial sequence of elements we compare equal provided
   // the sequence length isn't larger than ours.
-  if (_buffers.m_index > m_index) {
+  if (_buffers.size() > size()) {
     return false;
   }
-  for (Size i = 0; i < m_index; i++) {
-    if (_buffers.m_elements[i] != m_elements[i]) {
+  for (Size i = 0; i < size(); i++) {
+    if (_buffers.data()[i] != m_elements[i]) {
       return false;
     }
   }
@@ -314,24 +304,23 @@ inline bool Buffers::operator!=(const Buffers &_buffers) const {
 }
 
 inline Size Buffers::size() const {
-  return m_index;
+  return m_elements.size();
 }
 
 inline bool Buffers::is_empty() const {
-  return m_index == 0;
+  return m_elements.is_empty();
 }
 
 inline int Buffers::operator[](Size _index) const {
-  RX_ASSERT(_index < k_max_buffers, "out of bounds");
   return m_elements[_index];
 }
 
 inline int Buffers::last() const {
-  return m_elements[m_index - 1];
+  return m_elements.last();
 }
 
 inline const int* Buffers::data() const {
-  return m_elements;
+  return m_elements.data();
 }
 
 // draw_command
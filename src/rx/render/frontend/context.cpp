@@ -12,6 +12,7 @@
 #include "rx/render/frontend/material.h"
 
 #include "rx/core/concurrency/scope_lock.h"
+#include "rx/core/memory/tracing_allocator.h"
 #include "rx/core/filesystem/directory.h"
 
 #include "rx/core/profiler.h"
@@ -47,6 +48,16 @@ namespace Rx::Render::Frontend {
 #define allocate_command(data_type, type) \
   m_command_buffer.allocate(sizeof(data_type), (type), _info)
 
+template<typename T>
+static Vector<T*> drain_cache(ConcurrentMap<String, T*>& cache_, Memory::Allocator& _allocator) {
+  Vector<T*> result{_allocator};
+  cache_.each_value([&](T* _value) {
+    result.push_back(_value);
+  });
+  cache_.clear();
+  return result;
+}
+
 Context::Context(Memory::Allocator& _allocator, Backend::Context* _backend)
   : m_allocator{_allocator}
   , m_backend{_backend}
@@ -69,6 +80,16 @@ Context::Context(Memory::Allocator& _allocator, Backend::Context* _backend)
   , m_commands{allocator()}
   , m_command_buffer{allocator(), static_cast<Size>(*command_memory) * 1024 * 1024}
   , m_deferred_process{[this]() { process(); }}
+  , m_draw_calls{allocator()}
+  , m_instanced_draw_calls{allocator()}
+  , m_clear_calls{allocator()}
+  , m_blit_calls{allocator()}
+  , m_vertices{allocator()}
+  , m_triangles{allocator()}
+  , m_lines{allocator()}
+  , m_points{allocator()}
+  , m_footprint{allocator()}
+  , m_commands_recorded{0}
   , m_device_info{allocator()}
 {
   RX_ASSERT(_backend, "expected valid backend");
@@ -136,33 +157,36 @@ Context::~Context() {
   destroy_target(RX_RENDER_TAG("swapchain"), m_swapchain_target);
   destroy_texture(RX_RENDER_TAG("swapchain"), m_swapchain_texture);
 
-  m_cached_buffers.each_value([this](Buffer* _buffer) {
+  // Destroying a resource removes it from it's cache, which cannot be done
+  // while iterating the cache. Take everything out of the caches first.
+  drain_cache(m_cached_buffers, allocator()).each_fwd([this](Buffer* _buffer) {
     destroy_buffer(RX_RENDER_TAG("cached buffer"), _buffer);
   });
 
-  m_cached_targets.each_value([this](Target* _target) {
+  drain_cache(m_cached_targets, allocator()).each_fwd([this](Target* _target) {
     destroy_target(RX_RENDER_TAG("cached target"), _target);
   });
 
-  m_cached_textures1D.each_value([this](Texture1D* _texture) {
+  drain_cache(m_cached_textures1D, allocator()).each_fwd([this](Texture1D* _texture) {
     destroy_texture(RX_RENDER_TAG("cached texture"), _texture);
   });
 
-  m_cached_textures2D.each_value([this](Texture2D* _texture) {
+  drain_cache(m_cached_textures2D, allocator()).each_fwd([this](Texture2D* _texture) {
     destroy_texture(RX_RENDER_TAG("cached texture"), _texture);
   });
 
-  m_cached_textures3D.each_value([this](Texture3D* _texture) {
+  drain_cache(m_cached_textures3D, allocator()).each_fwd([this](Texture3D* _texture) {
     destroy_texture(RX_RENDER_TAG("cached texture"), _texture);
   });
 
-  m_cached_texturesCM.each_value([this](TextureCM* _texture) {
+  drain_cache(m_cached_texturesCM, allocator()).each_fwd([this](TextureCM* _texture) {
     destroy_texture(RX_RENDER_TAG("cached texture"), _texture);
   });
 }
 
 // create_*
 Buffer* Context::create_buffer(const CommandHeader::Info& _info) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   Concurrency::ScopeLock lock{m_mutex};
   auto command_base{allocate_command(ResourceCommand, CommandType::k_resource_allocate)};
   auto command{reinterpret_cast<ResourceCommand*>(command_base + sizeof(CommandHeader))};
@@ -173,6 +197,7 @@ Buffer* Context::create_buffer(const CommandHeader::Info& _info) {
 }
 
 Target* Context::create_target(const CommandHeader::Info& _info) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   Concurrency::ScopeLock lock{m_mutex};
   auto command_base{allocate_command(ResourceCommand, CommandType::k_resource_allocate)};
   auto command{reinterpret_cast<ResourceCommand*>(command_base + sizeof(CommandHeader))};
@@ -183,6 +208,7 @@ Target* Context::create_target(const CommandHeader::Info& _info) {
 }
 
 Program* Context::create_program(const CommandHeader::Info& _info) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   Concurrency::ScopeLock lock{m_mutex};
   auto command_base{allocate_command(ResourceCommand, CommandType::k_resource_allocate)};
   auto command{reinterpret_cast<ResourceCommand*>(command_base + sizeof(CommandHeader))};
@@ -193,6 +219,7 @@ Program* Context::create_program(const CommandHeader::Info& _info) {
 }
 
 Texture1D* Context::create_texture1D(const CommandHeader::Info& _info) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   Concurrency::ScopeLock lock{m_mutex};
   auto command_base{allocate_command(ResourceCommand, CommandType::k_resource_allocate)};
   auto command{reinterpret_cast<ResourceCommand*>(command_base + sizeof(CommandHeader))};
@@ -203,6 +230,7 @@ Texture1D* Context::create_texture1D(const CommandHeader::Info& _info) {
 }
 
 Texture2D* Context::create_texture2D(const CommandHeader::Info& _info) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   Concurrency::ScopeLock lock{m_mutex};
   auto command_base{allocate_command(ResourceCommand, CommandType::k_resource_allocate)};
   auto command{reinterpret_cast<ResourceCommand*>(command_base + sizeof(CommandHeader))};
@@ -213,6 +241,7 @@ Texture2D* Context::create_texture2D(const CommandHeader::Info& _info) {
 }
 
 Texture3D* Context::create_texture3D(const CommandHeader::Info& _info) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   Concurrency::ScopeLock lock{m_mutex};
   auto command_base{allocate_command(ResourceCommand, CommandType::k_resource_allocate)};
   auto command{reinterpret_cast<ResourceCommand*>(command_base + sizeof(CommandHeader))};
@@ -223,6 +252,7 @@ Texture3D* Context::create_texture3D(const CommandHeader::Info& _info) {
 }
 
 TextureCM* Context::create_textureCM(const CommandHeader::Info& _info) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   Concurrency::ScopeLock lock{m_mutex};
   auto command_base{allocate_command(ResourceCommand, CommandType::k_resource_allocate)};
   auto command{reinterpret_cast<ResourceCommand*>(command_base + sizeof(CommandHeader))};
@@ -234,6 +264,7 @@ TextureCM* Context::create_textureCM(const CommandHeader::Info& _info) {
 
 // initialize_*
 void Context::initialize_buffer(const CommandHeader::Info& _info, Buffer* _buffer) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   RX_ASSERT(_buffer, "_buffer is null");
   _buffer->validate();
 
@@ -243,10 +274,11 @@ void Context::initialize_buffer(const CommandHeader::Info& _info, Buffer* _buffe
   command->type = ResourceCommand::Type::k_buffer;
   command->as_buffer = _buffer;
   m_commands.push_back(command_base);
-  m_footprint[0] += _buffer->resource_usage();
+  m_footprint += _buffer->resource_usage();
 }
 
 void Context::initialize_target(const CommandHeader::Info& _info, Target* _target) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   RX_ASSERT(_target, "_target is null");
   _target->validate();
 
@@ -256,10 +288,11 @@ void Context::initialize_target(const CommandHeader::Info& _info, Target* _targe
   command->type = ResourceCommand::Type::k_target;
   command->as_target = _target;
   m_commands.push_back(command_base);
-  m_footprint[0] += _target->resource_usage();
+  m_footprint += _target->resource_usage();
 }
 
 void Context::initialize_program(const CommandHeader::Info& _info, Program* _program) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   RX_ASSERT(_program, "_program is null");
   _program->validate();
 
@@ -269,10 +302,11 @@ void Context::initialize_program(const CommandHeader::Info& _info, Program* _pro
   command->type = ResourceCommand::Type::k_program;
   command->as_program = _program;
   m_commands.push_back(command_base);
-  m_footprint[0] += _program->resource_usage();
+  m_footprint += _program->resource_usage();
 }
 
 void Context::initialize_texture(const CommandHeader::Info& _info, Texture1D* _texture) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   RX_ASSERT(_texture, "_texture is null");
   _texture->validate();
 
@@ -282,10 +316,11 @@ void Context::initialize_texture(const CommandHeader::Info& _info, Texture1D* _t
   command->type = ResourceCommand::Type::k_texture1D;
   command->as_texture1D = _texture;
   m_commands.push_back(command_base);
-  m_footprint[0] += _texture->resource_usage();
+  m_footprint += _texture->resource_usage();
 }
 
 void Context::initialize_texture(const CommandHeader::Info& _info, Texture2D* _texture) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   RX_ASSERT(_texture, "_texture is null");
   _texture->validate();
 
@@ -295,10 +330,11 @@ void Context::initialize_texture(const CommandHeader::Info& _info, Texture2D* _t
   command->type = ResourceCommand::Type::k_texture2D;
   command->as_texture2D = _texture;
   m_commands.push_back(command_base);
-  m_footprint[0] += _texture->resource_usage();
+  m_footprint += _texture->resource_usage();
 }
 
 void Context::initialize_texture(const CommandHeader::Info& _info, Texture3D* _texture) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   RX_ASSERT(_texture, "_texture is null");
   _texture->validate();
 
@@ -308,10 +344,11 @@ void Context::initialize_texture(const CommandHeader::Info& _info, Texture3D* _t
   command->type = ResourceCommand::Type::k_texture3D;
   command->as_texture3D = _texture;
   m_commands.push_back(command_base);
-  m_footprint[0] += _texture->resource_usage();
+  m_footprint += _texture->resource_usage();
 }
 
 void Context::initialize_texture(const CommandHeader::Info& _info, TextureCM* _texture) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   RX_ASSERT(_texture, "_texture is null");
   _texture->validate();
 
@@ -321,11 +358,12 @@ void Context::initialize_texture(const CommandHeader::Info& _info, TextureCM* _t
   command->type = ResourceCommand::Type::k_textureCM;
   command->as_textureCM = _texture;
   m_commands.push_back(command_base);
-  m_footprint[0] += _texture->resource_usage();
+  m_footprint += _texture->resource_usage();
 }
 
 // update_*
 void Context::update_buffer(const CommandHeader::Info& _info, Buffer* _buffer) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   if (_buffer) {
     Concurrency::ScopeLock lock{m_mutex};
 
@@ -334,7 +372,7 @@ void Context::update_buffer(const CommandHeader::Info& _info, Buffer* _buffer) {
     _buffer->optimize_edits();
 
     // Keep track of frame footprint.
-    m_footprint[0] += _buffer->bytes_for_edits();
+    m_footprint += _buffer->bytes_for_edits();
 
     const auto& edits = _buffer->edits();
     if (edits.is_empty()) {
@@ -360,6 +398,7 @@ void Context::update_buffer(const CommandHeader::Info& _info, Buffer* _buffer) {
 }
 
 void Context::update_texture(const CommandHeader::Info& _info, Texture1D* _texture) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   if (_texture) {
     Concurrency::ScopeLock lock{m_mutex};
 
@@ -368,7 +407,7 @@ void Context::update_texture(const CommandHeader::Info& _info, Texture1D* _textu
     _texture->optimize_edits();
 
     // Keep track of frame footprint.
-    m_footprint[0] += _texture->bytes_for_edits();
+    m_footprint += _texture->bytes_for_edits();
 
     const auto& edits = _texture->edits();
     if (edits.is_empty()) {
@@ -394,6 +433,7 @@ void Context::update_texture(const CommandHeader::Info& _info, Texture1D* _textu
 }
 
 void Context::update_texture(const CommandHeader::Info& _info, Texture2D* _texture) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   if (_texture) {
     Concurrency::ScopeLock lock{m_mutex};
 
@@ -402,7 +442,7 @@ void Context::update_texture(const CommandHeader::Info& _info, Texture2D* _textu
     _texture->optimize_edits();
 
     // Keep track of frame footprint.
-    m_footprint[0] += _texture->bytes_for_edits();
+    m_footprint += _texture->bytes_for_edits();
 
     const auto& edits = _texture->edits();
     if (edits.is_empty()) {
@@ -428,6 +468,7 @@ void Context::update_texture(const CommandHeader::Info& _info, Texture2D* _textu
 }
 
 void Context::update_texture(const CommandHeader::Info& _info, Texture3D* _texture) {
+  const Memory::TracingAllocator::Scope trace{_info.source_info};
   if (_texture) {
     Concurrency::ScopeLock lock{m_mutex};
 
@@ -436,7 +477,7 @@ void Context::update_texture(const CommandHeader::Info& _info, Texture3D* _textu
     _texture->optimize_edits();
 
     // Keep track of frame footprint.
-    m_footprint[0] += _texture->bytes_for_edits();
+    m_footprint += _texture->bytes_for_edits();
 
     const auto& edits = _texture->edits();
     if (edits.is_empty()) {
@@ -600,20 +641,20 @@ void Context::draw(
     RX_ASSERT(_buffer->is_indexed(), "base vertex draw requires indexed buffer");
   }
 
-  m_vertices[0] += _count * instances;
+  m_vertices += _count * instances;
 
   switch (_primitive_type) {
   case PrimitiveType::k_lines:
-    m_lines[0] += (_count / 2) * instances;
+    m_lines += (_count / 2) * instances;
     break;
   case PrimitiveType::k_points:
-    m_points[0] += _count * _instances;
+    m_points += _count * _instances;
     break;
   case PrimitiveType::k_triangle_strip:
-    m_triangles[0] += (_count - 2) * instances;
+    m_triangles += (_count - 2) * instances;
     break;
   case PrimitiveType::k_triangles:
-    m_triangles[0] += (_count / 3) * instances;
+    m_triangles += (_count / 3) * instances;
     break;
   }
 
@@ -645,16 +686,16 @@ void Context::draw(
     // Copy the uniforms directly into the command.
     if (dirty_uniforms_size) {
       _program->flush_dirty_uniforms(command->uniforms());
-      m_footprint[0] += dirty_uniforms_size;
+      m_footprint += dirty_uniforms_size;
     }
 
     m_commands.push_back(command_base);
   }
 
-  m_draw_calls[0]++;
+  ++m_draw_calls;
 
   if (_instances) {
-    m_instanced_draw_calls[0]++;
+    ++m_instanced_draw_calls;
   }
 }
 
@@ -712,7 +753,7 @@ void Context::clear(const CommandHeader::Info& _info, const State& _state,
     m_commands.push_back(command_base);
   }
 
-  m_clear_calls[0]++;
+  ++m_clear_calls;
 }
 
 void Context::blit(
@@ -787,7 +828,7 @@ void Context::blit(
     m_commands.push_back(command_base);
   }
 
-  m_blit_calls[0]++;
+  ++m_blit_calls;
 }
 
 void Context::profile(const char* _tag) {
@@ -814,7 +855,7 @@ bool Context::process() {
     return false;
   }
 
-  m_commands_recorded[0] = m_commands.size();
+  m_commands_recorded = m_commands.size();
 
   Concurrency::ScopeLock lock{m_mutex};
 
@@ -856,18 +897,18 @@ bool Context::process() {
   m_destroy_texturesCM.clear();
 
   // Update all rendering stats for the last frame.
-  auto swap = [](Concurrency::Atomic<Size> (&value_)[2]) { value_[1] = value_[0].exchange(0); };
-
-  swap(m_draw_calls);
-  swap(m_instanced_draw_calls);
-  swap(m_clear_calls);
-  swap(m_blit_calls);
-  swap(m_vertices);
-  swap(m_points);
-  swap(m_lines);
-  swap(m_triangles);
-  swap(m_commands_recorded);
-  swap(m_footprint);
+  m_frame_statistics.store({
+    m_draw_calls.reset(),
+    m_instanced_draw_calls.reset(),
+    m_clear_calls.reset(),
+    m_blit_calls.reset(),
+    m_vertices.reset(),
+    m_triangles.reset(),
+    m_lines.reset(),
+    m_points.reset(),
+    m_commands_recorded.exchange(0),
+    m_footprint.reset()
+  });
 
   return true;
 }
@@ -906,98 +947,95 @@ bool Context::swap() {
   return m_timer.update();
 }
 
-Buffer* Context::cached_buffer(const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
-  if (auto find = m_cached_buffers.find(_key)) {
-    auto result = *find;
-    result->acquire_reference();
-    return result;
-  }
-  return nullptr;
+Buffer* Context::cached_buffer(const HashedString& _key) {
+  Buffer* result = nullptr;
+  m_cached_buffers.find(_key, [&](Buffer* _value) {
+    // The last reference may have been released concurrently, in which case
+    // the entry is about to be removed and the lookup is a miss.
+    if (_value->try_acquire_reference()) {
+      result = _value;
+    }
+  });
+  return result;
 }
 
-Target* Context::cached_target(const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
-  if (auto find{m_cached_targets.find(_key)}) {
-    auto result{*find};
-    result->acquire_reference();
-    return result;
-  }
-  return nullptr;
+Target* Context::cached_target(const HashedString& _key) {
+  Target* result = nullptr;
+  m_cached_targets.find(_key, [&](Target* _value) {
+    if (_value->try_acquire_reference()) {
+      result = _value;
+    }
+  });
+  return result;
 }
 
-Texture1D* Context::cached_texture1D(const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
-  if (auto find{m_cached_textures1D.find(_key)}) {
-    auto result{*find};
-    result->acquire_reference();
-    return result;
-  }
-  return nullptr;
+Texture1D* Context::cached_texture1D(const HashedString& _key) {
+  Texture1D* result = nullptr;
+  m_cached_textures1D.find(_key, [&](Texture1D* _value) {
+    if (_value->try_acquire_reference()) {
+      result = _value;
+    }
+  });
+  return result;
 }
 
-Texture2D* Context::cached_texture2D(const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
-  if (auto find{m_cached_textures2D.find(_key)}) {
-    auto result{*find};
-    result->acquire_reference();
-    return result;
-  }
-  return nullptr;
+Texture2D* Context::cached_texture2D(const HashedString& _key) {
+  Texture2D* result = nullptr;
+  m_cached_textures2D.find(_key, [&](Texture2D* _value) {
+    if (_value->try_acquire_reference()) {
+      result = _value;
+    }
+  });
+  return result;
 }
 
-Texture3D* Context::cached_texture3D(const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
-  if (auto find{m_cached_textures3D.find(_key)}) {
-    auto result{*find};
-    result->acquire_reference();
-    return result;
-  }
-  return nullptr;
+Texture3D* Context::cached_texture3D(const HashedString& _key) {
+  Texture3D* result = nullptr;
+  m_cached_textures3D.find(_key, [&](Texture3D* _value) {
+    if (_value->try_acquire_reference()) {
+      result = _value;
+    }
+  });
+  return result;
 }
 
-TextureCM* Context::cached_textureCM(const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
-  if (auto find{m_cached_texturesCM.find(_key)}) {
-    auto result{*find};
-    result->acquire_reference();
-    return result;
-  }
-  return nullptr;
+TextureCM* Context::cached_textureCM(const HashedString& _key) {
+  TextureCM* result = nullptr;
+  m_cached_texturesCM.find(_key, [&](TextureCM* _value) {
+    if (_value->try_acquire_reference()) {
+      result = _value;
+    }
+  });
+  return result;
 }
 
 void Context::cache_buffer(Buffer* _buffer, const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
   m_cached_buffers.insert(_key, _buffer);
 }
 
 void Context::cache_target(Target* _target, const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
   m_cached_targets.insert(_key, _target);
 }
 
 void Context::cache_texture(Texture1D* _texture, const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
   m_cached_textures1D.insert(_key, _texture);
 }
 
 void Context::cache_texture(Texture2D* _texture, const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
   m_cached_textures2D.insert(_key, _texture);
 }
 
 void Context::cache_texture(Texture3D* _texture, const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
   m_cached_textures3D.insert(_key, _texture);
 }
 
 void Context::cache_texture(TextureCM* _texture, const String& _key) {
-  Concurrency::ScopeLock lock{m_mutex};
   m_cached_texturesCM.insert(_key, _texture);
 }
 
 Technique* Context::find_technique_by_name(const char* _name) {
-  return m_techniques.find(_name);
+  Concurrency::ScopeReadLock lock{m_technique_lock};
+  return m_techniques.find(HashedString{_name});
 }
 
 } // namespace rx::render::frontend
@@ -3,11 +3,17 @@
 #include "rx/core/deferred_function.h"
 #include "rx/core/vector.h"
 #include "rx/core/string.h"
+#include "rx/core/hashed_string.h"
 #include "rx/core/static_pool.h"
-#include "rx/core/map.h"
+#include "rx/core/flat_map.h"
+#include "rx/core/concurrent_map.h"
 
 #include "rx/core/concurrency/mutex.h"
+#include "rx/core/concurrency/rw_lock.h"
+#include "rx/core/concurrency/seq_lock.h"
+#include "rx/core/concurrency/scope_lock.h"
 #include "rx/core/concurrency/atomic.h"
+#include "rx/core/concurrency/per_core_counter.h"
 
 #include "rx/render/frontend/command.h"
 #include "rx/render/frontend/resource.h"
@@ -166,12 +172,12 @@ struct Context {
   bool process();
   bool swap();
 
-  Buffer* cached_buffer(const String& _key);
-  Target* cached_target(const String& _key);
-  Texture1D* cached_texture1D(const String& _key);
-  Texture2D* cached_texture2D(const String& _key);
-  Texture3D* cached_texture3D(const String& _key);
-  TextureCM* cached_textureCM(const String& _key);
+  Buffer* cached_buffer(const HashedString& _key);
+  Target* cached_target(const HashedString& _key);
+  Texture1D* cached_texture1D(const HashedString& _key);
+  Texture2D* cached_texture2D(const HashedString& _key);
+  Texture3D* cached_texture3D(const HashedString& _key);
+  TextureCM* cached_textureCM(const HashedString& _key);
 
   // Pin a given resource to the render cache with the given |_key| allowing
   // it to be reused by checking the cache with the above functions.
@@ -231,10 +237,15 @@ private:
 
   // Remove a given object |_object| from the cache |_cache|.
   template<typename T>
-  void remove_from_cache(Map<String, T*>& cache_, T* _object);
+  void remove_from_cache(ConcurrentMap<String, T*>& cache_, T* _object);
 
   mutable Concurrency::Mutex m_mutex;
 
+  // The techniques and modules are looked up far more often than they change
+  // and have their own reader-writer lock. When both are needed |m_mutex| is
+  // taken first.
+  mutable Concurrency::RWLock m_technique_lock;
+
   Memory::Allocator& m_allocator               RX_HINT_GUARDED_BY(m_mutex);
   Backend::Context* m_backend                  RX_HINT_GUARDED_BY(m_mutex);
 
@@ -273,31 +284,52 @@ private:
   Vector<Byte*> m_commands                     RX_HINT_GUARDED_BY(m_mutex);
   CommandBuffer m_command_buffer               RX_HINT_GUARDED_BY(m_mutex);
 
-  Map<String, Buffer*> m_cached_buffers        RX_HINT_GUARDED_BY(m_mutex);
-  Map<String, Target*> m_cached_targets        RX_HINT_GUARDED_BY(m_mutex);
-  Map<String, Texture1D*> m_cached_textures1D  RX_HINT_GUARDED_BY(m_mutex);
-  Map<String, Texture2D*> m_cached_textures2D  RX_HINT_GUARDED_BY(m_mutex);
-  Map<String, Texture3D*> m_cached_textures3D  RX_HINT_GUARDED_BY(m_mutex);
-  Map<String, TextureCM*> m_cached_texturesCM  RX_HINT_GUARDED_BY(m_mutex);
+  // The caches are shared by every thread creating resources, each cache
+  // locks per shard of keys.
+  ConcurrentMap<String, Buffer*> m_cached_buffers;
+  ConcurrentMap<String, Target*> m_cached_targets;
+  ConcurrentMap<String, Texture1D*> m_cached_textures1D;
+  ConcurrentMap<String, Texture2D*> m_cached_textures2D;
+  ConcurrentMap<String, Texture3D*> m_cached_textures3D;
+  ConcurrentMap<String, TextureCM*> m_cached_texturesCM;
 
   // NOTE(dweiler): This has to come before techniques and modules. Everything
   // above must stay alive for the destruction of m_techniques and m_modules
   // to work.
   DeferredFunction<void()> m_deferred_process;
 
-  Map<String, Technique> m_techniques          RX_HINT_GUARDED_BY(m_mutex);
-  Map<String, Module> m_modules                RX_HINT_GUARDED_BY(m_mutex);
+  FlatMap<String, Technique> m_techniques          RX_HINT_GUARDED_BY(m_technique_lock);
+  FlatMap<String, Module> m_modules                RX_HINT_GUARDED_BY(m_technique_lock);
+
+  // Counters for the frame being recorded, bumped by every thread recording
+  // commands so each thread counts on cache lines of it's own.
+  Concurrency::PerCoreCounter m_draw_calls;
+  Concurrency::PerCoreCounter m_instanced_draw_calls;
+  Concurrency::PerCoreCounter m_clear_calls;
+  Concurrency::PerCoreCounter m_blit_calls;
+  Concurrency::PerCoreCounter m_vertices;
+  Concurrency::PerCoreCounter m_triangles;
+  Concurrency::PerCoreCounter m_lines;
+  Concurrency::PerCoreCounter m_points;
+  Concurrency::PerCoreCounter m_footprint;
+  Concurrency::Atomic<Size> m_commands_recorded;
+
+  // The counters of the last processed frame, published together at the end
+  // of |process| so readers always see the statistics of a single frame.
+  struct FrameStatistics {
+    Size draw_calls;
+    Size instanced_draw_calls;
+    Size clear_calls;
+    Size blit_calls;
+    Size vertices;
+    Size triangles;
+    Size lines;
+    Size points;
+    Size commands;
+    Size footprint;
+  };
 
-  Concurrency::Atomic<Size> m_draw_calls[2];
-  Concurrency::Atomic<Size> m_instanced_draw_calls[2];
-  Concurrency::Atomic<Size> m_clear_calls[2];
-  Concurrency::Atomic<Size> m_blit_calls[2];
-  Concurrency::Atomic<Size> m_vertices[2];
-  Concurrency::Atomic<Size> m_triangles[2];
-  Concurrency::Atomic<Size> m_lines[2];
-  Concurrency::Atomic<Size> m_points[2];
-  Concurrency::Atomic<Size> m_commands_recorded[2];
-  Concurrency::Atomic<Size> m_footprint[2];
+  Concurrency::SeqLock<FrameStatistics> m_frame_statistics;
 
   Uint64 m_frame;
 
@@ -315,13 +347,9 @@ inline constexpr Context::DeviceInfo::DeviceInfo(Memory::Allocator& _allocator)
 }
 
 template<typename T>
-inline void Context::remove_from_cache(Map<String, T*>& cache_, T* _object) {
-  cache_.each_pair([&](const String& _key, T* _value) {
-    if (_value != _object) {
-      return true;
-    }
-    cache_.erase(_key);
-    return false;
+inline void Context::remove_from_cache(ConcurrentMap<String, T*>& cache_, T* _object) {
+  cache_.erase_if([&](const String&, T* _value) {
+    return _value == _object;
   });
 }
 
@@ -330,43 +358,43 @@ RX_HINT_FORCE_INLINE constexpr Memory::Allocator& Context::allocator() const {
 }
 
 inline Size Context::draw_calls() const {
-  return m_draw_calls[1].load();
+  return m_frame_statistics.load().draw_calls;
 }
 
 inline Size Context::instanced_draw_calls() const {
-  return m_instanced_draw_calls[1].load();
+  return m_frame_statistics.load().instanced_draw_calls;
 }
 
 inline Size Context::clear_calls() const {
-  return m_clear_calls[1].load();
+  return m_frame_statistics.load().clear_calls;
 }
 
 inline Size Context::blit_calls() const {
-  return m_blit_calls[1].load();
+  return m_frame_statistics.load().blit_calls;
 }
 
 inline Size Context::vertices() const {
-  return m_vertices[1].load();
+  return m_frame_statistics.load().vertices;
 }
 
 inline Size Context::triangles() const {
-  return m_triangles[1].load();
+  return m_frame_statistics.load().triangles;
 }
 
 inline Size Context::lines() const {
-  return m_lines[1].load();
+  return m_frame_statistics.load().lines;
 }
 
 inline Size Context::points() const {
-  return m_points[1].load();
+  return m_frame_statistics.load().points;
 }
 
 inline Size Context::commands() const {
-  return m_commands_recorded[1].load();
+  return m_frame_statistics.load().commands;
 }
 
 inline Size Context::footprint() const {
-  return m_footprint[1].load();
+  return m_frame_statistics.load().footprint;
 }
 
 inline Uint64 Context::frame() const {
@@ -1,4 +1,5 @@
 #include "rx/core/filesystem/file.h"
+#include "rx/core/memory/tracing_allocator.h"
 #include "rx/core/json.h"
 
 #include "rx/render/frontend/module.h"
@@ -33,6 +34,7 @@ Module& Module::operator=(Module&& module_) {
 }
 
 bool Module::load(Stream* _stream) {
+  RX_MEMORY_TRACE_SCOPE();
   if (auto data = read_text_stream(allocator(), _stream)) {
     return parse({data->disown()});
   }
@@ -94,7 +96,7 @@ bool Module::parse(const JSON& _description) {
 }
 
 bool resolve_module_dependencies(
-  const Map<String, Module>& _modules,
+  const FlatMap<String, Module>& _modules,
   const Module& _current_module,
   Set<String>& visited_,
   Algorithm::TopologicalSort<String>& sorter_)
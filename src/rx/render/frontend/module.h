@@ -3,6 +3,7 @@
 #include "rx/core/string.h"
 #include "rx/core/vector.h"
 #include "rx/core/log.h"
+#include "rx/core/flat_map.h"
 
 #include "rx/core/algorithm/topological_sort.h"
 
@@ -78,7 +79,7 @@ inline void Module::log(Log::Level _level, const char* _format,
 }
 
 bool resolve_module_dependencies(
-  const Map<String, Module>& _modules,
+  const FlatMap<String, Module>& _modules,
   const Module& _current_module,
   Set<String>& visited_,
   Algorithm::TopologicalSort<String>& sorter_);
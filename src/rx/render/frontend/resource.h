@@ -28,7 +28,10 @@ struct Resource {
   void update_resource_usage(Size _bytes);
 
   bool release_reference();
-  void acquire_reference();
+
+  // Acquires a reference unless the count already dropped to zero, in which
+  // case the resource is being destroyed and must not be handed out again.
+  bool try_acquire_reference();
 
   Type resource_type() const;
   Size resource_usage() const;
@@ -50,8 +53,16 @@ inline bool Resource::release_reference() {
   return --m_reference_count == 0;
 }
 
-inline void Resource::acquire_reference() {
-  m_reference_count++;
+inline bool Resource::try_acquire_reference() {
+  Size count = m_reference_count.load(Concurrency::MemoryOrder::k_relaxed);
+  while (count) {
+    if (m_reference_count.compare_exchange_weak(count, count + 1,
+      Concurrency::MemoryOrder::k_acquire, Concurrency::MemoryOrder::k_relaxed))
+    {
+      return true;
+    }
+  }
+  return false;
 }
 
 inline Resource::Type Resource::resource_type() const {
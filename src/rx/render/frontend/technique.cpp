@@ -6,7 +6,10 @@
 
 #include "rx/core/json.h"
 #include "rx/core/optional.h"
+#include "rx/core/hashed_string.h"
+#include "rx/core/string_builder.h"
 #include "rx/core/filesystem/file.h"
+#include "rx/core/memory/tracing_allocator.h"
 #include "rx/core/algorithm/topological_sort.h"
 
 RX_LOG("render/technique", logger);
@@ -58,8 +61,8 @@ static void binexp_skip_spaces(const char*& expression_) {
   for (; *expression_ == ' '; expression_++);
 }
 
-static int binexp_parse_binary(const char*& expression_, int& parenthesis_, const Map<String, bool>& _values);
-static int binexp_parse_atom(const char*& expression_, int& parenthesis_, const Map<String, bool>& _values) {
+static int binexp_parse_binary(const char*& expression_, int& parenthesis_, const FlatMap<String, bool>& _values);
+static int binexp_parse_atom(const char*& expression_, int& parenthesis_, const FlatMap<String, bool>& _values) {
   binexp_skip_spaces(expression_);
 
   bool negated{false};
@@ -83,14 +86,12 @@ static int binexp_parse_atom(const char*& expression_, int& parenthesis_, const
     return negated ? !result : result;
   }
 
-  String identifier;
-  const char* end{strpbrk(expression_, " )")}; // ' ' or ')' marks end of an identifier
-  if (end) {
-    identifier = {expression_, end};
-  } else {
-    // otherwise the identifier is at the end of the string
-    identifier = expression_;
-  }
+  // ' ' or ')' marks end of an identifier, otherwise the identifier is at the
+  // end of the string
+  const char* end{strpbrk(expression_, " )")};
+  const HashedString identifier{end
+    ? HashedString{expression_, static_cast<Size>(end - expression_)}
+    : HashedString{expression_}};
 
   const auto find{_values.find(identifier)};
   if (!find) {
@@ -102,7 +103,7 @@ static int binexp_parse_atom(const char*& expression_, int& parenthesis_, const
   return negated ? !*find : *find;
 }
 
-static int binexp_parse_binary(const char*& expression_, int& parenthesis_, const Map<String, bool>& _values) {
+static int binexp_parse_binary(const char*& expression_, int& parenthesis_, const FlatMap<String, bool>& _values) {
   auto result{binexp_parse_atom(expression_, parenthesis_, _values)};
   if (result < 0) {
     return result;
@@ -132,7 +133,7 @@ static int binexp_parse_binary(const char*& expression_, int& parenthesis_, cons
   return k_unexpected_end_of_expression;
 }
 
-static int binexp_evaluate(const char* _expression, const Map<String, bool>& _values) {
+static int binexp_evaluate(const char* _expression, const FlatMap<String, bool>& _values) {
   if (!*_expression) {
     return 1;
   }
@@ -151,7 +152,7 @@ static int binexp_evaluate(const char* _expression, const Map<String, bool>& _va
   return result;
 }
 
-static Optional<Uniform::Type> uniform_type_from_string(const String& _type) {
+static Optional<Uniform::Type> uniform_type_from_string(const StringView& _type) {
   static constexpr const struct {
     const char* match;
     Uniform::Type kind;
@@ -183,7 +184,7 @@ static Optional<Uniform::Type> uniform_type_from_string(const String& _type) {
   return nullopt;
 }
 
-static Optional<Shader::InOutType> inout_type_from_string(const String& _type) {
+static Optional<Shader::InOutType> inout_type_from_string(const StringView& _type) {
   static constexpr const struct {
     const char* match;
     Shader::InOutType kind;
@@ -253,7 +254,7 @@ Technique& Technique::operator=(Technique&& technique_) {
 }
 
 bool Technique::evaluate_when_for_permute(const String& _when, Uint64 _flags) const {
-  Map<String, bool> values{m_frontend->allocator()};
+  FlatMap<String, bool> values{m_frontend->allocator()};
   for (Size i{0}; i < m_specializations.size(); i++) {
     values.insert(m_specializations[i], _flags & (1_u64 << i));
   }
@@ -266,7 +267,7 @@ bool Technique::evaluate_when_for_permute(const String& _when, Uint64 _flags) co
 }
 
 bool Technique::evaluate_when_for_variant(const String& _when, Size _index) const {
-  Map<String, bool> values{m_frontend->allocator()};
+  FlatMap<String, bool> values{m_frontend->allocator()};
   for (Size i{0}; i < m_specializations.size(); i++) {
     values.insert(m_specializations[i], i == _index);
   }
@@ -282,7 +283,7 @@ bool Technique::evaluate_when_for_basic(const String& _when) const {
   return _when.is_empty();
 }
 
-bool Technique::compile(const Map<String, Module>& _modules) {
+bool Technique::compile(const FlatMap<String, Module>& _modules) {
   // Resolve each shaders dependencies.
   if (!resolve_dependencies(_modules)) {
     return false;
@@ -308,31 +309,31 @@ bool Technique::compile(const Map<String, Module>& _modules) {
     // ensure all fragment inputs wire correctly into vertex outputs
     const bool check_inouts{
       // enumerate all vertex outputs and check for matching fragment inputs
-      vertex->outputs.each_pair([&](const String& _name, const ShaderDefinition::InOut& _inout_definition) {
+      vertex->outputs.each_pair([&](Atom _name, const ShaderDefinition::InOut& _inout_definition) {
         const auto check{fragment->inputs.find(_name)};
         if (!check) {
-          return error("could not find fragment input for vertex output '%s'", _name);
+          return error("could not find fragment input for vertex output '%s'", _name.data());
         }
         if (check->kind != _inout_definition.kind) {
-          return error("Type mismatch for fragment input '%s'", _name);
+          return error("Type mismatch for fragment input '%s'", _name.data());
         }
         if (check->when != _inout_definition.when) {
-          return error("when mismatch for fragment input '%s'", _name);
+          return error("when mismatch for fragment input '%s'", _name.data());
         }
         return true;
       })
       &&
       // enumerate all fragment inputs and check for matching vertex outputs
-      fragment->inputs.each_pair([&](const String& _name, const ShaderDefinition::InOut& _inout_definition) {
+      fragment->inputs.each_pair([&](Atom _name, const ShaderDefinition::InOut& _inout_definition) {
         const auto check{vertex->outputs.find(_name)};
         if (!check) {
-          return error("could not find vertex output for fragment input '%s'", _name);
+          return error("could not find vertex output for fragment input '%s'", _name.data());
         }
         if (check->kind != _inout_definition.kind) {
-          return error("Type mismatch for vertex output '%s'", _name);
+          return error("Type mismatch for vertex output '%s'", _name.data());
         }
         if (check->when != _inout_definition.when) {
-          return error("when mismatch for vertex output '%s'", _name);
+          return error("when mismatch for vertex output '%s'", _name.data());
         }
         return true;
       })
@@ -359,16 +360,16 @@ bool Technique::compile(const Map<String, Module>& _modules) {
         specialized_shader.source = _shader_definition.source;
 
         // emit inputs
-        _shader_definition.inputs.each_pair([&](const String& _name, const ShaderDefinition::InOut& _inout) {
+        _shader_definition.inputs.each_pair([&](Atom _name, const ShaderDefinition::InOut& _inout) {
           if (evaluate_when_for_basic(_inout.when)) {
-            specialized_shader.inputs.insert(_name, {_inout.index, _inout.kind});
+            specialized_shader.inputs.insert({_name.data(), _name.size()}, {_inout.index, _inout.kind});
           }
         });
 
         // emit outputs
-        _shader_definition.outputs.each_pair([&](const String& _name, const ShaderDefinition::InOut& _inout){
+        _shader_definition.outputs.each_pair([&](Atom _name, const ShaderDefinition::InOut& _inout){
           if (evaluate_when_for_basic(_inout.when)) {
-            specialized_shader.outputs.insert(_name, {_inout.index, _inout.kind});
+            specialized_shader.outputs.insert({_name.data(), _name.size()}, {_inout.index, _inout.kind});
           }
         });
 
@@ -399,29 +400,32 @@ bool Technique::compile(const Map<String, Module>& _modules) {
           Shader specialized_shader;
           specialized_shader.kind = _shader_definition.kind;
 
+          StringBuilder source;
+
           // emit #defines
           const Size specializations{m_specializations.size()};
           for (Size i{0}; i < specializations; i++) {
             const String& specialication{m_specializations[i]};
             if (_flags & (1_u64 << i)) {
-              specialized_shader.source.append(String::format("#define %s\n", specialication));
+              source.format("#define %s\n", specialication);
             }
           }
 
           // append shader source
-          specialized_shader.source.append(_shader_definition.source);
+          source.append(_shader_definition.source);
+          specialized_shader.source = source.flatten();
 
           // emit inputs
-          _shader_definition.inputs.each_pair([&](const String& _name, const ShaderDefinition::InOut& _inout) {
+          _shader_definition.inputs.each_pair([&](Atom _name, const ShaderDefinition::InOut& _inout) {
             if (evaluate_when_for_permute(_inout.when, _flags)) {
-              specialized_shader.inputs.insert(_name, {_inout.index, _inout.kind});
+              specialized_shader.inputs.insert({_name.data(), _name.size()}, {_inout.index, _inout.kind});
             }
           });
 
           // emit outputs
-          _shader_definition.outputs.each_pair([&](const String& _name, const ShaderDefinition::InOut& _inout) {
+          _shader_definition.outputs.each_pair([&](Atom _name, const ShaderDefinition::InOut& _inout) {
             if (evaluate_when_for_permute(_inout.when, _flags)) {
-              specialized_shader.outputs.insert(_name, {_inout.index, _inout.kind});
+              specialized_shader.outputs.insert({_name.data(), _name.size()}, {_inout.index, _inout.kind});
             }
           });
 
@@ -459,23 +463,26 @@ bool Technique::compile(const Map<String, Module>& _modules) {
           Shader specialized_shader;
           specialized_shader.kind = _shader_definition.kind;
 
+          StringBuilder source;
+
           // emit #defines
-          specialized_shader.source.append(String::format("#define %s\n", specialization));
+          source.format("#define %s\n", specialization);
 
           // append shader source
-          specialized_shader.source.append(_shader_definition.source);
+          source.append(_shader_definition.source);
+          specialized_shader.source = source.flatten();
 
           // emit inputs
-          _shader_definition.inputs.each_pair([&](const String& _name, const ShaderDefinition::InOut& _inout) {
+          _shader_definition.inputs.each_pair([&](Atom _name, const ShaderDefinition::InOut& _inout) {
             if (evaluate_when_for_variant(_inout.when, i)) {
-              specialized_shader.inputs.insert(_name, {_inout.index, _inout.kind});
+              specialized_shader.inputs.insert({_name.data(), _name.size()}, {_inout.index, _inout.kind});
             }
           });
 
           // emit outputs
-          _shader_definition.outputs.each_pair([&](const String& _name, const ShaderDefinition::InOut& _inout){
+          _shader_definition.outputs.each_pair([&](Atom _name, const ShaderDefinition::InOut& _inout){
             if (evaluate_when_for_variant(_inout.when, i)) {
-              specialized_shader.outputs.insert(_name, {_inout.index, _inout.kind});
+              specialized_shader.outputs.insert({_name.data(), _name.size()}, {_inout.index, _inout.kind});
             }
           });
 
@@ -527,6 +534,7 @@ Program* Technique::variant(Size _index) const {
 }
 
 bool Technique::load(Stream* _stream) {
+  RX_MEMORY_TRACE_SCOPE();
   auto& allocator = m_frontend->allocator();
   if (auto data = read_text_stream(allocator, _stream)) {
     return parse({data->disown()});
@@ -667,7 +675,7 @@ bool Technique::parse_uniform(const JSON& _uniform) {
   }
 
   const auto name_string{name.as_string()};
-  const auto type_string{type.as_string()};
+  const auto type_string{type.as_string_view()};
 
   // ensure we don't have multiple definitions of the same uniform
   if (m_uniform_definitions.find_if([name_string](const UniformDefinition& _uniform_definition)
@@ -884,7 +892,7 @@ bool Technique::parse_shader(const JSON& _shader) {
     return error("expected Array[String] for 'imports'");
   }
 
-  const auto type_string{type.as_string()};
+  const auto type_string{type.as_string_view()};
   Shader::Type shader_type;
   if (type_string == "vertex") {
     shader_type = Shader::Type::k_vertex;
@@ -935,7 +943,7 @@ bool Technique::parse_shader(const JSON& _shader) {
 }
 
 bool Technique::parse_inouts(const JSON& _inouts, const char* _type,
-                             Map<String, ShaderDefinition::InOut>& inouts_)
+                             FlatMap<Atom, ShaderDefinition::InOut>& inouts_)
 {
   if (!_inouts.is_array_of(JSON::Type::k_object)) {
     return error("expected Array[Object] in %ss", _type);
@@ -948,7 +956,7 @@ bool Technique::parse_inouts(const JSON& _inouts, const char* _type,
 }
 
 bool Technique::parse_inout(const JSON& _inout, const char* _type,
-                            Map<String, ShaderDefinition::InOut>& inouts_,
+                            FlatMap<Atom, ShaderDefinition::InOut>& inouts_,
                             Size& index_)
 {
   const auto& name{_inout["name"]};
@@ -975,12 +983,13 @@ bool Technique::parse_inout(const JSON& _inout, const char* _type,
     return error("expected String for 'when'");
   }
 
-  const auto name_string{name.as_string()};
-  if (inouts_.find(name_string)) {
+  const auto name_string{name.as_string_view()};
+  const Atom name_atom{name_string};
+  if (inouts_.find(name_atom)) {
     return error("duplicate '%s'", name_string);
   }
 
-  const auto type_string{type.as_string()};
+  const auto type_string{type.as_string_view()};
   const auto kind{inout_type_from_string(type_string)};
   if (!kind) {
     return error("unknown type '%s' for '%s'", type_string, name_string);
@@ -1004,7 +1013,7 @@ bool Technique::parse_inout(const JSON& _inout, const char* _type,
   }
 
 
-  inouts_.insert(name_string, inout);
+  inouts_.insert(name_atom, inout);
   return true;
 }
 
@@ -1031,7 +1040,7 @@ bool Technique::parse_specialization(const JSON& _specialization,
   return true;
 }
 
-bool Technique::resolve_dependencies(const Map<String, Module>& _modules) {
+bool Technique::resolve_dependencies(const FlatMap<String, Module>& _modules) {
   // For every shader in technique.
   return m_shader_definitions.each_fwd([&](ShaderDefinition& _shader) {
     Algorithm::TopologicalSort<String> sorter;
@@ -1059,7 +1068,7 @@ bool Technique::resolve_dependencies(const Map<String, Module>& _modules) {
     }
 
     // Fill out the source with all the modules in sorted order.
-    String source;
+    StringBuilder source;
     if (dependencies.sorted.size()) {
       const char* shader_type{""};
       switch (_shader.kind) {
@@ -1081,7 +1090,7 @@ bool Technique::resolve_dependencies(const Map<String, Module>& _modules) {
         logger->verbose("'%s': %s shader requires module '%s'",
           m_name, shader_type, _module);
 
-        source.append(String::format("// Module %s\n", _module));
+        source.format("// Module %s\n", _module);
         source.append("// {\n");
         source.append(find->source());
         source.append("// }\n");
@@ -1089,7 +1098,7 @@ bool Technique::resolve_dependencies(const Map<String, Module>& _modules) {
       source.append(_shader.source);
 
       // Replace the shader source with the new injected modules
-      _shader.source = Utility::move(source);
+      _shader.source = source.flatten();
     }
 
     return true;
@@ -1,6 +1,8 @@
 #ifndef RX_RENDER_FRONTEND_TECHNIQUE_H
 #define RX_RENDER_FRONTEND_TECHNIQUE_H
 #include "rx/core/log.h"
+#include "rx/core/flat_map.h"
+#include "rx/core/atom.h"
 
 #include "rx/render/frontend/program.h"
 
@@ -45,7 +47,7 @@ struct Technique {
   bool load(const String& _file_name);
 
   bool parse(const JSON& _description);
-  bool compile(const Map<String, Module>& _modules);
+  bool compile(const FlatMap<String, Module>& _modules);
 
   const String& name() const;
 
@@ -90,8 +92,8 @@ private:
     Shader::Type kind;
     String source;
     Vector<String> dependencies;
-    Map<String, InOut> inputs;
-    Map<String, InOut> outputs;
+    FlatMap<Atom, InOut> inputs;
+    FlatMap<Atom, InOut> outputs;
     String when;
   };
 
@@ -106,16 +108,16 @@ private:
   bool parse_shader(const JSON& _shader);
 
   bool parse_inouts(const JSON& _inouts, const char* _type,
-                    Map<String, ShaderDefinition::InOut>& inouts_);
+                    FlatMap<Atom, ShaderDefinition::InOut>& inouts_);
 
   bool parse_inout(const JSON& _inout, const char* _type,
-                   Map<String, ShaderDefinition::InOut>& inouts_,
+                   FlatMap<Atom, ShaderDefinition::InOut>& inouts_,
                    Size& index_);
 
   bool parse_specializations(const JSON& _specializations, const char* _type);
   bool parse_specialization(const JSON& _specialization, const char* _type);
 
-  bool resolve_dependencies(const Map<String, Module>& _modules);
+  bool resolve_dependencies(const FlatMap<String, Module>& _modules);
 
   template<typename... Ts>
   bool error(const char* _format, Ts&&... _arguments) const;
@@ -22,7 +22,6 @@ Model::Model(Frontend::Context* _frontend)
   , m_materials{m_frontend->allocator()}
   , m_opaque_meshes{m_frontend->allocator()}
   , m_transparent_meshes{m_frontend->allocator()}
-  , m_model{m_frontend->allocator()}
 {
 }
 
@@ -67,9 +66,9 @@ bool Model::upload() {
 
   // Map all the loaded material::loader's to render::frontend::material's while
   // using indices to refer to them rather than strings.
-  Map<String, Size> material_indices{m_frontend->allocator()};
+  Map<Atom, Size> material_indices{m_frontend->allocator()};
   const bool material_load_result =
-    m_model.materials().each_pair([this, &material_indices](const String& _name, Material::Loader& material_) {
+    m_model.materials().each_pair([this, &material_indices](Atom _name, Material::Loader& material_) {
       Frontend::Material material{m_frontend};
       if (material.load(Utility::move(material_))) {
         const Size material_index{m_materials.size()};
@@ -86,7 +85,7 @@ bool Model::upload() {
 
   // Resolve all the meshes of the loaded model.
   m_model.meshes().each_fwd([this, &material_indices](const Rx::Model::Mesh& _mesh) {
-    if (auto* find = material_indices.find(_mesh.material)) {
+    if (auto* find = material_indices.find(Atom{_mesh.material})) {
       if (m_materials[*find].has_alpha()) {
         m_transparent_meshes.push_back({_mesh.offset, _mesh.count, *find, _mesh.bounds});
       } else {
@@ -8,6 +8,7 @@
 #include "rx/math/vec3.h"
 
 #include "rx/core/filesystem/file.h"
+#include "rx/core/memory/tracing_allocator.h"
 #include "rx/core/json.h"
 #include "rx/core/profiler.h"
 
@@ -114,6 +115,7 @@ void Skybox::render(Frontend::Target* _target, const Math::Mat4x4f& _view,
 }
 
 bool Skybox::load(const String& _file_name) {
+  RX_MEMORY_TRACE_SCOPE();
   auto data{Filesystem::read_text_file(_file_name)};
   if (!data) {
     return false;
@@ -156,7 +158,7 @@ bool Skybox::load(const String& _file_name) {
   Math::Vec2z dimensions;
   Frontend::TextureCM::Face face{Frontend::TextureCM::Face::k_right};
   bool result{faces.each([&](const JSON& file_name) {
-    Texture::Loader texture{m_frontend->allocator()};
+    Texture::Loader texture;
     if (!texture.load(file_name.as_string(), Texture::PixelFormat::k_rgb_u8)) {
       return false;
     }
@@ -6,6 +6,8 @@
 #include "rx/core/filesystem/file.h"
 #include "rx/core/log.h"
 #include "rx/core/stream.h"
+#include "rx/core/memory/tagged_allocator.h"
+#include "rx/core/memory/tracing_allocator.h"
 
 #include "lib/stb_image.h"
 
@@ -15,9 +17,19 @@ RX_LOG("texture/loader", logger);
 
 namespace Rx::Texture {
 
+// Used for texture data of loaders that aren't given an allocator.
+static Global<Memory::TaggedAllocator> s_allocator{"allocators", "texture",
+  Memory::SystemAllocator::instance(), "texture"};
+
+Loader::Loader()
+  : Loader{*s_allocator}
+{
+}
+
 bool Loader::load(Stream* _stream, PixelFormat _want_format,
   const Math::Vec2z& _max_dimensions)
 {
+  RX_MEMORY_TRACE_SCOPE();
   auto data = read_binary_stream(allocator(), _stream);
   if (!data) {
     return false;
@@ -25,7 +25,7 @@ struct Loader {
   RX_MARK_NO_COPY(Loader);
   RX_MARK_NO_MOVE(Loader);
 
-  constexpr Loader();
+  Loader();
   constexpr Loader(Memory::Allocator& _allocator);
   ~Loader() = default;
 
@@ -52,11 +52,6 @@ private:
   Math::Vec2z m_dimensions;
 };
 
-inline constexpr Loader::Loader()
-  : Loader{Memory::SystemAllocator::instance()}
-{
-}
-
 inline constexpr Loader::Loader(Memory::Allocator& _allocator)
   : m_allocator{_allocator}
   , m_data{allocator()}
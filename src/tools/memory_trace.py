@@ -0,0 +1,150 @@
+# Summarize a memory trace produced by Rx::Memory::TracingAllocator.
+#
+# Usage:
+#   python3 memory_trace.py trace.bin [--binary rex] [--top 25] [--by tag]
+#
+# Reports live bytes, live allocations, total allocations and the allocation
+# rate for every call site, or for every allocator tag with --by tag. Call
+# sites are per tag. Those without a source location are identified by their
+# backtrace, pass the traced binary with --binary to resolve those with
+# addr2line.
+
+import argparse, struct, subprocess, sys
+
+MAGIC = b'RXMT'
+VERSION = 1
+
+K_STRING, K_EVENT, K_DROPPED = 0, 1, 2
+K_ALLOCATE, K_REALLOCATE, K_DEALLOCATE = 0, 1, 2
+
+EVENT = struct.Struct('<BBHIIIIQQQQ')
+
+class Site:
+    def __init__(self, name):
+        self.name = name
+        self.live_bytes = 0
+        self.live_allocations = 0
+        self.allocations = 0
+
+def read_trace(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    magic, version, frequency = struct.unpack_from('<4sIQ', data, 0)
+    if magic != MAGIC or version != VERSION:
+        sys.exit('%s: not a version %d memory trace' % (path, VERSION))
+
+    strings = {0: None}
+    events = []
+    dropped = 0
+    offset = 16
+    while offset < len(data):
+        kind = data[offset]
+        offset += 1
+        if kind == K_STRING:
+            id, length = struct.unpack_from('<IH', data, offset)
+            offset += 6
+            strings[id] = data[offset:offset + length].decode('utf-8', 'replace')
+            offset += length
+        elif kind == K_EVENT:
+            (op, frames, thread, tag, file, function, line, ticks, address,
+             previous, size) = EVENT.unpack_from(data, offset)
+            offset += EVENT.size
+            backtrace = struct.unpack_from('<%dQ' % frames, data, offset)
+            offset += 8 * frames
+            events.append((ticks, op, tag, file, function, line, address,
+                           previous, size, backtrace))
+        elif kind == K_DROPPED:
+            dropped += struct.unpack_from('<Q', data, offset)[0]
+            offset += 8
+        else:
+            sys.exit('%s: corrupt chunk at offset %d' % (path, offset - 1))
+
+    # Rings are drained one thread at a time, replay in the order events happened.
+    events.sort(key=lambda event: event[0])
+    return frequency, strings, events, dropped
+
+def resolve(binary, addresses):
+    if not binary or not addresses:
+        return {}
+    addresses = sorted(addresses)
+    output = subprocess.run(['addr2line', '-f', '-C', '-e', binary] +
+                            ['%#x' % address for address in addresses],
+                            capture_output=True, text=True).stdout.splitlines()
+    return {address: '%s (%s)' % (output[2 * i + 1], output[2 * i])
+            for i, address in enumerate(addresses) if 2 * i + 1 < len(output)}
+
+def main():
+    parser = argparse.ArgumentParser(description='Summarize a memory trace.')
+    parser.add_argument('trace')
+    parser.add_argument('--binary', help='traced binary used to resolve backtraces')
+    parser.add_argument('--top', type=int, default=25, help='number of sites to print')
+    parser.add_argument('--by', choices=['site', 'tag'], default='site')
+    options = parser.parse_args()
+
+    frequency, strings, events, dropped = read_trace(options.trace)
+
+    def key_of(event):
+        _, _, tag, file, function, line, _, _, _, backtrace = event
+        if options.by == 'tag':
+            return ('tag', strings[tag])
+        if file:
+            return ('location', strings[tag], strings[file], line, strings[function])
+        return ('backtrace', strings[tag]) + backtrace
+
+    sites = {}
+    live = {}
+
+    def release(address):
+        if address in live:
+            size, site = live.pop(address)
+            site.live_bytes -= size
+            site.live_allocations -= 1
+
+    for event in events:
+        op, address, previous, size = event[1], event[6], event[7], event[8]
+        if op == K_DEALLOCATE:
+            release(address)
+            continue
+        if op == K_REALLOCATE:
+            release(previous)
+        release(address)
+        key = key_of(event)
+        site = sites.get(key)
+        if site is None:
+            site = sites[key] = Site(key)
+        site.live_bytes += size
+        site.live_allocations += 1
+        site.allocations += 1
+        live[address] = (size, site)
+
+    duration = (events[-1][0] - events[0][0]) / frequency if len(events) > 1 else 0.0
+
+    frames = set()
+    for key in sites:
+        if key[0] == 'backtrace':
+            frames.update(key[2:])
+    symbols = resolve(options.binary, frames)
+
+    def name(key):
+        if key[0] == 'tag':
+            return key[1] or '?'
+        if key[0] == 'location':
+            return '%s: %s:%d (%s)' % (key[1] or '?', key[2], key[3], key[4])
+        if len(key) == 2:
+            return key[1] or '?'
+        return '%s: %s' % (key[1] or '?', ' <- '.join(
+            symbols.get(frame, '%#x' % frame) for frame in key[2:]))
+
+    ranked = sorted(sites.values(), key=lambda site: site.live_bytes, reverse=True)
+
+    print('%d events over %.2fs, %d dropped, %d bytes live' % (
+        len(events), duration, dropped, sum(site.live_bytes for site in ranked)))
+    print('%14s %10s %10s %10s  %s' % ('live bytes', 'live', 'total', 'rate/s', options.by))
+    for site in ranked[:options.top]:
+        rate = site.allocations / duration if duration > 0 else 0.0
+        print('%14d %10d %10d %10.1f  %s' % (site.live_bytes, site.live_allocations,
+                                            site.allocations, rate, name(site.name)))
+
+if __name__ == '__main__':
+    main()